@@ -0,0 +1,204 @@
+/**
+ * @file BrickedVolume.h
+ * @brief Declaration of the BrickedVolume class, an out-of-core volume stored as cubic bricks.
+ *
+ * A BrickedVolume splits the volume into cubic bricks (64 x 64 x 64 voxels by default). Only a bounded
+ * number of bricks is held in memory, in a least-recently-used cache; the others live in a spill file.
+ * A volume can therefore be several times larger than the available memory. Voxels are accessed through
+ * rectangular regions, which are copied brick by brick between the cache and a dense caller buffer.
+ *
+ * `transformWithHalo` streams a volume through any in-memory `Volume` filter: each brick is read together
+ * with a halo of neighbouring voxels, filtered as a small dense volume, and its interior is written to a
+ * new bricked volume. Because the halo covers the filter's reach, the result is identical to filtering
+ * the whole volume in memory. `Filter` and `Projection` provide bricked overloads built on this.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_BRICKEDVOLUME_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_BRICKEDVOLUME_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include "Image.h"
+#include "Volume.h"
+
+/**
+ * @class BrickedVolume
+ * @brief A 3D volume stored as bricks with an LRU cache in memory and a spill file on disk.
+ *
+ * Bricks that have never been written read as zero. Region reads and writes are thread-safe; they
+ * serialise on the brick cache, so callers parallelise the work they do on a region rather than the
+ * region copies themselves.
+ *
+ */
+class BrickedVolume {
+public:
+    /// Default edge length of a brick in voxels.
+    static constexpr int defaultBrickSide = 64;
+
+    /// Default memory budget of the brick cache in bytes.
+    static constexpr size_t defaultCacheBytes = size_t(256) << 20;
+
+    /**
+     * @brief Cache counters, mainly for tests and tuning.
+     */
+    struct CacheStatistics {
+        size_t hits = 0;           ///< Brick accesses served from memory
+        size_t misses = 0;         ///< Brick accesses that had to load or create a brick
+        size_t evictions = 0;      ///< Bricks dropped from memory to make room
+        size_t spills = 0;         ///< Evicted or flushed bricks written to the spill file
+        size_t residentBricks = 0; ///< Bricks currently in memory
+    };
+
+    /**
+     * @brief Creates a zero-filled bricked volume.
+     * @param width Width of the volume in voxels.
+     * @param height Height of the volume in voxels.
+     * @param depth Number of slices.
+     * @param channels Number of channels per voxel.
+     * @param cacheBytes Memory budget of the brick cache. At least one brick is always cached.
+     * @param brickSide Edge length of a brick in voxels.
+     * @param spillDirectory Directory for the spill file; the system temporary directory when empty.
+     *                       The file is deleted when the volume is destroyed.
+     * @throw std::invalid_argument if a dimension or the brick side is not positive.
+     * @throw std::runtime_error if the spill file cannot be created.
+     */
+    BrickedVolume(int width, int height, int depth, int channels, size_t cacheBytes = defaultCacheBytes,
+                  int brickSide = defaultBrickSide, const std::string& spillDirectory = "");
+
+    /**
+     * @brief Moves the bricks, cache and spill file of another bricked volume.
+     * @param other The volume to move from. It must not be used afterwards except to assign to it.
+     */
+    BrickedVolume(BrickedVolume&& other) noexcept;
+
+    /**
+     * @brief Replaces this volume with another one, deleting this volume's spill file.
+     * @param other The volume to move from.
+     * @return A reference to this volume.
+     */
+    BrickedVolume& operator=(BrickedVolume&& other) noexcept;
+
+    /**
+     * @brief Destructor, releases the cache and deletes the spill file.
+     */
+    ~BrickedVolume();
+
+    BrickedVolume(const BrickedVolume&) = delete;
+    BrickedVolume& operator=(const BrickedVolume&) = delete;
+
+    /**
+     * @brief Copies a dense volume into bricks.
+     *
+     * The source is read brick by brick, so a memory-mapped volume from `Volume::openRaw` is streamed
+     * from disk rather than loaded whole.
+     *
+     * @param volume The source volume.
+     * @param cacheBytes Memory budget of the brick cache.
+     * @param brickSide Edge length of a brick in voxels.
+     * @param spillDirectory Directory for the spill file; the system temporary directory when empty.
+     * @return The bricked copy.
+     */
+    static BrickedVolume fromVolume(const Volume& volume, size_t cacheBytes = defaultCacheBytes,
+                                    int brickSide = defaultBrickSide, const std::string& spillDirectory = "");
+
+    /**
+     * @brief Copies the whole volume into a dense in-memory volume.
+     * @return The dense copy.
+     */
+    [[nodiscard]] Volume toVolume() const;
+
+    /**
+     * @brief Copies one z slice into an image.
+     * @param z Index of the slice (0-based).
+     * @return A width x height image with the volume's channels.
+     * @throw std::out_of_range if z is outside the volume.
+     */
+    [[nodiscard]] Image getSlice(int z) const;
+
+    /**
+     * @brief Copies a box of voxels into a dense buffer.
+     * @param x0 First x of the box.
+     * @param y0 First y of the box.
+     * @param z0 First z of the box.
+     * @param regionWidth Width of the box.
+     * @param regionHeight Height of the box.
+     * @param regionDepth Depth of the box.
+     * @param destination Buffer of regionWidth * regionHeight * regionDepth * channels bytes, filled x-fastest.
+     * @throw std::out_of_range if the box is empty or not inside the volume.
+     */
+    void readRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                    unsigned char* destination) const;
+
+    /**
+     * @brief Copies a dense buffer into a box of voxels.
+     * @param x0 First x of the box.
+     * @param y0 First y of the box.
+     * @param z0 First z of the box.
+     * @param regionWidth Width of the box.
+     * @param regionHeight Height of the box.
+     * @param regionDepth Depth of the box.
+     * @param source Buffer of regionWidth * regionHeight * regionDepth * channels bytes, laid out x-fastest.
+     * @throw std::out_of_range if the box is empty or not inside the volume.
+     */
+    void writeRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                     const unsigned char* source);
+
+    /**
+     * @brief Replaces the volume by the result of a dense filter applied brick by brick.
+     *
+     * Every brick is read with `halo` extra voxels on each side (clipped at the volume border), passed to
+     * `filter` as a dense Volume, and the brick's interior is written to a new bricked volume that then
+     * replaces this one. The new volume has its own cache of the same size, so up to twice the cache budget
+     * plus one haloed brick is in memory. The result equals applying `filter` to the whole volume whenever
+     * each output voxel depends only on inputs at most `halo` voxels away and borders are clamped.
+     *
+     * @param halo Reach of the filter in voxels.
+     * @param filter Callable that filters a dense volume in place.
+     */
+    void transformWithHalo(int halo, const std::function<void(Volume&)>& filter);
+
+    /**
+     * @brief Writes every modified cached brick to the spill file.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the cache counters.
+     * @return A snapshot of the counters.
+     */
+    [[nodiscard]] CacheStatistics getCacheStatistics() const;
+
+    [[nodiscard]] int getWidth() const;    ///< Width of the volume in voxels.
+    [[nodiscard]] int getHeight() const;   ///< Height of the volume in voxels.
+    [[nodiscard]] int getDepth() const;    ///< Number of slices.
+    [[nodiscard]] int getChannels() const; ///< Number of channels per voxel.
+    [[nodiscard]] int getBrickSide() const; ///< Edge length of a brick in voxels.
+
+private:
+    struct Store; ///< Brick cache and spill file, defined in BrickedVolume.cpp
+
+    // Copies between a region and the bricks; toBricks selects the direction
+    void copyRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                    unsigned char* buffer, bool toBricks) const;
+
+    int width, height, depth, channels; ///< Volume dimensions and number of channels.
+    int brickSide; ///< Edge length of a brick in voxels.
+    size_t cacheBytes; ///< Memory budget of the brick cache.
+    std::string spillDirectory; ///< Directory of the spill file ("" for the temporary directory).
+    std::unique_ptr<Store> store; ///< Brick cache and spill file.
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_BRICKEDVOLUME_H
@@ -0,0 +1,78 @@
+/**
+ * @file Clahe.h
+ * @brief Declaration of the Clahe class, contrast-limited adaptive histogram equalisation of images and volumes.
+ *
+ * The image is divided into a grid of tiles (bricks for a volume). Each tile's histogram is clipped and turned
+ * into its own equalisation table, and all tiles are processed in parallel. Every pixel is then remapped by
+ * interpolating the tables of the four tiles (eight bricks) whose centres surround it, so there are no seams at
+ * tile borders. The interpolation runs in fixed point. For each row, the tables of the two tile rows it lies
+ * between are blended once; each pixel then needs only two table reads, a multiply-add and a shift.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_CLAHE_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_CLAHE_H
+
+#include "Image.h"
+#include "Volume.h"
+
+/**
+ * @class Clahe
+ * @brief Static contrast-limited adaptive histogram equalisation.
+ *
+ * Tile counts larger than the image along an axis are reduced to its size. Tables are built by
+ * `Histogram::clippedEqualisationTable`.
+ *
+ */
+class Clahe {
+public:
+    static constexpr double defaultClipLimit = 2.0; ///< Clip limit used when none is given
+    static constexpr int defaultTiles = 8;          ///< Tiles along each axis used when none are given
+
+    /**
+     * @brief Applies CLAHE to an image.
+     *
+     * Single-channel images are equalised directly. RGB(A) images are equalised on V (HSV) or L (HSL): the
+     * histograms are read straight from the pixels, and each row is converted, remapped and converted back
+     * through a one-row buffer, as in `Filter::histogramEqualization`.
+     *
+     * @param image The input image with 1, 3 or 4 channels.
+     * @param output Destination image, 1 channel for grey input and 3 otherwise. Its buffer is reused when it
+     *               already has the right size, and it may be the same object as `image`.
+     * @param clipLimit Largest histogram bin allowed in a tile, as a multiple of the tile's mean bin count.
+     * @param tilesX Number of tiles across the image.
+     * @param tilesY Number of tiles down the image.
+     * @param isHSV For colour images, equalise V of HSV (true) or L of HSL (false).
+     * @throw std::invalid_argument if the channel count is not 1, 3 or 4, a tile count is below 1 or the clip
+     *        limit is not positive.
+     */
+    static void apply(const Image& image, Image& output, double clipLimit = defaultClipLimit,
+                      int tilesX = defaultTiles, int tilesY = defaultTiles, bool isHSV = false);
+
+    /**
+     * @brief Applies CLAHE to a volume in place, with a 3D grid of bricks and trilinear interpolation.
+     *
+     * Each channel is equalised independently.
+     *
+     * @param volume The volume to equalise.
+     * @param clipLimit Largest histogram bin allowed in a brick, as a multiple of the brick's mean bin count.
+     * @param tilesX Number of bricks along x.
+     * @param tilesY Number of bricks along y.
+     * @param tilesZ Number of bricks along z.
+     * @throw std::invalid_argument if a brick count is below 1 or the clip limit is not positive.
+     */
+    static void apply(Volume& volume, double clipLimit = defaultClipLimit, int tilesX = defaultTiles,
+                      int tilesY = defaultTiles, int tilesZ = defaultTiles);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_CLAHE_H
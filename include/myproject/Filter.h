@@ -23,7 +23,9 @@
 
 #include "Image.h"
 #include "Volume.h"
+#include "BrickedVolume.h"
 
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 
@@ -35,6 +37,19 @@
  * facilitating operations such as blurring, edge detection, and color space conversions.
  * The class functions are static, allowing for easy access without the need to instantiate objects.
  *
+ * The 2D operations split the image into row bands and run them on the shared `Parallel` executor.
+ * Every band writes only its own output rows, so the result is the same for any thread count.
+ * `salt_and_pepper` stays serial. The unseeded overload draws from the global `rand()` sequence, so only the
+ * seeded overload, which owns its engine, may run on several threads at once.
+ *
+ * Each 2D filter also has an overload that writes into a caller-supplied `output` image instead of
+ * returning a new one. The output buffer is reused when its size already matches, so a chain of
+ * filters can ping-pong between two images (`filter(a, b); a.swap(b);`) without allocating or
+ * copying whole frames. Passing the same image as input and output applies the filter in place;
+ * point operations such as `setBrightness` then work on the buffer directly, while neighbourhood
+ * filters compute into a fresh buffer that replaces the input's. Chains of point operations can
+ * instead be fused into lookup tables and applied in one pass with `LutChain`.
+ *
  */
 class Filter {
 public:
@@ -45,7 +60,16 @@ public:
      * @param kernel_size Size of the kernel. Must be an odd number.
      * @return A new Image object with the median blur applied.
      */
-    static Image medianBlur(Image& image, int kernel_size);
+    static Image medianBlur(const Image& image, int kernel_size);
+
+    /**
+     * @brief Writes the median blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernel_size Size of the kernel.
+     */
+    static void medianBlur(const Image& image, Image& output, int kernel_size);
 
     /**
      * @brief Applies a histogram-based median blur filter to an image using a specified kernel size.
@@ -56,24 +80,157 @@ public:
      * @param kernel_size Size of the kernel. Must be an odd number.
      * @return A new Image object with the histogram-based median blur applied.
      */
-    static Image histomedianBlur(Image& image, int kernel_size);
+    static Image histomedianBlur(const Image& image, int kernel_size);
+
+    /**
+     * @brief Writes the histogram-based median blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernel_size Size of the kernel.
+     */
+    static void histomedianBlur(const Image& image, Image& output, int kernel_size);
+
+    /**
+     * @brief Applies a median filter whose cost per pixel does not depend on the kernel size.
+     *
+     * Implements the Perreault–Hébert algorithm: every image column keeps a histogram of the
+     * 2r + 1 rows around the current row, and the kernel histogram is updated by adding one column
+     * histogram and removing another per pixel. Histograms are split into 16 coarse and 256 fine
+     * bins, and fine bins are only updated for the coarse bin that contains the median.
+     * Edges are clamped and the window spans (2r + 1) pixels per side, so the result is identical
+     * to `medianBlur`. This is the preferred median filter for large kernels.
+     *
+     * @param image Reference to the input image.
+     * @param kernel_size Size of the kernel.
+     * @return A new Image object with the median blur applied.
+     * @throw std::invalid_argument if kernel_size is not positive or is greater than 255.
+     */
+    static Image constantTimeMedianBlur(const Image& image, int kernel_size);
+
+    /**
+     * @brief Writes the constant-time median blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernel_size Size of the kernel.
+     * @throw std::invalid_argument if kernel_size is not positive or is greater than 255.
+     */
+    static void constantTimeMedianBlur(const Image& image, Image& output, int kernel_size);
 
     /**
      * @brief Applies a box blur filter to an image using a specified kernel size.
      * @param image Reference to the input image.
      * @param kernel_size Size of the kernel. Must be an odd number.
      * @return A new Image object with the box blur applied.
+     *
+     * Kernels of `boxBlurRunningSumThreshold` and above are routed to `boxBlurRunningSum`.
+     */
+    static Image boxBlur(const Image& image, int kernel_size);
+
+    /**
+     * @brief Writes the box blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernel_size Size of the kernel.
+     */
+    static void boxBlur(const Image& image, Image& output, int kernel_size);
+
+    /**
+     * @brief Applies a box blur using running sums, so the cost per pixel does not depend on the kernel size.
+     *
+     * Each pass keeps the sum of the current window and updates it by adding the pixel entering the
+     * window and subtracting the one leaving it. Edges are clamped exactly as in `boxBlur`, and the
+     * intermediate image is rounded the same way, so both functions give identical output.
+     *
+     * @param image Reference to the input image.
+     * @param kernel_size Size of the kernel.
+     * @return A new Image object with the box blur applied.
      */
-    static Image boxBlur(Image& image, int kernel_size);
+    static Image boxBlurRunningSum(const Image& image, int kernel_size);
+
+    /**
+     * @brief Writes the running-sum box blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernel_size Size of the kernel.
+     */
+    static void boxBlurRunningSum(const Image& image, Image& output, int kernel_size);
+
+    /// Smallest kernel size for which `boxBlur` switches to the running-sum implementation.
+    static constexpr int boxBlurRunningSumThreshold = 7;
 
     /**
     * @brief Applies a Gaussian blur filter to an image using a specified kernel size and sigma value.
     * @param image Reference to the input image.
     * @param kernelSize Size of the kernel.
     * @param sigma Standard deviation of the Gaussian kernel.
+    * @param allowApproximation Whether large blurs may use the recursive approximation.
     * @return A new Image object with the Gaussian blur applied.
+    * @throw std::invalid_argument if kernelSize is even.
+    *
+    * The 2D Gaussian is separable, so the image is convolved with a cached 1D kernel along rows and
+    * then along columns, costing O(kernelSize) per pixel. Only when `allowApproximation` is set, sigma
+    * is at least `recursiveGaussianSigmaThreshold` and the kernel spans about ±3 sigma is
+    * `gaussianBlurRecursive` used instead, whose cost does not depend on the kernel size. Its result
+    * is then no longer exact: on 0/255 steps and checkerboards it has been measured within 9 grey
+    * levels of the exact kernel for sigma 8 to 48, and smooth images are closer still.
     */
-    static Image gaussianBlur(Image& image, int kernelSize, float sigma);
+    static Image gaussianBlur(const Image& image, int kernelSize, float sigma, bool allowApproximation = false);
+
+    /**
+     * @brief Writes the Gaussian blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param kernelSize Size of the kernel.
+     * @param sigma Standard deviation of the Gaussian kernel.
+     * @param allowApproximation Whether large blurs may use the recursive approximation, as for the overload above.
+     * @throw std::invalid_argument if kernelSize is even.
+     */
+    static void gaussianBlur(const Image& image, Image& output, int kernelSize, float sigma,
+                             bool allowApproximation = false);
+
+    /**
+     * @brief Applies an approximate Gaussian blur using the Young–van Vliet recursive filter.
+     *
+     * Each row and then each column is run through a third-order causal and anti-causal IIR filter
+     * whose coefficients are derived from sigma. The cost per pixel is constant, which makes this
+     * the right choice for very large sigma. Borders are treated as if the edge pixel repeats.
+     *
+     * @param image Reference to the input image.
+     * @param sigma Standard deviation of the Gaussian. Must be at least 0.5.
+     * @return A new Image object with the Gaussian blur applied.
+     * @throw std::invalid_argument if sigma is below 0.5.
+     */
+    static Image gaussianBlurRecursive(const Image& image, float sigma);
+
+    /**
+     * @brief Writes the recursive Gaussian blur of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param sigma Standard deviation of the Gaussian. Must be at least 0.5.
+     * @throw std::invalid_argument if sigma is below 0.5.
+     */
+    static void gaussianBlurRecursive(const Image& image, Image& output, float sigma);
+
+    /**
+     * @brief Returns the normalised 1D Gaussian kernel for a given size and sigma.
+     *
+     * Kernels are computed once and cached, so repeated calls with the same arguments do not
+     * evaluate `std::exp` again. The returned reference stays valid for the lifetime of the program.
+     *
+     * @param kernelSize Number of taps.
+     * @param sigma Standard deviation of the Gaussian.
+     * @return Reference to the cached kernel, which sums to 1.
+     */
+    static const std::vector<float>& gaussianKernel1D(int kernelSize, float sigma);
+
+    /// Smallest sigma for which `gaussianBlur` may use the recursive implementation when approximation is allowed.
+    static constexpr float recursiveGaussianSigmaThreshold = 8.0f;
 
     /**
      * @brief Converts image from 3 channels (RGB) to 1 channel (grayscale).
@@ -81,7 +238,15 @@ public:
      * @param image A reference to the input image to be processed.
      * @return A grayscaled image, or the original image if it is already grayscaled.
     */
-    static Image grayScale(Image &inputImg);
+    static Image grayScale(const Image& inputImg);
+
+    /**
+     * @brief Writes the grayscale version of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     */
+    static void grayScale(const Image& image, Image& output);
 
     /**
      * @brief Adjusts the brightness of the image.of an input image by adding a specified value to each pixel value.
@@ -91,7 +256,33 @@ public:
      * @param autoBrightness A boolean value to determine whether to automatically adjust the brightness of the image.
      * @return The image with adjusted brightness.
     */
-    static Image setBrightness(Image &image, int value, bool autoBrightness=false);
+    static Image setBrightness(const Image& image, int value, bool autoBrightness=false);
+
+    /**
+     * @brief Writes the brightness-adjusted `image` into `output`. Applied in place, no buffer is allocated.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param value The value to be added to each pixel value.
+     * @param autoBrightness Whether to derive the offset that brings the average intensity to 128.
+     */
+    static void setBrightness(const Image& image, Image& output, int value, bool autoBrightness=false);
+
+    /**
+     * @brief Applies a gamma curve to every byte of an image, v -> 255 * (v / 255)^(1 / gamma).
+     * Gamma above 1 brightens the mid-tones and below 1 darkens them; 0 and 255 are unchanged.
+     * @param image The input image.
+     * @param gamma The gamma, greater than 0.
+     * @return The gamma-corrected image.
+     * @throw std::invalid_argument if gamma is not positive.
+    */
+    static Image adjustGamma(const Image& image, double gamma);
+
+    /**
+     * @brief Writes the gamma-corrected `image` into `output`. Applied in place, no buffer is allocated.
+     * @see adjustGamma(const Image&, double)
+    */
+    static void adjustGamma(const Image& image, Image& output, double gamma);
 
     /**
      * @brief Applies a 3x3 Sobel operator to an input image for edge detection.
@@ -104,7 +295,15 @@ public:
      * @param image The input Image object to which the Sobel operator will be applied.
      * @return The image after applying the Sobel operator for edge detection.
     */
-    static Image applySobelOperator(Image& image);
+    static Image applySobelOperator(const Image& image);
+
+    /**
+     * @brief Writes the Sobel edge magnitude of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     */
+    static void applySobelOperator(const Image& image, Image& output);
 
     /**
      * @brief Applies a 3x3 Prewitt operator to an input image for edge detection.
@@ -117,7 +316,15 @@ public:
      * @param image The input Image object to which the Prewitt operator will be applied.
      * @return The image after applying the Prewitt operator for edge detection.
     */
-    static Image applyPrewittOperator(Image& image);
+    static Image applyPrewittOperator(const Image& image);
+
+    /**
+     * @brief Writes the Prewitt edge magnitude of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     */
+    static void applyPrewittOperator(const Image& image, Image& output);
 
     /**
      * @brief Applies a 3x3 Scharr operator to an input image for edge detection.
@@ -129,7 +336,15 @@ public:
      * @param image The input Image object to which the Scharr operator will be applied.
      * @return The image after applying the Scharr operator for edge detection.
     */
-    static Image applyScharrOperator(Image& image);
+    static Image applyScharrOperator(const Image& image);
+
+    /**
+     * @brief Writes the Scharr edge magnitude of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     */
+    static void applyScharrOperator(const Image& image, Image& output);
 
     /**
      * @brief Applies a 2x2 Roberts Cross operator to an input image for edge detection.
@@ -140,26 +355,109 @@ public:
      * @param image The input Image object to which the Roberts Cross operator will be applied.
      * @return The image after applying the Roberts Cross operator for edge detection.
     */
-    static Image applyRobertsCrossOperator(Image& image);
+    static Image applyRobertsCrossOperator(const Image& image);
+
+    /**
+     * @brief Writes the Roberts Cross edge magnitude of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     */
+    static void applyRobertsCrossOperator(const Image& image, Image& output);
+
+    /**
+     * @brief Detects thin, connected edges with the Canny algorithm.
+     *
+     * Smooths channel 0 with a Gaussian, takes its Sobel gradient, keeps only local maxima along the gradient
+     * direction and links them by hysteresis between the two thresholds. See `Gradient::canny`.
+     *
+     * @param image The input image.
+     * @param lowThreshold Gradient magnitude a pixel needs to be a weak edge.
+     * @param highThreshold Gradient magnitude a pixel needs to be a strong edge.
+     * @param kernelSize Size of the Gaussian kernel. Must be odd.
+     * @param sigma Standard deviation of the Gaussian.
+     * @return A single-channel image with edges at 255 and everything else at 0.
+     */
+    static Image applyCannyEdgeDetector(const Image& image, float lowThreshold, float highThreshold,
+                                        int kernelSize = 5, float sigma = 1.4f);
+
+    /**
+     * @brief Writes the Canny edges of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param lowThreshold Gradient magnitude a pixel needs to be a weak edge.
+     * @param highThreshold Gradient magnitude a pixel needs to be a strong edge.
+     * @param kernelSize Size of the Gaussian kernel. Must be odd.
+     * @param sigma Standard deviation of the Gaussian.
+     */
+    static void applyCannyEdgeDetector(const Image& image, Image& output, float lowThreshold, float highThreshold,
+                                       int kernelSize = 5, float sigma = 1.4f);
 
     /**
      * @brief Applies a 3D Gaussian blur filter to a volume using a specified kernel size and standard deviation.
-     * @param volume The input Volume object to be filtered.
+     *
+     * The 3D Gaussian is separable, so the volume is blurred along x, y and z with the cached 1D kernel,
+     * costing O(kernelSize) per voxel instead of O(kernelSize^3). Slices are shared out between threads.
+     * The z pass reads the source bytes directly, one row at a time, into a ring of kernelSize float
+     * rows that the y and x passes consume, so the working set per thread is kernelSize rows whatever
+     * the slice size.
+     *
+     * @param volume The input Volume object to be filtered. It is replaced by the blurred volume.
      * @param kernelSize The size of the kernel for the 3D Gaussian blur filter. Size must be odd number (e.g. 3x3x3, 5x5x5, etc.).
      * @param sigma The standard deviation of the Gaussian kernel.
-     * @return The filtered volume after applying the 3D Gaussian blur filter.
+     * @throw std::invalid_argument if kernelSize is even.
     */
     static void apply3DGaussianBlur(Volume& volume, int kernelSize, float sigma);
 
     /**
      * @brief Applies a 3D median filter to a volume using a specified kernel size.
      * Replaces each voxel value with the median value of the neighboring voxels within the kernel..
+     * Kernels smaller than `medianHistogramKernelThreshold` sort each neighbourhood; larger kernels
+     * use the sliding-histogram engine. Both give identical results and run over z slabs in parallel.
      * @param volume The input Volume object to be filtered.
-     * @param kernelSize The size of the kernel for the 3D median filter. Size must be odd number (e.g. 3x3x3, 5x5x5, etc.).
-     * @return The filtered volume after applying the 3D median filter.
+     * @param kernelSize The size of the kernel for the 3D median filter. Size must be odd number (e.g. 3x3x3, 5x5x5, etc.)
+     *                   and at most 255.
+     * @throw std::invalid_argument if kernelSize is even or larger than 255.
     */
     static void apply3DMedianFilter(Volume& volume, int kernelSize);
 
+    /**
+     * @brief Applies contrast-limited adaptive histogram equalisation to a volume in place.
+     * Each brick of a tilesX x tilesY x tilesZ grid gets its own clipped equalisation table per channel, and
+     * every voxel is remapped by trilinear interpolation between the eight nearest bricks. See `Clahe::apply`.
+     * @param volume The volume to equalise.
+     * @param clipLimit Largest histogram bin allowed in a brick, as a multiple of the brick's mean bin count.
+     * @param tilesX Number of bricks along x.
+     * @param tilesY Number of bricks along y.
+     * @param tilesZ Number of bricks along z.
+     * @throw std::invalid_argument if a brick count is below 1 or clipLimit is not positive.
+    */
+    static void apply3DAdaptiveHistogramEqualization(Volume& volume, double clipLimit = 2.0, int tilesX = 8,
+                                                     int tilesY = 8, int tilesZ = 8);
+
+    /**
+     * @brief Applies the 3D Gaussian blur to a bricked volume, streaming one haloed brick at a time.
+     * Each brick is blurred together with kernelSize / 2 neighbouring voxels on every side, so the
+     * result is identical to `apply3DGaussianBlur` on the whole volume in memory.
+     * @param volume The bricked volume to filter. It is replaced by the blurred volume.
+     * @param kernelSize The size of the kernel. Size must be odd.
+     * @param sigma The standard deviation of the Gaussian distribution.
+     * @throw std::invalid_argument if kernelSize is even.
+    */
+    static void apply3DGaussianBlur(BrickedVolume& volume, int kernelSize, float sigma);
+
+    /**
+     * @brief Applies the 3D median filter to a bricked volume, streaming one haloed brick at a time.
+     * @param volume The bricked volume to filter. It is replaced by the filtered volume.
+     * @param kernelSize The size of the kernel. Size must be odd and at most 255.
+     * @throw std::invalid_argument if kernelSize is even or larger than 255.
+    */
+    static void apply3DMedianFilter(BrickedVolume& volume, int kernelSize);
+
+    /// Smallest kernel size for which `apply3DMedianFilter` uses the sliding-histogram engine.
+    static constexpr int medianHistogramKernelThreshold = 5;
+
     /**
      * @brief Adjusts the contrast of an input image by scaling the pixel values
      * so that they span the full range of intensity values (0-255).
@@ -167,17 +465,53 @@ public:
      * @param isHSV A boolean value to determine whether to convert the image to HSV (true) or HSL (false) colour space.
      * @return The image with adjusted contrast.
     */
-    static Image histogramEqualization(Image &image, const bool &isHSV);
+    static Image histogramEqualization(const Image& image, const bool &isHSV);
+
+    /**
+     * @brief Writes the histogram-equalised `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param isHSV Whether to equalise the V channel of HSV (true) or the L channel of HSL (false).
+     *
+     * RGB(A) images are converted to HSV or HSL and back one row at a time, so the result equals
+     * `hsv_to_rgb(calculateHistogramEqualization(rgb_to_hsv(image), 2))` (or the HSL equivalent) without
+     * building the converted image.
+     */
+    static void histogramEqualization(const Image& image, Image& output, const bool &isHSV);
 
     /**
-     * @brief Called by the histogramEqualization function to calculate the histogram of an image and apply histogram equalization to the image.
+     * @brief Equalises the histogram of one channel, leaving the other channels unchanged.
      * @param image The input Image object to be processed.
      * @param channel The channel index of the image to be processed. 
      *                (e.g. for single channel will be set to 0 and 
-     *                for RGB will be set to 2 (L / V channel in HSV and HSL colour space))
+     *                for an HSV or HSL image will be set to 2 (the V / L channel))
      * @return The image with histogram equalization applied.
     */
-    static Image calculateHistogramEqualization(Image &image, int channel);
+    static Image calculateHistogramEqualization(const Image& image, int channel);
+
+    /**
+     * @brief Applies contrast-limited adaptive histogram equalisation (CLAHE) to an image.
+     * Each tile of a tilesX x tilesY grid gets its own clipped equalisation table, and every pixel is remapped
+     * by bilinear interpolation between the tables of the four nearest tiles. See `Clahe::apply`.
+     * @param image The input image with 1, 3 or 4 channels.
+     * @param clipLimit Largest histogram bin allowed in a tile, as a multiple of the tile's mean bin count.
+     * @param tilesX Number of tiles across the image.
+     * @param tilesY Number of tiles down the image.
+     * @param isHSV For colour images, equalise V of HSV (true) or L of HSL (false).
+     * @return The equalised image, 1 channel for grey input and 3 otherwise.
+     * @throw std::invalid_argument if the channel count is not 1, 3 or 4, a tile count is below 1 or clipLimit is
+     *        not positive.
+    */
+    static Image adaptiveHistogramEqualization(const Image& image, double clipLimit = 2.0, int tilesX = 8,
+                                               int tilesY = 8, bool isHSV = false);
+
+    /**
+     * @brief Writes the CLAHE-equalised `image` into `output`, which may be the same object as `image`.
+     * @see adaptiveHistogramEqualization(const Image&, double, int, int, bool)
+    */
+    static void adaptiveHistogramEqualization(const Image& image, Image& output, double clipLimit = 2.0,
+                                              int tilesX = 8, int tilesY = 8, bool isHSV = false);
 
     /**
      * @brief Applies a salt-and-pepper noise filter to an input image by setting a proportion of pixel values either 0 (black) or 255 (white).
@@ -189,11 +523,26 @@ public:
     */
     static Image salt_and_pepper(Image image, const double &proportion, const bool &rgb);
 
+    /**
+     * @brief Applies salt-and-pepper noise drawn from a private engine seeded with `seed`.
+     *
+     * The same seed gives the same noise, and no global random state is touched, so calls on different
+     * threads do not interfere.
+     *
+     * @param image The input Image object to which the salt-and-pepper noise filter will be applied.
+     * @param proportion The proportion of pixel values (0.0 to 1.0) to be set as noise.
+     * @param rgb A boolean value to determine whether to apply the filter to RGB channels or the grayscale image.
+     * @param seed Seed of the random engine.
+     * @return The image with salt-and-pepper noise filter applied.
+     */
+    static Image salt_and_pepper(Image image, const double &proportion, const bool &rgb, unsigned int seed);
+
     /**
      * @brief Applies a threshold filter to an input image by setting pixel values
      * above a specified threshold to 255 (white) and pixel values below the threshold to 0 (black).
      * The thresholding can be applied either to a single channel (for grayscale images) 
      * or to the value/lightness channel of a RGB image converted to HSV or HSL color space.
+     * Images with fewer than 3 channels are always thresholded on channel 0.
      * 
      * @param image The input Image object to which the threshold filter will be applied.
      * @param thresholdValue The threshold value for the filter.
@@ -201,7 +550,18 @@ public:
      * @param isHSV A boolean value to determine whether to convert the image to HSV colour space (true) or HSL colour space (false).
      * @return The image with threshold filter applied.
     */
-    static Image threshold(Image& image, const double &thresholdValue, const bool &rgb, bool isHSV);
+    static Image threshold(const Image& image, const double &thresholdValue, const bool &rgb, bool isHSV);
+
+    /**
+     * @brief Writes the thresholded `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @param thresholdValue The threshold value for the filter.
+     * @param rgb Whether to threshold the V/L channel of an RGB image (true) or channel 0 (false).
+     * @param isHSV Whether to convert to HSV (true) or HSL (false) when rgb is set.
+     */
+    static void threshold(const Image& image, Image& output, const double &thresholdValue, const bool &rgb, bool isHSV);
 
     /**
      * @brief Randomly generate a number between 0 and 1.
@@ -217,7 +577,7 @@ public:
      * @param image The input RGB image to be converted.
      * @return The image converted to HSL color space.
     */
-    static Image RGBtoHSL(Image &image);
+    static Image RGBtoHSL(const Image& image);
 
     /**
      * @brief Converts an HSL (Hue, Saturation, Lightness) image to RGB color space.
@@ -227,7 +587,7 @@ public:
      * @param image The input HSL image to be converted.
      * @return The image converted to RGB color space.
     */
-    static Image HSLtoRGB(Image &image);
+    static Image HSLtoRGB(const Image& image);
 
     /**
      * @brief Converts an RGB image to HSV (Hue, Saturation, Value) color space.
@@ -237,7 +597,7 @@ public:
      * @param image The input RGB image to be converted.
      * @return The image converted to HSV color space.
     */
-    static Image rgb_to_hsv(Image &image);
+    static Image rgb_to_hsv(const Image& image);
 
     /**
      * @brief Converts an HSV (Hue, Saturation, Value) image to RGB color space.
@@ -266,57 +626,26 @@ public:
      * This function applies a median filter to each voxel in a 3D volume. The median filter
      * is a non-linear digital filtering technique, often used to remove noise from images or signals.
      * The filter allows for edge-preserving smoothing, as it replaces each voxel value with the
-     * median value in its local neighborhood defined by the kernelSize. The histogram-based
-     * approach is used for efficient computation.
-     *
-     * You can manually change to use this version by uncommenting the function in the main.cpp file line 719.
+     * median value in its local neighborhood defined by the kernelSize. This always uses the
+     * sliding-histogram engine, whatever the kernel size; `apply3DMedianFilter` chooses automatically.
      *
      * @param volume Reference to the Volume object to be filtered.
      * @param kernelSize Integer representing the size of the cube kernel, which defines the
-     *                   neighborhood over which the median is computed.
+     *                   neighborhood over which the median is computed. Must be odd and at most 255.
+     * @throw std::invalid_argument if kernelSize is even or larger than 255.
      */
     static void apply3DMedianHistFilter(Volume& volume, int kernelSize);
 
-
-private:
     /**
-     * @brief Converts an image to a 2D vector of pixel values.
-     * Each pixel value is represented as a vector of unsigned char values.
-     * It assumes the image is in grayscale and therefore sets pixel values 
-     * to the first channel of the image.
-     * Helper function for applying edge operators.
-     * 
-     * @param image The input grayscale image to be converted.
-     * @return A 2D vector of unsigned char values representing a pixel's grayscale value.
-    */
-    static std::vector<std::vector<unsigned char>> ConvertImageToVector(const Image& image);
-
-    /**
-     * @brief Converts a 2D vector of pixel values to a new Image object.
-     * Each pixel value is represented as a vector of unsigned char values.
-     * It assumes the image is in grayscale and therefore sets pixel values directly 
-     * to the first channel of the image.
-     * Helper function for applying edge operators.
-     * 
-     * @param pixelValues A 2D vector of unsigned char values representing a pixel's grayscale value.
-     * @param width The width of the image.
-     * @param height The height of the image.
-     * @return An Image object created from the 2D vector of pixel values.
-    */
-    static Image convertGradientToImage(const std::vector<std::vector<unsigned char>>& gradient, int width, int height);
-
-    /**
-     * @brief Applies an edge operator to an input image using a specified kernel.
-     * The edge operator computes the gradient of the image intensity function to highlight edges (areas of high intensity change).
-     * 
-     * @param image The input Image object to which the edge operator will be applied.
-     * @param kernelX The kernel for the horizontal gradient component.
-     * @param kernelY The kernel for the vertical gradient component.
-     * @return A new Image object after applying the edge operator.
-    */
-    static Image applyEdgeOperator(Image& image, const int kernelX[3][3], const int kernelY[3][3]);
+     * @brief Applies the sliding-histogram 3D median to a bricked volume, streaming one haloed brick at a time.
+     * @param volume The bricked volume to filter. It is replaced by the filtered volume.
+     * @param kernelSize The size of the kernel. Must be odd and at most 255.
+     * @throw std::invalid_argument if kernelSize is even or larger than 255.
+     */
+    static void apply3DMedianHistFilter(BrickedVolume& volume, int kernelSize);
 
 
+private:
     /**
      * @brief Calculates he value of the Gaussian distribution for a given point based on the standard deviation sigma.
      * The Gaussian distribution is used to create a kernel for a Gaussian blur operation.
@@ -345,31 +674,47 @@ private:
     */
     static int findMedianHist(const std::vector<int>& histogram, int windowSize);
 
+
     /**
-    * @brief Finds the median value from a 3D histogram similar to findMedianHist
-    * @param histogram A vector of integers representing the histogram of intensity values.
-    * @param windowSize Integer representing the total number of elements in the window, used to
-    *                   determine the midpoint of the cumulative distribution.
-    * @return Integer value representing the median intensity found in the histogram.
+     * @brief Slides a kernel histogram along a row of column histograms and writes the median at every x.
+     *
+     * Shared by the 2D constant-time median and the 3D histogram median. Column x's histogram is stored
+     * as 256 fine bins at columnFine[x * 256] and 16 coarse bins at columnCoarse[x * 16]. The kernel
+     * spans 2r + 1 columns with clamped edges.
+     *
+     * @param columnFine Fine column histograms, 256 bins per column.
+     * @param columnCoarse Coarse column histograms, 16 bins per column.
+     * @param width Number of columns.
+     * @param radius Kernel radius along the row.
+     * @param medianRank Zero-based sorted position of the median inside the kernel.
+     * @param out Output for column 0; column x is written to out[x * outStride].
+     * @param outStride Distance between consecutive outputs.
+     */
+    static void medianRowFromColumnHistograms(const uint16_t* columnFine, const uint16_t* columnCoarse, int width,
+                                              int radius, unsigned int medianRank, unsigned char* out, int outStride);
 
-    **/
-    static int findMedianHist3D(const std::vector<int>& histogram, int windowSize);
     /**
-     * @brief Applies a median filter to a 3D volume.
+     * @brief Sort-based 3D median, used for small kernels.
      *
-     * The function operates on a 3D volume by applying a median filter to each voxel. The filter
-     * considers a local neighborhood around each voxel defined by the kernelSize and computes the
-     * median intensity value within that window. This median value replaces the original intensity
-     * value of the voxel. The median filtering process is done in-place; hence, the original volume
-     * data is modified. An odd kernel size ensures a symmetric window around each voxel.
+     * Each z slab reuses a single neighbourhood buffer and selects the median with std::nth_element.
+     *
+     * @param volume Volume to filter in place.
+     * @param kernelSize Odd edge length of the cubic kernel.
+     */
+    static void volumeMedianSort(Volume& volume, int kernelSize);
+
+    /**
+     * @brief Sliding-histogram 3D median, used for larger kernels.
      *
-     * @note The kernel size must be odd to define a central voxel.
+     * For every output row, each x keeps a histogram of the (2r + 1) x (2r + 1) voxels in y and z.
+     * Moving to the next row removes one y row and adds another across the z window, and the kernel
+     * histogram slides along x with coarse/fine bins. Slabs of z run in parallel, and the histograms
+     * are allocated once per slab rather than per voxel.
      *
-     * @param volume Reference to the Volume object representing the 3D data to be filtered.
-     * @param kernelSize Size of the cubic kernel used for the median filtering. It represents
-     *                   the length of the edge of the cube. The kernelSize must be an odd number.
+     * @param volume Volume to filter in place.
+     * @param kernelSize Odd edge length of the cubic kernel, at most 255.
      */
-    void volumeMedianFilter(Volume& volume, int kernelSize);
+    static void volumeMedianHistogram(Volume& volume, int kernelSize);
 };
 
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_FILTER_H
\ No newline at end of file
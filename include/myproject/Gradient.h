@@ -0,0 +1,168 @@
+/**
+ * @file Gradient.h
+ * @brief Declaration of the Gradient class, a single-pass engine for Sobel, Prewitt, Scharr and Roberts gradients.
+ *
+ * The engine reads the packed pixel buffer directly, and the horizontal and vertical derivatives are computed
+ * together from three source rows. Single-channel rows are read in place; otherwise each row band keeps a ring of
+ * three byte rows, filled with channel 0 (what the `Filter` edge operators have always used) or with the luminance
+ * of an RGB image, which `PixelKernels::grayscale` writes straight into the ring. The kernel coefficients are
+ * template arguments, so each operator compiles to its own fully unrolled loop over contiguous rows, which the
+ * compiler can vectorise. Gradient magnitude and orientation come out of the same pass, the orientation from a
+ * branch-free polynomial rather than atan2, and bands run on the shared `Parallel` pool.
+ *
+ * The Canny edge detector reuses the Sobel row kernel on float rows. The image is cut into tiles of whole rows,
+ * and each tile smooths, differentiates, suppresses non-maxima and links its own candidates entirely in
+ * tile-sized float buffers. Connected components are tracked with a union-find forest over the candidates only,
+ * with 32-bit numbers: tiles number and link their candidates independently, the seams between tiles are joined
+ * afterwards, and hysteresis keeps every component that contains a strong pixel. Beyond the output, memory grows
+ * with the number of candidates, five bytes each, rather than with the image.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_GRADIENT_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_GRADIENT_H
+
+#include "Image.h"
+
+/**
+ * @class Gradient
+ * @brief Static computation of image gradients with 3x3 or 2x2 derivative operators.
+ *
+ * Pixels without a full neighbourhood get a magnitude and orientation of 0. For the 3x3 operators these are the
+ * outermost rows and columns; for Roberts Cross they are the last row and column. The magnitude is
+ * sqrt(gx^2 + gy^2), truncated and clamped to 255, exactly as the `Filter` edge operators compute it.
+ *
+ */
+class Gradient {
+public:
+    /**
+     * @brief The derivative operator.
+     */
+    enum class Operator {
+        Sobel,   ///< 3x3, weights 1 2 1 across the derivative
+        Prewitt, ///< 3x3, weights 1 1 1 across the derivative
+        Scharr,  ///< 3x3, weights 3 10 3 across the derivative
+        Roberts  ///< 2x2 diagonal differences
+    };
+
+    /**
+     * @brief The intensity the gradient is taken of.
+     */
+    enum class Source {
+        FirstChannel, ///< Channel 0, as the `Filter` edge operators use
+        Luminance     ///< 0.2126 R + 0.7152 G + 0.0722 B as in `Filter::grayScale`; channel 0 for 1- and 2-channel images
+    };
+
+    /**
+     * @brief Bit flags selecting which images compute produces.
+     */
+    enum Output : unsigned int {
+        Magnitude = 1u << 0,   ///< Gradient magnitude
+        Orientation = 1u << 1, ///< Gradient direction, see encodeOrientation
+        AllOutputs = Magnitude | Orientation
+    };
+
+    /**
+     * @brief Images produced by compute. Only the selected ones are filled in; the others are left empty.
+     */
+    struct Result {
+        Image magnitude;   ///< Single-channel magnitude
+        Image orientation; ///< Single-channel encoded direction
+    };
+
+    /**
+     * @brief Computes the selected gradient images in one pass over the image.
+     * @param image The input image.
+     * @param op The derivative operator.
+     * @param outputs Bitwise OR of Output flags.
+     * @param source Which intensity to differentiate.
+     * @return The selected images, each width x height with one channel.
+     */
+    static Result compute(const Image& image, Operator op, unsigned int outputs,
+                          Source source = Source::FirstChannel);
+
+    /**
+     * @brief Computes the selected gradient images into an existing result, reusing its buffers when their size
+     *        already matches.
+     * @param image The input image. It may be one of the result's images.
+     * @param op The derivative operator.
+     * @param outputs Bitwise OR of Output flags.
+     * @param result Destination images; unselected ones are left unchanged.
+     * @param source Which intensity to differentiate.
+     */
+    static void compute(const Image& image, Operator op, unsigned int outputs, Result& result,
+                        Source source = Source::FirstChannel);
+
+    /**
+     * @brief Computes only the gradient magnitude.
+     * @param image The input image.
+     * @param op The derivative operator.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be the
+     *               same object as `image`.
+     * @param source Which intensity to differentiate.
+     */
+    static void magnitude(const Image& image, Operator op, Image& output, Source source = Source::FirstChannel);
+
+    /**
+     * @brief Encodes a gradient direction as a byte.
+     *
+     * The angle atan2(gy, gx) is mapped onto a full turn of 256 steps, rounded to the nearest: 0 points along +x,
+     * 64 along +y (down the image), 128 along -x and 192 along -y. A zero gradient encodes as 0. The angle is
+     * evaluated with a polynomial accurate to under 1/1000 of a step, so only angles within that distance of a
+     * rounding boundary can round differently from exact atan2. `compute` uses the same evaluation.
+     *
+     * @param gx Horizontal derivative.
+     * @param gy Vertical derivative.
+     * @return The encoded direction.
+     */
+    static unsigned char encodeOrientation(int gx, int gy);
+
+    /**
+     * @brief Detects edges with the Canny algorithm.
+     *
+     * The source intensity is smoothed with a Gaussian (always the direct kernel, with clamped borders), its Sobel
+     * gradient is computed in float, and pixels that are not a local maximum along the gradient direction
+     * (rounded to the nearest of the four neighbour axes) are suppressed. The remaining pixels are strong when
+     * their magnitude is at least `highThreshold` and weak when it is at least `lowThreshold`. Weak pixels are
+     * kept only when they are 8-connected, through other candidates, to a strong pixel. No intermediate result is
+     * rounded to 8 bits. Thresholds are on the scale of `Filter::applySobelOperator` before its clamp to 255.
+     *
+     * @param image The input image.
+     * @param lowThreshold Magnitude a pixel needs to be a weak edge.
+     * @param highThreshold Magnitude a pixel needs to be a strong edge.
+     * @param kernelSize Size of the Gaussian kernel. Must be odd; 1 disables smoothing.
+     * @param sigma Standard deviation of the Gaussian.
+     * @param source Which intensity to detect edges in.
+     * @return A single-channel image with edges at 255 and everything else at 0.
+     * @throw std::invalid_argument if the kernel size is even or the thresholds are not 0 <= low <= high.
+     */
+    static Image canny(const Image& image, float lowThreshold, float highThreshold, int kernelSize = 5,
+                       float sigma = 1.4f, Source source = Source::FirstChannel);
+
+    /**
+     * @brief Writes the Canny edges of `image` into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be the
+     *               same object as `image`.
+     * @param lowThreshold Magnitude a pixel needs to be a weak edge.
+     * @param highThreshold Magnitude a pixel needs to be a strong edge.
+     * @param kernelSize Size of the Gaussian kernel. Must be odd; 1 disables smoothing.
+     * @param sigma Standard deviation of the Gaussian.
+     * @param source Which intensity to detect edges in.
+     * @throw std::invalid_argument if the kernel size is even or the thresholds are not 0 <= low <= high.
+     */
+    static void canny(const Image& image, Image& output, float lowThreshold, float highThreshold, int kernelSize = 5,
+                      float sigma = 1.4f, Source source = Source::FirstChannel);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_GRADIENT_H
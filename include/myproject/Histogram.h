@@ -0,0 +1,113 @@
+/**
+ * @file Histogram.h
+ * @brief Declaration of the Histogram class, parallel 256-bin histograms and the equalisation table built from them.
+ *
+ * Counting is privatised twice. Every row band counts into its own histogram, and the bands are merged once at
+ * the end. Within a band, consecutive values go to four interleaved sub-histograms, so runs of equal values do
+ * not serialise on a single counter. The brightness histograms read V (the largest of R, G and B) or L (the mean
+ * of the largest and smallest) straight from the RGB pixels, with the same values the HSV and HSL conversions
+ * produce, without converting the image.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_HISTOGRAM_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+
+#include "Image.h"
+
+/**
+ * @class Histogram
+ * @brief Static computation of 8-bit histograms and histogram equalisation tables.
+ *
+ */
+class Histogram {
+public:
+    /// Number of occurrences of each byte value
+    using Counts = std::array<size_t, 256>;
+
+    /// Output value for each byte value
+    using Table = std::array<unsigned char, 256>;
+
+    /**
+     * @brief Adds the values of a run of bytes to a histogram, on the calling thread.
+     * @param src Source bytes; value i is src[i * stride].
+     * @param stride Distance in bytes between consecutive values.
+     * @param count Number of values.
+     * @param counts Histogram to add to.
+     */
+    static void accumulate(const unsigned char* src, size_t stride, size_t count, Counts& counts);
+
+    /**
+     * @brief Adds the values of several equally spaced runs of bytes, such as the rows of a tile, to a histogram.
+     *
+     * Counting a whole tile in one call sets up the interleaved sub-histograms once instead of once per row.
+     *
+     * @param src First byte of the first run; value i of run r is src[r * rowStride + i * stride].
+     * @param stride Distance in bytes between consecutive values of a run.
+     * @param count Number of values in each run.
+     * @param rows Number of runs.
+     * @param rowStride Distance in bytes between the starts of consecutive runs.
+     * @param counts Histogram to add to.
+     */
+    static void accumulate(const unsigned char* src, size_t stride, size_t count, size_t rows, size_t rowStride,
+                           Counts& counts);
+
+    /**
+     * @brief Computes the histogram of one channel of an image.
+     * @param image The image.
+     * @param channel The channel to count.
+     * @return The histogram.
+     * @throw std::out_of_range if the channel does not exist.
+     */
+    static Counts compute(const Image& image, int channel);
+
+    /**
+     * @brief Computes the histogram of the HSV value or HSL lightness of an RGB(A) image.
+     * @param image The image, with 3 or 4 channels.
+     * @param isHSV true for V = max(R, G, B), false for L = (max(R, G, B) + min(R, G, B)) / 2 rounded down.
+     * @return The histogram.
+     * @throw std::invalid_argument if the image has fewer than 3 channels.
+     */
+    static Counts computeBrightness(const Image& image, bool isHSV);
+
+    /**
+     * @brief Builds the histogram equalisation table.
+     *
+     * Value v maps to 255 * (cdf(v) - cdfMin) / (total - cdfMin), truncated, where cdfMin is the count of the
+     * lowest occupied value; values below it map to 0. When only one value occurs, it maps to 0.
+     *
+     * @param counts The histogram.
+     * @return The table.
+     */
+    static Table equalisationTable(const Counts& counts);
+
+    /**
+     * @brief Builds the contrast-limited equalisation table used by CLAHE.
+     *
+     * Each bin is clipped to clipLimit times the mean bin count (at least 1), and the clipped excess is spread
+     * evenly over all bins, so no value's slope in the mapping exceeds about clipLimit. Value v then maps to
+     * round(255 * cdf(v) / total) of the clipped histogram.
+     *
+     * @param counts The histogram.
+     * @param clipLimit Largest bin count allowed, as a multiple of the mean bin count. Must be positive; large
+     *                  values give plain equalisation.
+     * @return The table.
+     * @throw std::invalid_argument if the clip limit is not positive.
+     */
+    static Table clippedEqualisationTable(Counts counts, double clipLimit);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_HISTOGRAM_H
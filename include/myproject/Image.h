@@ -26,6 +26,9 @@
 #include <vector>
 #include <stdexcept>
 #include <cstring>
+#include <cstdlib>
+#include <memory>
+#include "Views.h"
 
 /**
  * @class Image
@@ -36,6 +39,11 @@
  * supporting deep copy operations and pixel-wise manipulation. This class is suitable as a foundational component
  * in applications involving image processing, analysis, and visualization.
  *
+ * The pixel buffer is owned through a single `std::unique_ptr` whose deleter releases it with `std::free`. Buffers
+ * loaded by stb_image and buffers allocated by the class come from the same C allocator, so every image is
+ * released the same way. Images are cheap to move: moving transfers the buffer and leaves the source empty,
+ * so returning an image from a filter or assigning a filter result never copies the pixels.
+ *
  */
 class Image
 {
@@ -70,6 +78,12 @@ public:
      */
     Image(const Image &inputImg);
 
+    /**
+     * @brief Move constructor that takes over the pixel buffer of another Image object.
+     * @param inputImg The Image object to move from. It is left empty (0x0 with no channels).
+     */
+    Image(Image &&inputImg) noexcept;
+
     /**
      * @brief Default constructor that initializes an empty Image object.
      */
@@ -82,11 +96,42 @@ public:
      */
     Image &operator=(const Image &inputImg);
 
+    /**
+     * @brief Move assignment operator that takes over the pixel buffer of another Image object.
+     * @param inputImg The Image object to move from. It is left empty (0x0 with no channels).
+     * @return A reference to this Image object.
+     */
+    Image &operator=(Image &&inputImg) noexcept;
+
     /**
      * @brief Destructor that frees allocated memory for the image data.
      */
     ~Image();
 
+    /**
+     * @brief Exchanges the dimensions and pixel buffers of two images without copying any pixels.
+     * @param other The Image object to swap with.
+     */
+    void swap(Image &other) noexcept;
+
+    /**
+     * @brief Changes the dimensions of the image, keeping the existing buffer when the byte size is unchanged.
+     *
+     * This lets a scratch image be reused across the steps of a filter pipeline. Pixel values are unspecified
+     * after the call.
+     *
+     * @param width The new width of the image.
+     * @param height The new height of the image.
+     * @param channels The new number of channels.
+     */
+    void resize(int width, int height, int channels);
+
+    /**
+     * @brief Returns the size of the pixel buffer.
+     * @return The number of bytes, width * height * channels.
+     */
+    size_t getSize() const;
+
     /**
      * @brief Returns the width of the image.
      * @return The width of the image.
@@ -111,8 +156,11 @@ public:
      * @param y The y-coordinate of the pixel.
      * @param channel The channel index of the pixel.
      * @return The pixel value at the specified coordinates and channel.
+     * Inline and unchecked like the views; debug builds assert that the coordinates are in range.
      */
-    unsigned char getPixel(int x, int y, int channel) const;
+    unsigned char getPixel(int x, int y, int channel) const {
+        return constView()(x, y, channel);
+    }
 
     /**
      * @brief Sets the value for a specific pixel and channel.
@@ -121,7 +169,9 @@ public:
      * @param channel The channel index of the pixel.
      * @param value New value for the pixel.
      */
-    void setPixel(int x, int y, int channel, unsigned char value);
+    void setPixel(int x, int y, int channel, unsigned char value) {
+        view()(x, y, channel) = value;
+    }
 
     /**
      * @brief Saves the image to a file.
@@ -143,11 +193,50 @@ public:
      */
     const unsigned char* getData() const;
 
+    /**
+     * @brief Accesses the raw image data for writing.
+     * @return Pointer to the image data, laid out row by row with interleaved channels.
+     */
+    unsigned char* getData();
+
+    /**
+     * @brief Returns a packed view of the pixels for writing.
+     * @return The view. It is invalidated when the image is resized, moved from or assigned to.
+     */
+    PlaneView<unsigned char> view() {
+        return PlaneView<unsigned char>(data.get(), width, height, channels);
+    }
+
+    /**
+     * @brief Returns a packed read-only view of the pixels.
+     * @return The view. It is invalidated when the image is resized, moved from or assigned to.
+     */
+    PlaneView<const unsigned char> view() const {
+        return constView();
+    }
+
+    /**
+     * @brief Returns a packed read-only view of the pixels, also on a mutable image.
+     * @return The view.
+     */
+    PlaneView<const unsigned char> constView() const {
+        return PlaneView<const unsigned char>(data.get(), width, height, channels);
+    }
+
 private:
+    /// Releases pixel buffers with the C allocator used by both stb_image and allocateBuffer
+    struct BufferDeleter {
+        void operator()(unsigned char* buffer) const noexcept { std::free(buffer); }
+    };
+    using Buffer = std::unique_ptr<unsigned char[], BufferDeleter>;
+
+    // Allocates an uninitialised buffer of the given size, throwing std::bad_alloc on failure
+    static Buffer allocateBuffer(size_t size);
+
     int width; ///< Width of the image as pixels in the x-direction
     int height; ///< Height of the image as pixels in the y-direction
     int channels; ///< Number of channels in the image (e.g., 3 for RGB, 4 for RGBA)
-    unsigned char *data; ///< Image data stored as a one-dimensional array of unsigned char values
+    Buffer data; ///< Image data stored as a one-dimensional array of unsigned char values
 };
 
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_IMAGE_H
@@ -0,0 +1,139 @@
+/**
+ * @file LutChain.h
+ * @brief Declaration of the LutChain class, which fuses chains of pointwise filters into lookup tables.
+ *
+ * Brightness offsets, gamma curves, thresholds and custom tables each map a byte to a byte, so any run of them
+ * composes into one 256-entry table. Grayscale conversion and grey thresholding of a colour image also reduce
+ * each pixel to one channel. A chain therefore compiles to at most three stages: a table applied to every
+ * byte, an optional reduction to one channel, and a table applied to the result. `apply` runs all three in
+ * one pass over row bands, using the vectorised table lookup and grayscale kernels and no intermediate images.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_LUTCHAIN_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_LUTCHAIN_H
+
+#include <array>
+#include "Image.h"
+
+/**
+ * @class LutChain
+ * @brief A chain of pointwise operations compiled into lookup tables and applied in a single pass.
+ *
+ * Operations are appended in the order they are applied. Each one matches the corresponding `Filter`
+ * function exactly, so a chain gives the same bytes as running those filters one after another:
+ *
+ *     Image out = LutChain().brightness(20).grayscale().threshold(128).apply(image);
+ *
+ */
+class LutChain {
+public:
+    /// Output value for each byte value
+    using Table = std::array<unsigned char, 256>;
+
+    /**
+     * @brief How a chain reduces each pixel to one channel, if at all.
+     */
+    enum class Reduction {
+        None,        ///< Every channel is kept
+        Grayscale,   ///< RGB(A) pixels are converted to luminance, as `Filter::grayScale` does
+        FirstChannel ///< Channel 0 is kept, as `Filter::threshold` does for a non-RGB threshold
+    };
+
+    /**
+     * @brief Creates an empty chain, which copies its input.
+     */
+    LutChain();
+
+    /**
+     * @brief Appends a brightness offset, saturating to [0, 255], as `Filter::setBrightness`.
+     * @param value Offset in [-255, 255].
+     * @return This chain.
+     * @throw std::invalid_argument if the offset is out of range.
+     */
+    LutChain& brightness(int value);
+
+    /**
+     * @brief Appends a gamma curve, v -> 255 * (v / 255)^(1 / gamma), rounded. Gamma above 1 brightens.
+     * @param gamma The gamma, greater than 0.
+     * @return This chain.
+     * @throw std::invalid_argument if gamma is not positive.
+     */
+    LutChain& gamma(double gamma);
+
+    /**
+     * @brief Appends a threshold to 255 (at least thresholdValue) or 0, as `Filter::threshold` without RGB.
+     * The first channel is thresholded, so a multi-channel image becomes single-channel.
+     * @param thresholdValue The threshold.
+     * @return This chain.
+     */
+    LutChain& threshold(double thresholdValue);
+
+    /**
+     * @brief Appends a conversion to grayscale, as `Filter::grayScale`. No-op once the chain is single-channel.
+     * @return This chain.
+     */
+    LutChain& grayscale();
+
+    /**
+     * @brief Appends an arbitrary byte-to-byte table.
+     * @param table The output value for each input value.
+     * @return This chain.
+     */
+    LutChain& map(const Table& table);
+
+    /**
+     * @brief Returns the table applied to every byte before the reduction.
+     * @return The table.
+     */
+    const Table& getBefore() const;
+
+    /**
+     * @brief Returns the reduction to one channel.
+     * @return The reduction.
+     */
+    Reduction getReduction() const;
+
+    /**
+     * @brief Returns the table applied after the reduction (identity when there is none).
+     * @return The table.
+     */
+    const Table& getAfter() const;
+
+    /**
+     * @brief Applies the chain to an image.
+     * @param image The input image.
+     * @return The result, with one channel if the chain reduces and the channels of `image` otherwise.
+     * @throw std::invalid_argument if the chain converts to grayscale and the image has 2 or more than 4 channels.
+     */
+    Image apply(const Image& image) const;
+
+    /**
+     * @brief Writes the result of the chain into `output`.
+     * @param image The input image.
+     * @param output Destination image. Its buffer is reused when it already has the right size, and it may be
+     *               the same object as `image`.
+     * @throw std::invalid_argument if the chain converts to grayscale and the image has 2 or more than 4 channels.
+     */
+    void apply(const Image& image, Image& output) const;
+
+private:
+    // Composes a table onto the end of the chain: before the reduction while there is none, after it otherwise
+    void append(const Table& table);
+
+    Table before;                           ///< Applied to every byte of the input
+    Reduction reduction = Reduction::None;  ///< Reduction to one channel
+    Table after;                            ///< Applied to the reduced channel
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_LUTCHAIN_H
@@ -0,0 +1,75 @@
+/**
+ * @file Parallel.h
+ * @brief Declaration of the Parallel class, the shared multithreaded executor used by the filters.
+ *
+ * The Parallel class owns a small persistent pool of worker threads and exposes a single
+ * `forRange` primitive that splits an index range (typically image rows or volume slices)
+ * into bands. Bands are claimed dynamically by whichever thread is free, so a slow band never
+ * holds up the others. Each band only writes its own rows of the output and reads its halo
+ * (the neighbouring rows a kernel needs) straight from the read-only source, so results are
+ * identical to the serial loops regardless of the thread count.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLEL_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLEL_H
+
+#include <functional>
+
+/**
+ * @class Parallel
+ * @brief Static interface to the shared band-parallel executor.
+ *
+ * The number of threads defaults to the hardware concurrency and can be overridden either
+ * with the `ZIGGURAT_THREADS` environment variable or at runtime with `setThreadCount`.
+ * Calls made from inside a running band (nested parallelism) are executed serially on the
+ * calling thread, so filters can freely call other filters.
+ *
+ */
+class Parallel {
+public:
+    /**
+     * @brief Sets the number of threads used by subsequent parallel loops.
+     * @param count Number of threads including the calling thread. 0 restores the default.
+     * @throw std::logic_error if called from inside a `forRange` body, which would wait for its own loop.
+     */
+    static void setThreadCount(int count);
+
+    /**
+     * @brief Returns the number of threads used by parallel loops.
+     * @return The thread count (always at least 1).
+     */
+    static int getThreadCount();
+
+    /**
+     * @brief Runs `body` over the half-open range [begin, end) split into bands.
+     *
+     * The body is called with sub-ranges [bandBegin, bandEnd) which together cover the whole
+     * range exactly once. Bands may run concurrently, so the body must only write to data owned
+     * by its own band. The first exception thrown by any band is rethrown on the calling thread.
+     *
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param body Callable invoked as body(bandBegin, bandEnd).
+     * @param grain Number of indices per band. 0 picks a size that gives every thread a few bands.
+     */
+    static void forRange(int begin, int end, const std::function<void(int, int)>& body, int grain = 0);
+
+    /**
+     * @brief Reports whether the calling thread is currently executing a parallel band.
+     * @return true inside a band, false otherwise.
+     */
+    static bool inParallelRegion();
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLEL_H
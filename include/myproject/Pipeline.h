@@ -0,0 +1,166 @@
+/**
+ * @file Pipeline.h
+ * @brief Declaration of the Pipeline class, a parsed chain of 2D filters for batch processing.
+ *
+ * A Pipeline is built once from a textual specification such as
+ * `"grayscale,gaussian:5:1.2,sobel"` and can then be applied to any number of images. Steps run
+ * back to back in memory: each filter writes into one scratch image that is swapped with the
+ * working image, so a chain allocates at most one extra frame and never writes intermediate
+ * results to disk. Consecutive pointwise steps (brightness, gamma, grey threshold and grayscale) are
+ * fused by `LutChain` into lookup tables and applied in a single pass. `runBatch` applies the chain
+ * to many files using the shared `Parallel` pool.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINE_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Image.h"
+#include "LutChain.h"
+
+/**
+ * @class Pipeline
+ * @brief An ordered list of 2D filter steps parsed from a comma-separated specification.
+ *
+ * Each step is written as `name[:argument[:argument]]`. The supported steps are:
+ * - `grayscale`
+ * - `brightness:<-255..255>` or `brightness:auto`
+ * - `gamma:<g>` with g > 0, v -> 255 * (v / 255)^(1 / g)
+ * - `equalize`, `equalize:hsl` or `equalize:hsv` (histogram equalisation, HSL by default)
+ * - `clahe[:<clip>[:<tiles>]]`, contrast-limited adaptive equalisation (clip 2, 8x8 tiles and HSL by default)
+ * - `threshold:<0..255>`, optionally followed by `:hsv` or `:hsl` to threshold the V/L channel of an RGB image
+ * - `saltpepper:<0..1>`
+ * - `median:<k>`, `box:<k>` and `gaussian:<k>:<sigma>` with an odd kernel size k
+ * - `sobel`, `prewitt`, `scharr` and `roberts`
+ * - `canny:<low>:<high>`, Canny edges with a 5x5 Gaussian of sigma 1.4 and the given hysteresis thresholds
+ *
+ */
+class Pipeline {
+public:
+    /**
+     * @brief The filter a step applies.
+     */
+    enum class Operation {
+        Grayscale,
+        Brightness,
+        AutoBrightness,
+        Gamma,
+        Equalize,
+        AdaptiveEqualize,
+        Threshold,
+        SaltAndPepper,
+        MedianBlur,
+        BoxBlur,
+        GaussianBlur,
+        Sobel,
+        Prewitt,
+        Scharr,
+        RobertsCross,
+        Canny
+    };
+
+    /**
+     * @brief One parsed step and its parameters. Parameters a step does not use are left at their defaults.
+     */
+    struct Step {
+        Operation operation;     ///< The filter to apply
+        int kernelSize = 0;      ///< Kernel size of the blurs
+        double value = 0.0;      ///< Brightness offset, gamma, threshold, noise proportion, Gaussian sigma, low Canny threshold or CLAHE clip limit
+        double upperValue = 0.0; ///< High Canny threshold
+        int tiles = 0;           ///< CLAHE tiles along each axis
+        bool rgb = false;        ///< Threshold the V/L channel of an RGB image instead of channel 0
+        bool isHSV = false;      ///< Use HSV rather than HSL for threshold and equalize
+    };
+
+    /**
+     * @brief Result of a batch run.
+     */
+    struct BatchResult {
+        int processed = 0; ///< Number of files written successfully
+        std::vector<std::pair<std::string, std::string>> failures; ///< Input path and error message of each failed file
+    };
+
+    /**
+     * @brief Parses a pipeline specification.
+     * @param specification Comma-separated steps, for example "grayscale,gaussian:5:1.2,sobel".
+     * @return The parsed pipeline.
+     * @throw std::invalid_argument if the specification is empty, names an unknown step or has invalid arguments.
+     */
+    static Pipeline parse(const std::string& specification);
+
+    /**
+     * @brief Returns the parsed steps in the order they are applied.
+     * @return The steps.
+     */
+    const std::vector<Step>& getSteps() const;
+
+    /**
+     * @brief Applies every step to an image, ping-ponging between the image and one scratch buffer.
+     *
+     * Runs of two or more consecutive pointwise steps are compiled into a `LutChain` and applied in one pass;
+     * the result is the same as applying them one by one.
+     *
+     * @param image The image to process; it is replaced by the result.
+     */
+    void apply(Image& image) const;
+
+    /**
+     * @brief Applies every step to an image, seeding the noise of any `saltpepper` step with `seed`.
+     *
+     * The same seed gives the same result, and the noise does not touch the global `rand()` state, so several
+     * threads may apply pipelines at once.
+     *
+     * @param image The image to process; it is replaced by the result.
+     * @param seed Seed of the salt-and-pepper engine.
+     */
+    void apply(Image& image, unsigned int seed) const;
+
+    /**
+     * @brief Loads each input, applies the pipeline and saves the result as PNG in the output directory.
+     *
+     * With at least as many files as `Parallel::getThreadCount()` threads, every thread of the shared pool
+     * takes whole files and runs the filters of each file serially. With fewer files, files are processed one
+     * after another and each filter is band-parallel instead. A file that fails to load, filter or save is
+     * recorded in the result and does not stop the others. Each file draws its salt-and-pepper noise from its
+     * own engine. Inputs that would be written to the same output, such as a.png and a.jpg, are all recorded as
+     * failures before any file is processed, so no result overwrites another.
+     *
+     * @param inputs Paths of the input images.
+     * @param outputDirectory Directory for the results, created if needed. Each output is named after its input
+     *                        with a .png extension.
+     * @return The number of files written and the failures.
+     */
+    BatchResult runBatch(const std::vector<std::string>& inputs, const std::string& outputDirectory) const;
+
+    /**
+     * @brief Lists the images to process for a path given on the command line.
+     * @param path A single image file, or a directory whose .png, .jpg, .jpeg and .bmp files are used.
+     * @return The input paths, sorted by name.
+     * @throw std::invalid_argument if the path does not exist or the directory contains no images.
+     */
+    static std::vector<std::string> collectInputs(const std::string& path);
+
+private:
+    // Applies one step, writing into scratch and swapping unless the step works in place
+    static void applyStep(const Step& step, Image& image, Image& scratch, unsigned int seed);
+
+    // Appends a pointwise step to a chain, or returns false if the step is not pointwise
+    static bool appendPointwise(const Step& step, LutChain& chain);
+
+    std::vector<Step> steps; ///< The steps in the order they are applied
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINE_H
@@ -0,0 +1,198 @@
+/**
+ * @file PixelKernels.h
+ * @brief Declaration of the PixelKernels class, the vectorised per-pixel colour operations.
+ *
+ * The PixelKernels class implements the point operations used by the colour filters (grayscale,
+ * brightness, thresholding and the HSV/HSL conversions) on runs of packed, interleaved pixels.
+ * Every operation has a scalar implementation, which is the reference, and SSE4.1 and AVX2
+ * implementations that process 4 or 8 pixels per float instruction (16 or 32 bytes per integer
+ * instruction). The few pixels after the last full vector block go through the same vector code
+ * via a padded copy, so a pixel's result never depends on where a row or band starts. The best
+ * instruction set supported by both the build and the running CPU is selected once at runtime;
+ * builds for other architectures always use the scalar code.
+ *
+ * Differences from the scalar reference, in 0-255 output units:
+ * - brightness and threshold: none (integer arithmetic in both paths);
+ * - grayscale: none (the vector code uses the same double-precision weights and order);
+ * - HSV/HSL conversions: at most 1 per channel, with hue compared circularly because a hue
+ *   just below 360 degrees and one of 0 degrees describe the same colour.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELS_H
+
+#include <cstddef>
+
+/**
+ * @class PixelKernels
+ * @brief Static interface to the per-pixel colour kernels with runtime instruction set dispatch.
+ *
+ * All functions work on `count` consecutive pixels. Sources with 3 or 4 channels are read as
+ * RGB(A) and any alpha channel is ignored; colour-space outputs always have 3 channels.
+ * Source and destination must not overlap unless stated otherwise.
+ *
+ */
+class PixelKernels {
+public:
+    /**
+     * @brief Instruction sets the kernels can run on, from slowest to fastest.
+     */
+    enum class Isa {
+        Scalar, ///< Portable C++ reference implementation
+        SSE41,  ///< 128-bit SSE4.1 kernels
+        AVX2    ///< 256-bit AVX2 kernels
+    };
+
+    /**
+     * @brief Returns the fastest instruction set supported by both this build and the CPU.
+     * @return The best available instruction set.
+     */
+    static Isa detectIsa();
+
+    /**
+     * @brief Returns the instruction set currently used by the kernels.
+     * @return The active instruction set.
+     */
+    static Isa getIsa();
+
+    /**
+     * @brief Selects the instruction set used by subsequent calls (mainly for testing and benchmarks).
+     *
+     * Requests for an instruction set that is not available fall back to the best available one.
+     *
+     * @param isa The requested instruction set.
+     */
+    static void setIsa(Isa isa);
+
+    /**
+     * @brief Returns a printable name for an instruction set.
+     * @param isa The instruction set.
+     * @return "Scalar", "SSE4.1" or "AVX2".
+     */
+    static const char* isaName(Isa isa);
+
+    /**
+     * @brief Converts RGB(A) pixels to luminance using the weights 0.2126, 0.7152, 0.0722.
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source (3 or 4).
+     * @param dst Destination with one byte per pixel.
+     * @param count Number of pixels.
+     */
+    static void grayscale(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Adds a brightness offset to every byte, saturating to [0, 255].
+     * @param src Source bytes.
+     * @param dst Destination bytes (may be the same as src).
+     * @param count Number of bytes (pixels times channels).
+     * @param value Offset in [-255, 255].
+     */
+    static void addBrightness(const unsigned char* src, unsigned char* dst, size_t count, int value);
+
+    /**
+     * @brief Sets each output pixel to 255 if the source value is at least the threshold, else 0.
+     * @param src Source bytes; the value of pixel i is src[i * stride].
+     * @param stride Distance in bytes between consecutive source values (the image's channel count).
+     * @param dst Destination with one byte per pixel.
+     * @param count Number of pixels.
+     * @param thresholdValue The threshold.
+     */
+    static void threshold(const unsigned char* src, int stride, unsigned char* dst, size_t count, double thresholdValue);
+
+    /**
+     * @brief Converts RGB(A) pixels to HSV, each component scaled to 0-255.
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source (3 or 4).
+     * @param dst Interleaved 3-channel destination.
+     * @param count Number of pixels.
+     */
+    static void rgbToHsv(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Converts HSV pixels (components scaled to 0-255) back to RGB.
+     * @param src Interleaved source pixels; the first three channels are H, S and V.
+     * @param channels Number of channels in the source (at least 3).
+     * @param dst Interleaved 3-channel destination.
+     * @param count Number of pixels.
+     */
+    static void hsvToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Converts RGB(A) pixels to HSL, each component scaled to 0-255.
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source (3 or 4).
+     * @param dst Interleaved 3-channel destination.
+     * @param count Number of pixels.
+     */
+    static void rgbToHsl(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Converts HSL pixels (components scaled to 0-255) back to RGB.
+     * @param src Interleaved source pixels; the first three channels are H, S and L.
+     * @param channels Number of channels in the source (at least 3).
+     * @param dst Interleaved 3-channel destination.
+     * @param count Number of pixels.
+     */
+    static void hslToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Computes the HSV value of RGB(A) pixels, max(R, G, B), without the rest of the conversion.
+     *
+     * Equal to channel 2 of `rgbToHsv`.
+     *
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source (3 or 4).
+     * @param dst Destination with one byte per pixel.
+     * @param count Number of pixels.
+     */
+    static void rgbToValue(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Computes the HSL lightness of RGB(A) pixels, (max(R, G, B) + min(R, G, B)) / 2 rounded down, without
+     *        the rest of the conversion.
+     *
+     * Equal to channel 2 of `rgbToHsl`.
+     *
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source (3 or 4).
+     * @param dst Destination with one byte per pixel.
+     * @param count Number of pixels.
+     */
+    static void rgbToLightness(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Copies channel 0 of interleaved pixels into a contiguous row.
+     * @param src Interleaved source pixels.
+     * @param channels Number of channels in the source; 3 and 4 are vectorised.
+     * @param dst Destination with one byte per pixel.
+     * @param count Number of pixels.
+     */
+    static void firstChannel(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+
+    /**
+     * @brief Replaces every value by its entry in a 256-entry table.
+     *
+     * Contiguous runs use a vectorised table lookup; strided runs, used to remap one channel of interleaved
+     * pixels, are looked up one value at a time.
+     *
+     * @param src Source bytes; value i is src[i * stride].
+     * @param dst Destination bytes; value i is written to dst[i * stride]. May be the same as `src`.
+     * @param stride Distance in bytes between consecutive values in both source and destination.
+     * @param count Number of values.
+     * @param table The 256 output values, indexed by the source value.
+     */
+    static void lookup(const unsigned char* src, unsigned char* dst, int stride, size_t count, const unsigned char* table);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELS_H
@@ -0,0 +1,544 @@
+/**
+ * @file PixelKernelsSimd.h
+ * @brief Internal header shared by the SSE4.1 and AVX2 implementations of PixelKernels.
+ *
+ * The colour conversions are written once as templates over a small vector interface
+ * (`Sse41Vec` with 4 float lanes, `Avx2Vec` with 8) and instantiated by
+ * PixelKernelsSSE41.cpp and PixelKernelsAVX2.cpp, which are compiled with the matching
+ * instruction set enabled. Everything in this header has internal linkage so the two
+ * instantiations can never be merged by the linker, and the vector code is only visible
+ * when the including file is compiled for SSE4.1 or better.
+ *
+ * Each kernel processes whole vector blocks and returns the number of pixels (or bytes) it
+ * handled; PixelKernels finishes the remainder with the scalar reference code.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSSIMD_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSSIMD_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Entry points of one vectorised implementation of the PixelKernels operations.
+ *
+ * Every function returns how many leading pixels (bytes for addBrightness) it processed.
+ */
+struct PixelKernelTable {
+    size_t (*grayscale)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*addBrightness)(const unsigned char* src, unsigned char* dst, size_t count, int value);
+    size_t (*threshold)(const unsigned char* src, unsigned char* dst, size_t count, int minimum); ///< Contiguous source, minimum in [1, 255]
+    size_t (*rgbToHsv)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*hsvToRgb)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*rgbToHsl)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*hslToRgb)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*lookup)(const unsigned char* src, unsigned char* dst, size_t count, const unsigned char* table); ///< Contiguous source and destination
+    size_t (*rgbToValue)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*rgbToLightness)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+    size_t (*firstChannel)(const unsigned char* src, int channels, unsigned char* dst, size_t count);
+};
+
+/**
+ * @brief Returns the SSE4.1 kernels, or nullptr if this build does not include them.
+ */
+const PixelKernelTable* sse41PixelKernels();
+
+/**
+ * @brief Returns the AVX2 kernels, or nullptr if this build does not include them.
+ */
+const PixelKernelTable* avx2PixelKernels();
+
+#if defined(__SSE4_1__)
+#include <immintrin.h>
+
+namespace {
+
+// Shuffle mask gathering channel `c` of four interleaved pixels into the low four bytes
+inline __m128i channelMask(int channels, int c) {
+    return _mm_setr_epi8(static_cast<char>(c), static_cast<char>(c + channels),
+                         static_cast<char>(c + 2 * channels), static_cast<char>(c + 3 * channels),
+                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+}
+
+// Masks for the first three channels of a pixel format
+struct ChannelMasks {
+    __m128i first, second, third;
+    explicit ChannelMasks(int channels)
+        : first(channelMask(channels, 0)), second(channelMask(channels, 1)), third(channelMask(channels, 2)) {}
+};
+
+// Loads four bytes of one channel (16 bytes are read from p) as floats
+inline __m128 loadChannel4(const unsigned char* p, __m128i mask) {
+    __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), mask);
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes));
+}
+
+// Truncates four floats to bytes (saturating) in the low four bytes
+inline __m128i packBytes4(__m128 v) {
+    __m128i words = _mm_packus_epi32(_mm_cvttps_epi32(v), _mm_setzero_si128());
+    return _mm_packus_epi16(words, _mm_setzero_si128());
+}
+
+// Writes four pixels of three channels as 12 interleaved bytes
+inline void storeThree4(unsigned char* p, __m128 a, __m128 b, __m128 c) {
+    __m128i ab = _mm_unpacklo_epi8(packBytes4(a), packBytes4(b));
+    __m128i c0 = _mm_unpacklo_epi8(packBytes4(c), _mm_setzero_si128());
+    __m128i abc0 = _mm_unpacklo_epi16(ab, c0);
+    __m128i packed = _mm_shuffle_epi8(abc0, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), packed);
+    int tail = _mm_extract_epi32(packed, 2);
+    std::memcpy(p + 8, &tail, 4);
+}
+
+// Writes four single-byte pixels
+inline void storeOne4(unsigned char* p, __m128 v) {
+    int bytes = _mm_cvtsi128_si32(packBytes4(v));
+    std::memcpy(p, &bytes, 4);
+}
+
+// 4 float lanes / 16 byte lanes
+struct Sse41Vec {
+    using F = __m128;
+    using I = __m128i;
+    static constexpr int lanes = 4;
+    static constexpr int byteLanes = 16;
+
+    static F set1(float v) { return _mm_set1_ps(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm_div_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+    static F floor(F a) { return _mm_floor_ps(a); }
+    static F abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static F lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+    static F ge(F a, F b) { return _mm_cmpge_ps(a, b); }
+    static F eq(F a, F b) { return _mm_cmpeq_ps(a, b); }
+    static F select(F mask, F a, F b) { return _mm_blendv_ps(b, a, mask); }
+
+    static F load(const unsigned char* p, int, __m128i mask) { return loadChannel4(p, mask); }
+    static void storeThree(unsigned char* p, F a, F b, F c) { storeThree4(p, a, b, c); }
+    static void storeOne(unsigned char* p, F v) { storeOne4(p, v); }
+
+    static I set1Byte(int v) { return _mm_set1_epi8(static_cast<char>(v)); }
+    static I loadBytes(const unsigned char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void storeBytes(unsigned char* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static I addSaturate(I a, I b) { return _mm_adds_epu8(a, b); }
+    static I subSaturate(I a, I b) { return _mm_subs_epu8(a, b); }
+    static I atLeast(I v, I minimum) { return _mm_cmpeq_epi8(_mm_max_epu8(v, minimum), v); }
+    static I equal(I a, I b) { return _mm_cmpeq_epi8(a, b); }
+    static I bitAnd(I a, I b) { return _mm_and_si128(a, b); }
+    static I bitOr(I a, I b) { return _mm_or_si128(a, b); }
+    static I highNibbles(I v) { return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)); }
+    static I broadcast16(const unsigned char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static I shuffle(I table, I index) { return _mm_shuffle_epi8(table, index); }
+};
+
+#if defined(__AVX2__)
+// 8 float lanes / 32 byte lanes
+struct Avx2Vec {
+    using F = __m256;
+    using I = __m256i;
+    static constexpr int lanes = 8;
+    static constexpr int byteLanes = 32;
+
+    static F set1(float v) { return _mm256_set1_ps(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm256_div_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F floor(F a) { return _mm256_floor_ps(a); }
+    static F abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static F lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static F ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static F eq(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static F select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+
+    // Two 4-pixel gathers joined into eight bytes, widened in one step
+    static F load(const unsigned char* p, int channels, __m128i mask) {
+        __m128i low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), mask);
+        __m128i high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4 * channels)), mask);
+        return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpacklo_epi32(low, high)));
+    }
+    static void storeThree(unsigned char* p, F a, F b, F c) {
+        storeThree4(p, _mm256_castps256_ps128(a), _mm256_castps256_ps128(b), _mm256_castps256_ps128(c));
+        storeThree4(p + 12, _mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1), _mm256_extractf128_ps(c, 1));
+    }
+    static void storeOne(unsigned char* p, F v) {
+        storeOne4(p, _mm256_castps256_ps128(v));
+        storeOne4(p + 4, _mm256_extractf128_ps(v, 1));
+    }
+
+    static I set1Byte(int v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static I loadBytes(const unsigned char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void storeBytes(unsigned char* p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static I addSaturate(I a, I b) { return _mm256_adds_epu8(a, b); }
+    static I subSaturate(I a, I b) { return _mm256_subs_epu8(a, b); }
+    static I atLeast(I v, I minimum) { return _mm256_cmpeq_epi8(_mm256_max_epu8(v, minimum), v); }
+    static I equal(I a, I b) { return _mm256_cmpeq_epi8(a, b); }
+    static I bitAnd(I a, I b) { return _mm256_and_si256(a, b); }
+    static I bitOr(I a, I b) { return _mm256_or_si256(a, b); }
+    static I highNibbles(I v) { return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)); }
+    // The byte shuffle works within each 128-bit half, so both halves get the same 16 table entries
+    static I broadcast16(const unsigned char* p) {
+        return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+    static I shuffle(I table, I index) { return _mm256_shuffle_epi8(table, index); }
+};
+#endif
+
+// Number of pixels past a block that must exist so the 16-byte gathers stay inside the source
+inline int loadSlack(int channels) {
+    int overrun = 16 - 4 * channels;
+    return overrun <= 0 ? 0 : (overrun + channels - 1) / channels;
+}
+
+// The gathers address channels 0-2 of four pixels within 16 bytes
+inline bool gatherable(int channels) {
+    return channels >= 3 && channels <= 4;
+}
+
+// Luminance of four pixels, evaluated in double precision in the same order as the scalar
+// code so the result is bit-identical to it
+inline void grayscale4(const unsigned char* p, const ChannelMasks& masks, unsigned char* dst) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i r = _mm_cvtepu8_epi32(_mm_shuffle_epi8(pixels, masks.first));
+    __m128i g = _mm_cvtepu8_epi32(_mm_shuffle_epi8(pixels, masks.second));
+    __m128i b = _mm_cvtepu8_epi32(_mm_shuffle_epi8(pixels, masks.third));
+#if defined(__AVX2__)
+    const __m256d wr = _mm256_set1_pd(0.2126), wg = _mm256_set1_pd(0.7152), wb = _mm256_set1_pd(0.0722);
+    __m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(wr, _mm256_cvtepi32_pd(r)),
+                                              _mm256_mul_pd(wg, _mm256_cvtepi32_pd(g))),
+                                _mm256_mul_pd(wb, _mm256_cvtepi32_pd(b)));
+    __m128i values = _mm256_cvttpd_epi32(sum);
+#else
+    const __m128d wr = _mm_set1_pd(0.2126), wg = _mm_set1_pd(0.7152), wb = _mm_set1_pd(0.0722);
+    __m128i halves[2];
+    for (int h = 0; h < 2; ++h) {
+        __m128d sum = _mm_add_pd(_mm_add_pd(_mm_mul_pd(wr, _mm_cvtepi32_pd(r)), _mm_mul_pd(wg, _mm_cvtepi32_pd(g))),
+                                 _mm_mul_pd(wb, _mm_cvtepi32_pd(b)));
+        halves[h] = _mm_cvttpd_epi32(sum);
+        r = _mm_srli_si128(r, 8);
+        g = _mm_srli_si128(g, 8);
+        b = _mm_srli_si128(b, 8);
+    }
+    __m128i values = _mm_unpacklo_epi64(halves[0], halves[1]);
+#endif
+    __m128i bytes = _mm_packus_epi16(_mm_packus_epi32(values, _mm_setzero_si128()), _mm_setzero_si128());
+    int packed = _mm_cvtsi128_si32(bytes);
+    std::memcpy(dst, &packed, 4);
+}
+
+template <class V>
+size_t grayscaleBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        for (int quad = 0; quad < V::lanes; quad += 4) {
+            grayscale4(src + (i + quad) * channels, masks, dst + i + quad);
+        }
+    }
+    return i;
+}
+
+// HSV value (largest channel) or HSL lightness (mean of the largest and smallest, rounded down) of four pixels
+template <bool Lightness>
+inline void brightness4(const unsigned char* p, const ChannelMasks& masks, unsigned char* dst) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i r = _mm_shuffle_epi8(pixels, masks.first);
+    __m128i g = _mm_shuffle_epi8(pixels, masks.second);
+    __m128i b = _mm_shuffle_epi8(pixels, masks.third);
+    __m128i result = _mm_max_epu8(_mm_max_epu8(r, g), b);
+    if (Lightness) {
+        // The byte average rounds up; subtracting the low bit of the sum rounds it down instead
+        __m128i low = _mm_min_epu8(_mm_min_epu8(r, g), b);
+        __m128i odd = _mm_and_si128(_mm_xor_si128(result, low), _mm_set1_epi8(1));
+        result = _mm_sub_epi8(_mm_avg_epu8(result, low), odd);
+    }
+    int packed = _mm_cvtsi128_si32(result);
+    std::memcpy(dst, &packed, 4);
+}
+
+template <class V, bool Lightness>
+size_t brightnessBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        for (int quad = 0; quad < V::lanes; quad += 4) {
+            brightness4<Lightness>(src + (i + quad) * channels, masks, dst + i + quad);
+        }
+    }
+    return i;
+}
+
+template <class V>
+size_t firstChannelBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    const __m128i mask = channelMask(channels, 0);
+    const int slack = loadSlack(channels);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        for (int quad = 0; quad < V::lanes; quad += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + quad) * channels));
+            int packed = _mm_cvtsi128_si32(_mm_shuffle_epi8(pixels, mask));
+            std::memcpy(dst + i + quad, &packed, 4);
+        }
+    }
+    return i;
+}
+
+template <class V>
+size_t addBrightnessBlocks(const unsigned char* src, unsigned char* dst, size_t count, int value) {
+    using I = typename V::I;
+    const I delta = V::set1Byte(value < 0 ? -value : value);
+
+    size_t i = 0;
+    for (; i + V::byteLanes <= count; i += V::byteLanes) {
+        I v = V::loadBytes(src + i);
+        V::storeBytes(dst + i, value < 0 ? V::subSaturate(v, delta) : V::addSaturate(v, delta));
+    }
+    return i;
+}
+
+template <class V>
+size_t thresholdBlocks(const unsigned char* src, unsigned char* dst, size_t count, int minimum) {
+    using I = typename V::I;
+    const I limit = V::set1Byte(minimum);
+
+    size_t i = 0;
+    for (; i + V::byteLanes <= count; i += V::byteLanes) {
+        V::storeBytes(dst + i, V::atLeast(V::loadBytes(src + i), limit));
+    }
+    return i;
+}
+
+// 256-entry byte table lookup. The byte shuffle indexes 16 entries by the low nibble, so the table is split
+// into 16 rows of 16; each row is looked up for every byte and kept where the high nibble selects that row
+template <class V>
+size_t lookupBlocks(const unsigned char* src, unsigned char* dst, size_t count, const unsigned char* table) {
+    using I = typename V::I;
+    I rows[16];
+    for (int row = 0; row < 16; ++row) {
+        rows[row] = V::broadcast16(table + 16 * row);
+    }
+    const I lowMask = V::set1Byte(0x0F);
+
+    size_t i = 0;
+    for (; i + V::byteLanes <= count; i += V::byteLanes) {
+        I v = V::loadBytes(src + i);
+        I low = V::bitAnd(v, lowMask);
+        I high = V::highNibbles(v);
+        I result = V::bitAnd(V::shuffle(rows[0], low), V::equal(high, V::set1Byte(0)));
+        for (int row = 1; row < 16; ++row) {
+            result = V::bitOr(result, V::bitAnd(V::shuffle(rows[row], low), V::equal(high, V::set1Byte(row))));
+        }
+        V::storeBytes(dst + i, result);
+    }
+    return i;
+}
+
+// Picks the R, G, B primes of a hue sector (0-5) from chroma c and the second component x
+template <class V>
+void sectorToRgb(typename V::F sector, typename V::F c, typename V::F x,
+                 typename V::F& r, typename V::F& g, typename V::F& b) {
+    using F = typename V::F;
+    const F zero = V::set1(0.0f);
+    F lt1 = V::lt(sector, V::set1(1.0f));
+    F lt2 = V::lt(sector, V::set1(2.0f));
+    F lt3 = V::lt(sector, V::set1(3.0f));
+    F lt4 = V::lt(sector, V::set1(4.0f));
+    F lt5 = V::lt(sector, V::set1(5.0f));
+    r = V::select(lt1, c, V::select(lt2, x, V::select(lt4, zero, V::select(lt5, x, c))));
+    g = V::select(lt1, x, V::select(lt3, c, V::select(lt4, x, zero)));
+    b = V::select(lt2, zero, V::select(lt3, x, V::select(lt5, c, x)));
+}
+
+// Second largest component of the hexcone model: c * (1 - |fmod(t, 2) - 1|) for t >= 0
+template <class V>
+typename V::F hexconeX(typename V::F c, typename V::F t) {
+    using F = typename V::F;
+    const F one = V::set1(1.0f), two = V::set1(2.0f);
+    F mod2 = V::sub(t, V::mul(two, V::floor(V::mul(t, V::set1(0.5f)))));
+    return V::mul(c, V::sub(one, V::abs(V::sub(mod2, one))));
+}
+
+template <class V>
+size_t rgbToHsvBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    using F = typename V::F;
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+    const F zero = V::set1(0.0f), c255 = V::set1(255.0f), c360 = V::set1(360.0f);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        const unsigned char* p = src + i * channels;
+        F r = V::div(V::load(p, channels, masks.first), c255);
+        F g = V::div(V::load(p, channels, masks.second), c255);
+        F b = V::div(V::load(p, channels, masks.third), c255);
+
+        F maxValue = V::max(r, V::max(g, b));
+        F delta = V::sub(maxValue, V::min(r, V::min(g, b)));
+        F grey = V::lt(delta, V::set1(0.00001f));
+
+        F s = V::select(grey, zero, V::div(delta, maxValue));
+        F hueR = V::div(V::sub(g, b), delta);
+        F hueG = V::add(V::set1(2.0f), V::div(V::sub(b, r), delta));
+        F hueB = V::add(V::set1(4.0f), V::div(V::sub(r, g), delta));
+        F h = V::mul(V::select(V::ge(r, maxValue), hueR, V::select(V::ge(g, maxValue), hueG, hueB)), V::set1(60.0f));
+        h = V::select(V::lt(h, zero), V::add(h, c360), h);
+        h = V::select(grey, zero, h);
+
+        V::storeThree(dst + i * 3, V::mul(V::div(h, c360), c255), V::mul(s, c255), V::mul(maxValue, c255));
+    }
+    return i;
+}
+
+template <class V>
+size_t hsvToRgbBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    using F = typename V::F;
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+    const F c255 = V::set1(255.0f);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        const unsigned char* p = src + i * channels;
+        F h = V::mul(V::load(p, channels, masks.first), V::set1(360.0f / 255.0f));
+        F s = V::div(V::load(p, channels, masks.second), c255);
+        F v = V::div(V::load(p, channels, masks.third), c255);
+
+        F c = V::mul(v, s);
+        F t = V::div(h, V::set1(60.0f));
+        F x = hexconeX<V>(c, t);
+        F m = V::sub(v, c);
+
+        F r, g, b;
+        sectorToRgb<V>(V::floor(t), c, x, r, g, b);
+        V::storeThree(dst + i * 3,
+                      V::mul(V::add(r, m), c255), V::mul(V::add(g, m), c255), V::mul(V::add(b, m), c255));
+    }
+    return i;
+}
+
+template <class V>
+size_t rgbToHslBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    using F = typename V::F;
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+    const F zero = V::set1(0.0f), one = V::set1(1.0f), two = V::set1(2.0f), sixty = V::set1(60.0f);
+    const F c255 = V::set1(255.0f), c360 = V::set1(360.0f);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        const unsigned char* p = src + i * channels;
+        F r = V::div(V::load(p, channels, masks.first), c255);
+        F g = V::div(V::load(p, channels, masks.second), c255);
+        F b = V::div(V::load(p, channels, masks.third), c255);
+
+        F maxValue = V::max(r, V::max(g, b));
+        F minValue = V::min(r, V::min(g, b));
+        F delta = V::sub(maxValue, minValue);
+        F grey = V::eq(delta, zero);
+
+        F l = V::mul(V::add(maxValue, minValue), V::set1(0.5f));
+        F s = V::select(grey, zero, V::div(delta, V::sub(one, V::abs(V::sub(V::mul(two, l), one)))));
+        F hueR = V::mul(sixty, V::div(V::sub(g, b), delta));
+        F hueG = V::mul(sixty, V::add(V::div(V::sub(b, r), delta), two));
+        F hueB = V::mul(sixty, V::add(V::div(V::sub(r, g), delta), V::set1(4.0f)));
+        F h = V::select(V::eq(maxValue, r), hueR, V::select(V::eq(maxValue, g), hueG, hueB));
+        h = V::select(V::lt(h, zero), V::add(h, c360), h);
+        h = V::select(grey, zero, h);
+
+        V::storeThree(dst + i * 3, V::mul(V::div(h, c360), c255), V::mul(s, c255), V::mul(l, c255));
+    }
+    return i;
+}
+
+template <class V>
+size_t hslToRgbBlocks(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    if (!gatherable(channels)) {
+        return 0;
+    }
+    using F = typename V::F;
+    const ChannelMasks masks(channels);
+    const int slack = loadSlack(channels);
+    const F one = V::set1(1.0f), c255 = V::set1(255.0f);
+
+    size_t i = 0;
+    for (; i + V::lanes + slack <= count; i += V::lanes) {
+        const unsigned char* p = src + i * channels;
+        F h = V::mul(V::div(V::load(p, channels, masks.first), c255), V::set1(360.0f));
+        F s = V::div(V::load(p, channels, masks.second), c255);
+        F l = V::div(V::load(p, channels, masks.third), c255);
+
+        F c = V::mul(V::sub(one, V::abs(V::sub(V::mul(V::set1(2.0f), l), one))), s);
+        F t = V::div(h, V::set1(60.0f));
+        F x = hexconeX<V>(c, t);
+        F m = V::sub(l, V::mul(c, V::set1(0.5f)));
+
+        F r, g, b;
+        sectorToRgb<V>(V::floor(t), c, x, r, g, b);
+        V::storeThree(dst + i * 3,
+                      V::mul(V::add(r, m), c255), V::mul(V::add(g, m), c255), V::mul(V::add(b, m), c255));
+    }
+    return i;
+}
+
+template <class V>
+constexpr PixelKernelTable makePixelKernelTable() {
+    return PixelKernelTable{
+        &grayscaleBlocks<V>,
+        &addBrightnessBlocks<V>,
+        &thresholdBlocks<V>,
+        &rgbToHsvBlocks<V>,
+        &hsvToRgbBlocks<V>,
+        &rgbToHslBlocks<V>,
+        &hslToRgbBlocks<V>,
+        &lookupBlocks<V>,
+        &brightnessBlocks<V, false>,
+        &brightnessBlocks<V, true>,
+        &firstChannelBlocks<V>,
+    };
+}
+
+} // namespace
+
+#endif // __SSE4_1__
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSSIMD_H
@@ -22,8 +22,10 @@
 #define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PROJECTION_H
 #include "Image.h"
 #include "Volume.h"
+#include "BrickedVolume.h"
 
 #include <algorithm>
+#include <vector>
 
 /**
  * @class Projection
@@ -36,6 +38,114 @@
  */
 class Projection{
 public:
+    /**
+     * @brief Bit flags selecting which projections computeProjections produces.
+     */
+    enum Type : unsigned int {
+        Maximum = 1u << 0,           ///< Maximum Intensity Projection (MIP)
+        Minimum = 1u << 1,           ///< Minimum Intensity Projection (mIP)
+        Average = 1u << 2,           ///< Average Intensity Projection (AIP)
+        Median = 1u << 3,            ///< Median Intensity Projection (MeIP)
+        StandardDeviation = 1u << 4, ///< Per-pixel standard deviation along z
+        AllTypes = Maximum | Minimum | Average | Median | StandardDeviation
+    };
+
+    /**
+     * @brief Projections produced by a single call to computeProjections.
+     *
+     * Only the images selected by the requested flags are filled in; the others are left empty.
+     */
+    struct Result {
+        Image maximum;
+        Image minimum;
+        Image average;
+        Image median;
+        Image standardDeviation;
+    };
+
+    /**
+     * @brief Thin-slab projection stacks produced by computeSlabProjections.
+     *
+     * Entry i of each stack projects slices [i, i + slabThickness) (0-based). Only the stacks selected by the
+     * requested flags are filled in; the others are left empty.
+     */
+    struct SlabStack {
+        std::vector<Image> maximum;
+        std::vector<Image> minimum;
+        std::vector<Image> average;
+    };
+
+    /**
+     * @brief Computes several intensity projections in a single pass over a 3D volume.
+     *
+     * The volume is read slice by slice (z-major), so every voxel is touched once and each
+     * slice row is streamed contiguously into per-pixel accumulators. Rows are split into bands
+     * that run in parallel, and every band only writes its own rows of the outputs. Results are
+     * identical to the individual projection functions: the average is truncated, the median of
+     * an even number of slices is the truncated mean of the two middle values, and the standard
+     * deviation (population) is rounded to the nearest integer. Only channel 0 is projected.
+     * The median engine is chosen by the stack depth (see medianCrossoverDepth).
+     *
+     * @param volume The 3D volume to project.
+     * @param types Bitwise OR of Projection::Type flags selecting the outputs.
+     * @param z_start The first z-slice (1-based) to include. -1 starts from the first slice.
+     * @param z_end The last z-slice (1-based, inclusive) to include. -1 ends at the last slice.
+     * @return The selected projections, each a single-channel image of the volume's width and height.
+     * @throw std::out_of_range If the slice range is empty or outside the volume.
+     */
+    static Result computeProjections(const Volume& volume, unsigned int types, int z_start=-1, int z_end=-1);
+
+    /**
+     * @brief Returns the stack depth from which median projections use per-pixel histograms.
+     *
+     * Shorter stacks select the median with two counting passes on 4-bit digits, which clears and scans 32
+     * counters per pixel instead of 256 but reads the voxels twice. The crossover depends on the machine, so
+     * it is measured on first use by timing both engines on a small synthetic stack. Both engines give
+     * identical results.
+     *
+     * @return The crossover depth in slices.
+     */
+    static int medianCrossoverDepth();
+
+    /**
+     * @brief Overrides the median engine crossover.
+     * @param depth Stack depth from which histograms are used. 0 measures it again on the next median projection.
+     */
+    static void setMedianCrossoverDepth(int depth);
+
+    /**
+     * @brief Computes thin-slab projections for a slab starting at every slice, in one pass over the volume.
+     *
+     * Produces depth - slabThickness + 1 projections per selected type, slab i being identical to the full
+     * projection over slices i + 1 to i + slabThickness (1-based). The maximum and minimum combine per-block
+     * suffix and prefix extremes (van Herk/Gil-Werman) and the average keeps a running sum, so each voxel costs
+     * a constant number of operations and the total does not grow with the slab thickness. Rows are split into
+     * bands that run in parallel. Only channel 0 is projected.
+     *
+     * @param volume The 3D volume to project.
+     * @param slabThickness Number of slices per slab.
+     * @param types Bitwise OR of Maximum, Minimum and Average.
+     * @return The selected stacks, each image single-channel with the volume's width and height.
+     * @throw std::invalid_argument If the thickness is not in [1, depth] or types selects other projections.
+     */
+    static SlabStack computeSlabProjections(const Volume& volume, int slabThickness, unsigned int types);
+
+    /**
+     * @brief Computes several intensity projections of a bricked volume.
+     *
+     * The volume is streamed in columns one brick wide and one brick tall that span the selected slices,
+     * so at most one column is held densely in memory besides the brick cache. Each column is projected
+     * with the in-memory engine, so the results are identical to projecting the whole volume.
+     *
+     * @param volume The bricked volume to project.
+     * @param types Bitwise OR of Projection::Type flags selecting the outputs.
+     * @param z_start The first z-slice (1-based) to include. -1 starts from the first slice.
+     * @param z_end The last z-slice (1-based, inclusive) to include. -1 ends at the last slice.
+     * @return The selected projections, each a single-channel image of the volume's width and height.
+     * @throw std::out_of_range If the slice range is empty or outside the volume.
+     */
+    static Result computeProjections(const BrickedVolume& volume, unsigned int types, int z_start=-1, int z_end=-1);
+
     /**
      * @brief Generates a Maximum Intensity Projection (MIP) from a 3D volume.
      * 
@@ -48,6 +158,7 @@ public:
      * @return A image containing the Maximum Intensity Projection (MIP) of the 3D volume.
     */
     static Image maximumIntensityProjection(const Volume& volume, int z_start=-1, int z_end=-1);
+    static Image maximumIntensityProjection(const BrickedVolume& volume, int z_start=-1, int z_end=-1); ///< Streams a bricked volume.
 
     /**
      * @brief Generates a Minimum Intensity Projection (mIP) from a 3D volume.
@@ -61,6 +172,7 @@ public:
      * @return A image containing the Minimum Intensity Projection (mIP) of the 3D volume.
     */
     static Image minimumIntensityProjection(const Volume& volume, int z_start=-1, int z_end=-1);
+    static Image minimumIntensityProjection(const BrickedVolume& volume, int z_start=-1, int z_end=-1); ///< Streams a bricked volume.
 
     /**
      * @brief Generates an Average Intensity Projection (AIP) from a 3D volume.
@@ -74,6 +186,7 @@ public:
      * @return A image containing the Average Intensity Projection (AIP) of the 3D volume.
     */
     static Image averageIntensityProjection(const Volume& volume, int z_start=-1, int z_end=-1);
+    static Image averageIntensityProjection(const BrickedVolume& volume, int z_start=-1, int z_end=-1); ///< Streams a bricked volume.
 
     /**
      * @brief Generates a Median Intensity Projection (MeIP) from a 3D volume.
@@ -81,15 +194,16 @@ public:
      * This method generates a Median Intensity Projection (MeIP) from a 3D volume.
      * The MeIP is created by projecting the median intensity value along the z-axis for each pixel.
      * 
-     * This function chooses between two methods to generate the MeIP based on depth of the volume:
-     * - Histogram method: Uses a histogram to calculate the median intensity value. (for depths >= 500)
-     * - Quick Sort method: Uses the Quick Sort algorithm to sort the intensity values. (for depths < 500)
+     * The median is computed by the single-pass projection engine (see computeProjections) from
+     * per-pixel intensity histograms. The histogram and Quick Sort variants below are kept as
+     * reference implementations.
      *  
      * @param volume The 3D volume to generate the MeIP from.
      * @param z_start The starting z-slice index for the MeIP. If not specified, the MeIP is generated from the first z-slice.
      * @param z_end The ending z-slice index for the MeIP. If not specified, the MeIP is generated to the last z-slice.
     */
     static Image medianIntensityProjection(const Volume& volume, int z_start=-1, int z_end=-1);
+    static Image medianIntensityProjection(const BrickedVolume& volume, int z_start=-1, int z_end=-1); ///< Streams a bricked volume.
 
     /**
      * @brief Generates a Median Intensity Projection (MeIP) from a 3D volume.
@@ -154,5 +268,12 @@ public:
      * @return The partition index.
     */
     static void quickSort(unsigned char* arr, int low, int high);
+
+private:
+    // Converts the user-facing z_start/z_end arguments into a half-open slice range
+    static void resolveSliceRange(int depth, int z_start, int z_end, int& startZ, int& endZ);
+
+    // Projection engine over [startZ, endZ); radixMedian selects the counting median instead of histograms
+    static Result project(const Volume& volume, unsigned int types, int startZ, int endZ, bool radixMedian);
 };
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PROJECTION_H
\ No newline at end of file
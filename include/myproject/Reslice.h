@@ -0,0 +1,124 @@
+/**
+ * @file Reslice.h
+ * @brief Declaration of the Reslice class, which extracts many orthogonal or oblique planes from a volume at once.
+ *
+ * Multi-planar reconstruction (MPR) views need XZ, YZ and arbitrary oblique planes through a volume. Reslice
+ * extracts a whole batch of them in one pass instead of gathering one voxel at a time per slice: orthogonal slices
+ * read every needed volume row once and distribute it to all requested slices, and oblique planes are sampled with
+ * trilinear interpolation in small output tiles, so neighbouring samples hit the same cache lines. All extraction
+ * runs on the shared `Parallel` pool.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_RESLICE_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_RESLICE_H
+
+#include <array>
+#include <vector>
+#include "Image.h"
+#include "Volume.h"
+
+/**
+ * @class Reslice
+ * @brief Static batch extraction of XZ, YZ and oblique planes from a volume.
+ *
+ * Coordinates are in voxels, with voxel (x, y, z) centred on the integer point (x, y, z). Extracted planes are
+ * Images with the volume's channels.
+ *
+ */
+class Reslice {
+public:
+    /**
+     * @brief An oblique sampling plane.
+     *
+     * Output pixel (i, j) samples the volume at `origin + i * u + j * v`. The lengths of u and v set the pixel
+     * spacing in voxels, so unit vectors sample at the volume's resolution.
+     */
+    struct Plane {
+        std::array<double, 3> origin; ///< Volume position of output pixel (0, 0)
+        std::array<double, 3> u;      ///< Step between neighbouring output columns
+        std::array<double, 3> v;      ///< Step between neighbouring output rows
+        int width;                    ///< Number of output columns
+        int height;                   ///< Number of output rows
+    };
+
+    /**
+     * @brief Builds a plane centred on a point and perpendicular to a direction, with unit pixel spacing.
+     *
+     * The in-plane axes are chosen so that u stays horizontal (no z component) whenever the normal is not
+     * vertical, which keeps the image upright in a viewer. An axis-aligned normal gives an orthogonal plane.
+     *
+     * @param centre Volume position at the centre of the output image.
+     * @param normal Direction perpendicular to the plane. It does not need to be normalised.
+     * @param width Number of output columns.
+     * @param height Number of output rows.
+     * @return The plane.
+     * @throw std::invalid_argument if the normal is zero or the size is not positive.
+     */
+    static Plane planeThrough(const std::array<double, 3>& centre, const std::array<double, 3>& normal,
+                              int width, int height);
+
+    /**
+     * @brief Extracts several XZ slices in one pass over the volume.
+     *
+     * Each slice equals `Volume::getSliceXZ`: width x depth pixels, one row per z. Every row is copied once,
+     * directly from the volume.
+     *
+     * @param volume The source volume.
+     * @param ys y positions of the slices.
+     * @return One image per requested position, in the same order.
+     * @throw std::out_of_range if a position is outside the volume.
+     */
+    static std::vector<Image> extractXZ(const Volume& volume, const std::vector<int>& ys);
+
+    /**
+     * @brief Extracts several YZ slices in one pass over the volume.
+     *
+     * Each slice equals `Volume::getSliceYZ`: height x depth pixels, one row per z. Instead of striding through
+     * the volume once per slice, every volume row is read once and its voxels are scattered to all slices.
+     *
+     * @param volume The source volume.
+     * @param xs x positions of the slices.
+     * @return One image per requested position, in the same order.
+     * @throw std::out_of_range if a position is outside the volume.
+     */
+    static std::vector<Image> extractYZ(const Volume& volume, const std::vector<int>& xs);
+
+    /**
+     * @brief Samples several oblique planes with trilinear interpolation.
+     *
+     * Samples more than half a voxel outside the volume are 0; nearer ones use the edge voxels. Interpolated
+     * values are rounded to the nearest integer, so a sample exactly on a voxel centre returns that voxel. The
+     * output of all planes is split into square tiles that are sampled in parallel.
+     *
+     * @param volume The source volume.
+     * @param planes The planes to sample.
+     * @return One image per plane, in the same order.
+     * @throw std::invalid_argument if a plane has a non-positive size.
+     */
+    static std::vector<Image> extractOblique(const Volume& volume, const std::vector<Plane>& planes);
+
+    /**
+     * @brief Samples one voxel position with trilinear interpolation.
+     * @param volume The source volume.
+     * @param x x position in voxels.
+     * @param y y position in voxels.
+     * @param z z position in voxels.
+     * @param channel The channel to sample.
+     * @return The interpolated value before rounding, or 0 more than half a voxel outside the volume.
+     * @throw std::out_of_range if the channel does not exist.
+     */
+    static float sampleTrilinear(const Volume& volume, double x, double y, double z, int channel);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_RESLICE_H
@@ -22,6 +22,7 @@
 #define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_SLICE_H
 #include <memory>
 #include <string>
+#include "Views.h"
 
 /**
  * @class Slice
@@ -82,7 +83,9 @@ public:
      * @param channel The channel index of the pixel.
      * @return The intensity value of the pixel at (x, y) in the specified channel.
      */
-    [[nodiscard]] unsigned char getPixel(int x, int y, int channel) const;
+    [[nodiscard]] unsigned char getPixel(int x, int y, int channel) const {
+        return view()(x, y, channel);
+    }
 
     /**
      * @brief Sets the intensity value of a pixel at the specified location and channel.
@@ -91,7 +94,25 @@ public:
      * @param channel The channel index of the pixel.
      * @param value The new intensity value for the pixel at (x, y) in the specified channel.
      */
-    void setPixel(int x, int y, int channel, unsigned char value);
+    void setPixel(int x, int y, int channel, unsigned char value) {
+        view()(x, y, channel) = value;
+    }
+
+    /**
+     * @brief Returns an unchecked packed view of the pixels for writing.
+     * @return The view.
+     */
+    [[nodiscard]] PlaneView<unsigned char> view() {
+        return PlaneView<unsigned char>(data.get(), width, height, channels);
+    }
+
+    /**
+     * @brief Returns an unchecked packed read-only view of the pixels.
+     * @return The view.
+     */
+    [[nodiscard]] PlaneView<const unsigned char> view() const {
+        return PlaneView<const unsigned char>(data.get(), width, height, channels);
+    }
 
 private:
     int width, height, channels;///< Dimensions of the slice and number of channels per pixel.
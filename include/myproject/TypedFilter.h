@@ -0,0 +1,85 @@
+/**
+ * @file TypedFilter.h
+ * @brief Declaration of TypedFilter, filters for 8-bit, 16-bit and floating-point images and volumes.
+ *
+ * The filters are function templates over the sample type, explicitly instantiated for `uint8_t`, `uint16_t` and
+ * `float` in TypedFilter.cpp, so every type gets its own compiled kernel. All arithmetic is done in float and the
+ * result is stored with `PixelTraits<T>::fromFloat`: integer types truncate and clamp once per filter, and float
+ * keeps the exact result. Chaining float filters (for example a Gaussian blur and then a Sobel operator) therefore
+ * never quantises an intermediate image. The 8-bit instantiations give the same results as the matching `Filter`
+ * functions.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDFILTER_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDFILTER_H
+
+#include "TypedImage.h"
+#include "TypedVolume.h"
+
+/**
+ * @class TypedFilter
+ * @brief Static filters templated over the sample type.
+ *
+ * Like `Filter`, the 2D filters write into a caller-supplied output whose buffer is reused when its size matches,
+ * the output may be the input, and the work is split into row bands on the shared `Parallel` executor.
+ *
+ */
+class TypedFilter {
+public:
+    /**
+     * @brief Applies a separable Gaussian blur with clamped borders.
+     *
+     * Like `Filter::gaussianBlur` by default, this always uses the direct kernel, never the recursive approximation.
+     *
+     * @tparam T The sample type.
+     * @param image The input image.
+     * @param output The blurred image, with the input's size and channels.
+     * @param kernelSize Size of the kernel. Must be odd.
+     * @param sigma Standard deviation of the Gaussian.
+     * @throw std::invalid_argument if the kernel size is even.
+     */
+    template <typename T>
+    static void gaussianBlur(const TypedImage<T>& image, TypedImage<T>& output, int kernelSize, float sigma);
+
+    /**
+     * @brief Computes the Sobel gradient magnitude of channel 0.
+     *
+     * As in `Filter::applySobelOperator`, the output has one channel and its border pixels are 0. Float output
+     * keeps the magnitude unrounded and unclamped.
+     *
+     * @tparam T The sample type.
+     * @param image The input image.
+     * @param output The gradient magnitude.
+     */
+    template <typename T>
+    static void sobel(const TypedImage<T>& image, TypedImage<T>& output);
+
+    /**
+     * @brief Applies a separable 3D Gaussian blur in place, with clamped borders.
+     *
+     * The passes run in the same order as `Filter::apply3DGaussianBlur`: z, reading the samples in place, into a
+     * per-thread ring of kernelSize float rows, then y and x into the output row. Besides the output volume each
+     * thread keeps only those rows, so large 16-bit volumes need no float copy of the whole volume.
+     *
+     * @tparam T The sample type.
+     * @param volume The volume to blur.
+     * @param kernelSize Size of the kernel along each axis. Must be odd.
+     * @param sigma Standard deviation of the Gaussian.
+     * @throw std::invalid_argument if the kernel size is even.
+     */
+    template <typename T>
+    static void apply3DGaussianBlur(TypedVolume<T>& volume, int kernelSize, float sigma);
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDFILTER_H
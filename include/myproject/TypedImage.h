@@ -0,0 +1,207 @@
+/**
+ * @file TypedImage.h
+ * @brief Declaration of TypedImage, an image whose pixels are 8-bit, 16-bit or floating-point samples.
+ *
+ * `Image` stores 8 bits per sample, which loses precision on 12- and 16-bit scans and forces every filter in a
+ * chain to quantise its result back to bytes. TypedImage holds `uint8_t`, `uint16_t` or `float` samples, loads
+ * 16-bit PNGs at full precision, and converts to and from `Image` at the ends of a pipeline. The filters in
+ * `TypedFilter` are compiled separately for each sample type, so a float chain such as a Gaussian blur followed by
+ * a Sobel operator keeps its intermediate results in float.
+ *
+ * Samples keep the values stored in the file; they are not rescaled to a common range. `PixelTraits` describes
+ * how each type stores a filter's floating-point result.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGE_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Image.h"
+#include "Views.h"
+
+/**
+ * @brief Properties of a pixel sample type, specialised for `uint8_t`, `uint16_t` and `float`.
+ *
+ * Filters compute in float and store their result with `fromFloat`. Integer types truncate and clamp to their
+ * range, as the 8-bit filters in `Filter` always have, so 8-bit typed results match them. Float stores the value
+ * unchanged, including negative or out-of-range values.
+ */
+template <typename T>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<uint8_t> {
+    static constexpr float maxValue = 255.0f; ///< Largest representable sample
+    static uint8_t fromFloat(float value) {
+        return static_cast<uint8_t>(std::min(std::max(value, 0.0f), maxValue));
+    }
+};
+
+template <>
+struct PixelTraits<uint16_t> {
+    static constexpr float maxValue = 65535.0f; ///< Largest representable sample
+    static uint16_t fromFloat(float value) {
+        return static_cast<uint16_t>(std::min(std::max(value, 0.0f), maxValue));
+    }
+};
+
+template <>
+struct PixelTraits<float> {
+    static float fromFloat(float value) {
+        return value;
+    }
+};
+
+/**
+ * @class TypedImage
+ * @brief A width x height image of interleaved samples of type T.
+ *
+ * @tparam T The sample type: `uint8_t`, `uint16_t` or `float`.
+ */
+template <typename T>
+class TypedImage {
+public:
+    using value_type = T; ///< The sample type.
+
+    /**
+     * @brief Default constructor that initializes an empty image.
+     */
+    TypedImage() = default;
+
+    /**
+     * @brief Constructs a zero-filled image.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param channels The number of channels per pixel.
+     * @throw std::invalid_argument if a dimension is negative.
+     */
+    TypedImage(int width, int height, int channels);
+
+    /**
+     * @brief Loads an image file, keeping 16-bit samples at full precision.
+     *
+     * 16-bit PNGs are read with `stbi_load_16` and 8-bit files with `stbi_load`; either way the stored sample
+     * values are kept (an 8-bit file is not stretched to 16 bits). An 8-bit TypedImage keeps the high byte of
+     * 16-bit samples, as `Image` does.
+     *
+     * @param filename The path to the image file.
+     * @return The loaded image.
+     * @throw std::runtime_error if the file cannot be loaded.
+     */
+    static TypedImage load(const std::string& filename);
+
+    /**
+     * @brief Copies an 8-bit image, keeping its sample values.
+     * @param image The source image.
+     * @return The converted image.
+     */
+    static TypedImage fromImage(const Image& image);
+
+    /**
+     * @brief Converts to an 8-bit image, truncating and clamping each sample to [0, 255].
+     * @return The 8-bit image.
+     */
+    [[nodiscard]] Image toImage() const;
+
+    /**
+     * @brief Converts to an 8-bit image by mapping a window of sample values linearly onto [0, 255].
+     *
+     * This is the usual way to display a 16-bit or float image: samples at or below `low` become 0, samples at or
+     * above `high` become 255, and values in between are rounded to the nearest step.
+     *
+     * @param low Sample value shown as black.
+     * @param high Sample value shown as white.
+     * @return The 8-bit image.
+     * @throw std::invalid_argument if high is not greater than low.
+     */
+    [[nodiscard]] Image toImage(float low, float high) const;
+
+    /**
+     * @brief Converts every sample to another type with `PixelTraits<U>::fromFloat`, without rescaling.
+     * @tparam U The new sample type.
+     * @return The converted image.
+     */
+    template <typename U>
+    [[nodiscard]] TypedImage<U> convert() const {
+        TypedImage<U> result(width, height, channels);
+        U* out = result.getData();
+        for (size_t i = 0; i < data.size(); ++i) {
+            out[i] = PixelTraits<U>::fromFloat(static_cast<float>(data[i]));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Changes the dimensions of the image, keeping the buffer's capacity. Sample values are unspecified.
+     * @param newWidth The new width.
+     * @param newHeight The new height.
+     * @param newChannels The new number of channels.
+     */
+    void resize(int newWidth, int newHeight, int newChannels) {
+        width = newWidth;
+        height = newHeight;
+        channels = newChannels;
+        data.resize(getSize());
+    }
+
+    /// Mutable view of the samples.
+    PlaneView<T> view() { return PlaneView<T>(data.data(), width, height, channels); }
+
+    /// Read-only view of the samples.
+    PlaneView<const T> view() const { return PlaneView<const T>(data.data(), width, height, channels); }
+
+    /**
+     * @brief Returns one sample. Unchecked like the views; debug builds assert that it is in range.
+     * @param x The column.
+     * @param y The row.
+     * @param channel The channel.
+     * @return The sample.
+     */
+    T getPixel(int x, int y, int channel) const { return view()(x, y, channel); }
+
+    /**
+     * @brief Sets one sample.
+     * @param x The column.
+     * @param y The row.
+     * @param channel The channel.
+     * @param value The new sample.
+     */
+    void setPixel(int x, int y, int channel, T value) { view()(x, y, channel) = value; }
+
+    int getWidth() const { return width; }       ///< Width of the image.
+    int getHeight() const { return height; }     ///< Height of the image.
+    int getChannels() const { return channels; } ///< Number of channels per pixel.
+    /// Number of samples, width * height * channels.
+    size_t getSize() const { return static_cast<size_t>(width) * height * channels; }
+    T* getData() { return data.data(); }             ///< Samples, row by row with interleaved channels.
+    const T* getData() const { return data.data(); } ///< Samples, row by row with interleaved channels.
+
+private:
+    int width = 0, height = 0, channels = 0;
+    std::vector<T> data;
+};
+
+using Image8 = TypedImage<uint8_t>;   ///< 8 bits per sample, the same values as Image.
+using Image16 = TypedImage<uint16_t>; ///< 16 bits per sample, e.g. CT slices.
+using ImageF = TypedImage<float>;     ///< Float samples, for filter chains without quantisation.
+
+extern template class TypedImage<uint8_t>;
+extern template class TypedImage<uint16_t>;
+extern template class TypedImage<float>;
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGE_H
@@ -0,0 +1,162 @@
+/**
+ * @file TypedVolume.h
+ * @brief Declaration of TypedVolume, a 3D volume whose voxels are 8-bit, 16-bit or floating-point samples.
+ *
+ * TypedVolume is the volumetric counterpart of TypedImage: a stack of 16-bit PNG slices loads without losing the
+ * low byte, and `TypedFilter` can blur it in float or 16 bits. Conversions to and from `Volume` connect it to the
+ * 8-bit projections and filters.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDVOLUME_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDVOLUME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TypedImage.h"
+#include "Views.h"
+#include "Volume.h"
+
+/**
+ * @class TypedVolume
+ * @brief A width x height x depth volume of interleaved samples of type T, stored slice after slice.
+ *
+ * @tparam T The sample type: `uint8_t`, `uint16_t` or `float`.
+ */
+template <typename T>
+class TypedVolume {
+public:
+    using value_type = T; ///< The sample type.
+
+    /**
+     * @brief Default constructor that initializes an empty volume.
+     */
+    TypedVolume() = default;
+
+    /**
+     * @brief Constructs a zero-filled volume.
+     * @param width Width of the volume in voxels.
+     * @param height Height of the volume in voxels.
+     * @param depth Number of slices.
+     * @param channels Number of channels per voxel.
+     * @throw std::invalid_argument if a dimension is negative.
+     */
+    TypedVolume(int width, int height, int depth, int channels);
+
+    /**
+     * @brief Loads a folder of .png slices, keeping 16-bit samples at full precision.
+     *
+     * Slices are ordered as in the `Volume` folder constructor and decoded in parallel with `TypedImage<T>::load`.
+     *
+     * @param folderPath Folder containing the slices.
+     * @return The volume.
+     * @throw std::runtime_error if the folder has no slices, a slice cannot be loaded, or the slices differ in size
+     *        or channel count.
+     */
+    static TypedVolume loadSlices(const std::string& folderPath);
+
+    /**
+     * @brief Copies an 8-bit volume, keeping its sample values.
+     * @param volume The source volume.
+     * @return The converted volume.
+     */
+    static TypedVolume fromVolume(const Volume& volume);
+
+    /**
+     * @brief Converts to an 8-bit volume, truncating and clamping each sample to [0, 255].
+     * @return The 8-bit volume.
+     */
+    [[nodiscard]] Volume toVolume() const;
+
+    /**
+     * @brief Converts to an 8-bit volume by mapping a window of sample values linearly onto [0, 255].
+     * @param low Sample value mapped to 0.
+     * @param high Sample value mapped to 255.
+     * @return The 8-bit volume.
+     * @throw std::invalid_argument if high is not greater than low.
+     */
+    [[nodiscard]] Volume toVolume(float low, float high) const;
+
+    /**
+     * @brief Copies one z slice.
+     * @param z Index of the slice (0-based).
+     * @return A width x height image with the volume's channels.
+     * @throw std::out_of_range if z is outside the volume.
+     */
+    [[nodiscard]] TypedImage<T> getSlice(int z) const;
+
+    /**
+     * @brief Converts every sample to another type with `PixelTraits<U>::fromFloat`, without rescaling.
+     * @tparam U The new sample type.
+     * @return The converted volume.
+     */
+    template <typename U>
+    [[nodiscard]] TypedVolume<U> convert() const {
+        TypedVolume<U> result(width, height, depth, channels);
+        U* out = result.getData();
+        for (size_t i = 0; i < data.size(); ++i) {
+            out[i] = PixelTraits<U>::fromFloat(static_cast<float>(data[i]));
+        }
+        return result;
+    }
+
+    /// Mutable view of the voxels.
+    VolumeView<T> view() { return VolumeView<T>(data.data(), width, height, depth, channels); }
+
+    /// Read-only view of the voxels.
+    VolumeView<const T> view() const { return VolumeView<const T>(data.data(), width, height, depth, channels); }
+
+    /**
+     * @brief Returns one sample. Unchecked like the views; debug builds assert that it is in range.
+     * @param x The column.
+     * @param y The row.
+     * @param z The slice.
+     * @param channel The channel.
+     * @return The sample.
+     */
+    T getVoxel(int x, int y, int z, int channel) const { return view()(x, y, z, channel); }
+
+    /**
+     * @brief Sets one sample.
+     * @param x The column.
+     * @param y The row.
+     * @param z The slice.
+     * @param channel The channel.
+     * @param value The new sample.
+     */
+    void setVoxel(int x, int y, int z, int channel, T value) { view()(x, y, z, channel) = value; }
+
+    int getWidth() const { return width; }       ///< Width of the volume in voxels.
+    int getHeight() const { return height; }     ///< Height of the volume in voxels.
+    int getDepth() const { return depth; }       ///< Number of slices.
+    int getChannels() const { return channels; } ///< Number of channels per voxel.
+    /// Number of samples, width * height * depth * channels.
+    size_t getSize() const { return static_cast<size_t>(width) * height * depth * channels; }
+    T* getData() { return data.data(); }             ///< Samples, x fastest, then y, then z.
+    const T* getData() const { return data.data(); } ///< Samples, x fastest, then y, then z.
+
+private:
+    int width = 0, height = 0, depth = 0, channels = 0;
+    std::vector<T> data;
+};
+
+using Volume16 = TypedVolume<uint16_t>; ///< 16 bits per sample, e.g. CT stacks.
+using VolumeF = TypedVolume<float>;     ///< Float samples, for filter chains without quantisation.
+
+extern template class TypedVolume<uint8_t>;
+extern template class TypedVolume<uint16_t>;
+extern template class TypedVolume<float>;
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDVOLUME_H
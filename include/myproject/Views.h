@@ -0,0 +1,232 @@
+/**
+ * @file Views.h
+ * @brief Declaration of PlaneView and VolumeView, lightweight strided views over pixel and voxel buffers.
+ *
+ * A view is a pointer plus dimensions and strides; it owns nothing and costs nothing to copy. All accessors
+ * are inline and unchecked, so inner loops compile to plain pointer arithmetic the compiler can vectorise.
+ * Filters typically take a row pointer once per row and index it directly. Coordinates and channels are
+ * checked with `assert` when the build defines neither NDEBUG nor ZIGGURAT_UNCHECKED_VIEWS, so debug builds
+ * still catch out-of-range accesses.
+ *
+ * Strides are counted in elements. A packed image has a pixel stride equal to its channel count and a row
+ * stride of width * channels; other strides describe sub-regions or planes cut through a volume without
+ * copying, such as the YZ plane returned by `VolumeView::planeYZ`.
+ *
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ *
+ */
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_VIEWS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_VIEWS_H
+
+#include <cassert>
+#include <cstddef>
+
+#if defined(NDEBUG) || defined(ZIGGURAT_UNCHECKED_VIEWS)
+#define ZIGGURAT_VIEW_CHECK(condition) ((void)0)
+#else
+#define ZIGGURAT_VIEW_CHECK(condition) assert(condition)
+#endif
+
+/**
+ * @class PlaneView
+ * @brief A 2D strided view of multi-channel pixels.
+ *
+ * @tparam T Element type, `unsigned char` for a mutable view or `const unsigned char` for a read-only one.
+ */
+template <typename T>
+class PlaneView {
+public:
+    PlaneView() = default;
+
+    /**
+     * @brief Creates a view over existing pixels.
+     * @param data Address of channel 0 of pixel (0, 0).
+     * @param width Number of pixels per row.
+     * @param height Number of rows.
+     * @param channels Number of channels per pixel.
+     * @param pixelStride Elements between neighbouring pixels of a row.
+     * @param rowStride Elements between neighbouring rows.
+     */
+    PlaneView(T* data, int width, int height, int channels, size_t pixelStride, size_t rowStride)
+            : data(data), width(width), height(height), channels(channels),
+              pixelStride(pixelStride), rowStride(rowStride) {}
+
+    /**
+     * @brief Creates a view over a packed buffer (pixel stride = channels, row stride = width * channels).
+     * @param data Address of the first pixel.
+     * @param width Number of pixels per row.
+     * @param height Number of rows.
+     * @param channels Number of channels per pixel.
+     */
+    PlaneView(T* data, int width, int height, int channels)
+            : PlaneView(data, width, height, channels, channels, static_cast<size_t>(width) * channels) {}
+
+    /// Read-only view of the same pixels.
+    operator PlaneView<const T>() const {
+        return PlaneView<const T>(data, width, height, channels, pixelStride, rowStride);
+    }
+
+    /**
+     * @brief Returns the address of the first pixel of a row. Pixels follow every `getPixelStride()` elements.
+     * @param y The row.
+     * @return Address of channel 0 of pixel (0, y).
+     */
+    T* row(int y) const {
+        ZIGGURAT_VIEW_CHECK(y >= 0 && y < height);
+        return data + static_cast<size_t>(y) * rowStride;
+    }
+
+    /**
+     * @brief Returns one channel of one pixel.
+     * @param x The column.
+     * @param y The row.
+     * @param channel The channel.
+     * @return Reference to the element.
+     */
+    T& operator()(int x, int y, int channel = 0) const {
+        ZIGGURAT_VIEW_CHECK(x >= 0 && x < width && y >= 0 && y < height && channel >= 0 && channel < channels);
+        return data[static_cast<size_t>(y) * rowStride + static_cast<size_t>(x) * pixelStride + channel];
+    }
+
+    /**
+     * @brief Returns the view of a rectangle inside this view, sharing its strides.
+     * @param x0 First column of the rectangle.
+     * @param y0 First row of the rectangle.
+     * @param regionWidth Width of the rectangle.
+     * @param regionHeight Height of the rectangle.
+     * @return The sub-view.
+     */
+    PlaneView region(int x0, int y0, int regionWidth, int regionHeight) const {
+        ZIGGURAT_VIEW_CHECK(x0 >= 0 && y0 >= 0 && regionWidth >= 0 && regionHeight >= 0
+                            && x0 + regionWidth <= width && y0 + regionHeight <= height);
+        return PlaneView(data + static_cast<size_t>(y0) * rowStride + static_cast<size_t>(x0) * pixelStride,
+                         regionWidth, regionHeight, channels, pixelStride, rowStride);
+    }
+
+    /// Reports whether pixels and rows are packed, so a row can be processed as one contiguous run.
+    bool isContiguous() const {
+        return pixelStride == static_cast<size_t>(channels) && rowStride == static_cast<size_t>(width) * channels;
+    }
+
+    T* getData() const { return data; }                 ///< Address of pixel (0, 0).
+    int getWidth() const { return width; }              ///< Number of pixels per row.
+    int getHeight() const { return height; }            ///< Number of rows.
+    int getChannels() const { return channels; }        ///< Number of channels per pixel.
+    size_t getPixelStride() const { return pixelStride; } ///< Elements between neighbouring pixels.
+    size_t getRowStride() const { return rowStride; }   ///< Elements between neighbouring rows.
+
+private:
+    T* data = nullptr;
+    int width = 0, height = 0, channels = 0;
+    size_t pixelStride = 0, rowStride = 0;
+};
+
+/**
+ * @class VolumeView
+ * @brief A 3D view of packed multi-channel voxels (x fastest, then y, then z).
+ *
+ * @tparam T Element type, `unsigned char` for a mutable view or `const unsigned char` for a read-only one.
+ */
+template <typename T>
+class VolumeView {
+public:
+    VolumeView() = default;
+
+    /**
+     * @brief Creates a view over a packed volume buffer.
+     * @param data Address of voxel (0, 0, 0).
+     * @param width Voxels per row.
+     * @param height Rows per slice.
+     * @param depth Number of slices.
+     * @param channels Number of channels per voxel.
+     */
+    VolumeView(T* data, int width, int height, int depth, int channels)
+            : data(data), width(width), height(height), depth(depth), channels(channels),
+              rowStride(static_cast<size_t>(width) * channels), sliceStride(rowStride * height) {}
+
+    /// Read-only view of the same voxels.
+    operator VolumeView<const T>() const {
+        return VolumeView<const T>(data, width, height, depth, channels);
+    }
+
+    /**
+     * @brief Returns the address of the first voxel of a row.
+     * @param y The row.
+     * @param z The slice.
+     * @return Address of channel 0 of voxel (0, y, z); the row's voxels are contiguous.
+     */
+    T* row(int y, int z) const {
+        ZIGGURAT_VIEW_CHECK(y >= 0 && y < height && z >= 0 && z < depth);
+        return data + static_cast<size_t>(z) * sliceStride + static_cast<size_t>(y) * rowStride;
+    }
+
+    /**
+     * @brief Returns one channel of one voxel.
+     * @param x The column.
+     * @param y The row.
+     * @param z The slice.
+     * @param channel The channel.
+     * @return Reference to the element.
+     */
+    T& operator()(int x, int y, int z, int channel = 0) const {
+        ZIGGURAT_VIEW_CHECK(x >= 0 && x < width && y >= 0 && y < height && z >= 0 && z < depth
+                            && channel >= 0 && channel < channels);
+        return data[static_cast<size_t>(z) * sliceStride + static_cast<size_t>(y) * rowStride
+                    + static_cast<size_t>(x) * channels + channel];
+    }
+
+    /**
+     * @brief Returns slice z as a packed plane (width x height).
+     * @param z The slice.
+     * @return The plane.
+     */
+    PlaneView<T> planeXY(int z) const {
+        ZIGGURAT_VIEW_CHECK(z >= 0 && z < depth);
+        return PlaneView<T>(data + static_cast<size_t>(z) * sliceStride, width, height, channels,
+                            channels, rowStride);
+    }
+
+    /**
+     * @brief Returns the XZ plane at row y (width x depth, one plane row per slice), without copying.
+     * @param y The row.
+     * @return The plane.
+     */
+    PlaneView<T> planeXZ(int y) const {
+        ZIGGURAT_VIEW_CHECK(y >= 0 && y < height);
+        return PlaneView<T>(data + static_cast<size_t>(y) * rowStride, width, depth, channels, channels, sliceStride);
+    }
+
+    /**
+     * @brief Returns the YZ plane at column x (height x depth, one plane row per slice), without copying.
+     * @param x The column.
+     * @return The plane. Its pixels are a whole volume row apart.
+     */
+    PlaneView<T> planeYZ(int x) const {
+        ZIGGURAT_VIEW_CHECK(x >= 0 && x < width);
+        return PlaneView<T>(data + static_cast<size_t>(x) * channels, height, depth, channels, rowStride, sliceStride);
+    }
+
+    T* getData() const { return data; }                 ///< Address of voxel (0, 0, 0).
+    int getWidth() const { return width; }              ///< Voxels per row.
+    int getHeight() const { return height; }            ///< Rows per slice.
+    int getDepth() const { return depth; }              ///< Number of slices.
+    int getChannels() const { return channels; }        ///< Number of channels per voxel.
+    size_t getRowStride() const { return rowStride; }   ///< Elements between neighbouring rows.
+    size_t getSliceStride() const { return sliceStride; } ///< Elements between neighbouring slices.
+
+private:
+    T* data = nullptr;
+    int width = 0, height = 0, depth = 0, channels = 0;
+    size_t rowStride = 0, sliceStride = 0;
+};
+
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_VIEWS_H
@@ -23,13 +23,13 @@
 
 #include "Image.h"
 #include "Slice.h"
+#include "Views.h"
 #include <vector>
 #include <string>
 #include <memory>
 #include <filesystem>
 #include <stdexcept>
 #include <algorithm>
-#include <regex>
 
 namespace fs = std::filesystem;
 
@@ -41,18 +41,33 @@ namespace fs = std::filesystem;
  * It allows for the modification of voxel values within the volume, accessing individual slices, and constructing new volumes with
  * specified dimensions. The class supports loading volume data from image files stored in a directory or specified via a list of filenames.
  *
+ * Slices are decoded concurrently on the shared `Parallel` pool. Every slice is copied straight to its offset in the
+ * volume buffer and its decoded image is released at once, so loading needs the volume plus one decoded slice per
+ * thread rather than the volume plus every slice.
+ *
+ * Volumes can also be stored in a raw `.zvol` file: a 4096-byte header followed by the voxels exactly as they are laid
+ * out in memory. `openRaw` maps such a file instead of reading it, so opening takes constant time and pages are read
+ * from disk only when first touched. The mapping is private: filters may modify the volume, but the changes are
+ * never written back to the file.
+ *
  */
 class Volume {
 public:
     /**
      * @brief Constructs a Volume object from a folder path.
      * @param folderPath A std::string representing the path to the folder containing image slices.
+     * @throw std::runtime_error if the folder has no .png slices or a slice cannot be loaded.
      */
     explicit Volume(const std::string& folderPath);
 
     /**
      * @brief Constructs a Volume object from a list of filenames.
+     *
+     * The files are ordered by natural sort. The first slice sets the width, height and channel count; other
+     * slices are converted to that channel count and must have the same width and height.
+     *
      * @param filenames A std::vector<std::string> containing the file names of the image slices.
+     * @throw std::runtime_error if the list is empty, a slice cannot be loaded or its size differs from the first.
      */
     explicit Volume(const std::vector<std::string>& filenames);
 
@@ -89,6 +104,86 @@ public:
      */
     ~Volume();
 
+    /// File extension of raw volume files.
+    static constexpr const char* rawExtension = ".zvol";
+
+    /// Offset of the voxel payload in a raw volume file; one page, so the voxels start page-aligned.
+    static constexpr size_t rawPayloadOffset = 4096;
+
+    /**
+     * @brief Opens a raw volume file without decoding or reading the voxels up front.
+     *
+     * On POSIX systems the file is memory-mapped copy-on-write, so the call returns in constant time and the
+     * operating system pages voxels in on first access. Elsewhere the payload is read into memory.
+     *
+     * @param path Path of a file written by `saveRaw` or `convertSlicesToRaw`.
+     * @return The volume backed by the file.
+     * @throw std::runtime_error if the file cannot be opened, is not a raw volume, or is truncated.
+     */
+    static Volume openRaw(const std::string& path);
+
+    /**
+     * @brief Writes the volume as a raw volume file that `openRaw` can map.
+     * @param path Destination path, conventionally ending in `rawExtension`.
+     * @throw std::runtime_error if the file cannot be written.
+     */
+    void saveRaw(const std::string& path) const;
+
+    /**
+     * @brief Creates a zero-filled raw volume file without writing the voxels.
+     *
+     * Only the header and the last byte are written, so on file systems with sparse files the payload takes no
+     * disk space until it is modified. Together with `openRaw` this gives volumes larger than the available memory,
+     * for example as a scratch output or to test code on multi-gigabyte volumes.
+     *
+     * @param path Destination path, conventionally ending in `rawExtension`.
+     * @param width Width of the volume in voxels.
+     * @param height Height of the volume in voxels.
+     * @param depth Number of slices.
+     * @param channels Number of channels per voxel.
+     * @throw std::invalid_argument if a dimension is not positive.
+     * @throw std::runtime_error if the file cannot be written.
+     */
+    static void createRaw(const std::string& path, int width, int height, int depth, int channels);
+
+    /**
+     * @brief Converts a folder of .png slices to a raw volume file without holding the whole volume in memory.
+     *
+     * Slices are ordered, decoded and checked as in the folder constructor. They are decoded in parallel a few at a
+     * time and appended to the file, so memory use is a small multiple of one slice.
+     *
+     * @param folderPath Folder containing the .png slices.
+     * @param rawPath Destination path of the raw volume file.
+     * @throw std::runtime_error if the folder has no slices, a slice cannot be loaded, or the file cannot be written.
+     */
+    static void convertSlicesToRaw(const std::string& folderPath, const std::string& rawPath);
+
+    /**
+     * @brief Sorts slice filenames into natural order, the order in which slices are stacked.
+     *
+     * Names are ordered by the numbers they contain, compared one after another by value (so "slice9" comes
+     * before "slice10" and "07" equals "7"); a name with fewer numbers sorts first when the shared ones are equal,
+     * and names with equal numbers are ordered by plain string comparison. Each name is tokenised once, so
+     * sorting n names costs O(n log n) comparisons of precomputed digit runs.
+     *
+     * @param filenames The filenames to sort in place.
+     */
+    static void sortSliceFilenames(std::vector<std::string>& filenames);
+
+    /**
+     * @brief Lists the .png slices in a folder, unsorted.
+     * @param folderPath The folder to list.
+     * @return Paths of the .png files in the folder.
+     * @throw std::filesystem::filesystem_error if the folder cannot be read.
+     */
+    static std::vector<std::string> listSliceFiles(const std::string& folderPath);
+
+    /**
+     * @brief Reports whether the voxels are backed by a memory-mapped raw volume file.
+     * @return true for volumes opened with `openRaw` on systems that support mapping.
+     */
+    [[nodiscard]] bool isMapped() const;
+
     /**
      * @brief Deleted copy assignment operator to prevent copying.
      */
@@ -101,6 +196,7 @@ public:
      * @param z The z-coordinate of the voxel.
      * @param channel The color channel of the voxel.
      * @param value The value to set the voxel to.
+     * @throw std::out_of_range if a coordinate or the channel is out of range. Inner loops use view() instead.
      */
     void setVoxel(int x, int y, int z, int channel, unsigned char value);
 
@@ -111,6 +207,7 @@ public:
      * @param z The z-coordinate of the voxel.
      * @param channel The color channel of the voxel.
      * @return The value of the voxel.
+     * @throw std::out_of_range if a coordinate or the channel is out of range. Inner loops use view() instead.
      */
     [[nodiscard]] unsigned char getVoxel(int x, int y, int z, int channel) const;
 
@@ -130,6 +227,7 @@ public:
 
     /**
      @brief Retrieves a slice of the volume along the YZ plane at a specified position.
+     * Each voxel is gathered with a stride of a whole row; `Reslice::extractYZ` extracts many YZ slices in one pass.
      * @param x The position of the slice in the x-axis.
      * @return Unique pointer to
      */
@@ -141,6 +239,22 @@ public:
      */
     [[nodiscard]] unsigned char* getVolumeData() const;
 
+    /**
+     * @brief Returns an unchecked view of the voxels for writing, for use in inner loops.
+     * @return The view. It is invalidated when the volume is moved from or assigned to.
+     */
+    [[nodiscard]] VolumeView<unsigned char> view() {
+        return VolumeView<unsigned char>(data, width, height, depth, channels);
+    }
+
+    /**
+     * @brief Returns an unchecked read-only view of the voxels, for use in inner loops.
+     * @return The view. It is invalidated when the volume is moved from or assigned to.
+     */
+    [[nodiscard]] VolumeView<const unsigned char> view() const {
+        return VolumeView<const unsigned char>(data, width, height, depth, channels);
+    }
+
     /**
      * @brief Returns the width of the volume.
      * @return The width of the volume in pixels.
@@ -166,13 +280,16 @@ public:
     [[nodiscard]] int getChannels() const;
 
 private:
-    std::vector<std::shared_ptr<Image>> slices; ///< Stores the volume's image slices.
     unsigned char* data; ///< Pointer to the raw volume data.
     int width, height, depth, channels; ///< Volume dimensions and number of channels.
+    void* mappedBase = nullptr; ///< Start of the file mapping when the volume was opened with openRaw.
+    size_t mappedLength = 0; ///< Length of the file mapping in bytes.
 
-    void loadImagesFromFolder(const std::string& folderPath);///< Load images from a folder.
-    void loadImagesFromFilenames(const std::vector<std::string>& filenames);///< Load images from a list of filenames.
-    void generate3DVolumeFromSlices();///< Generate 3D volume data from slices.
+    Volume();///< Empty volume, filled in by openRaw.
+    void release() noexcept;///< Free or unmap the voxel buffer.
+    static void decodeSlices(const std::vector<std::string>& sortedFilenames, int first, int count, int sliceWidth,
+                             int sliceHeight, int sliceChannels, unsigned char* destination);///< Decode slices in parallel.
+    void loadSlices(const std::vector<std::string>& filenames);///< Decode slices in parallel into the volume buffer.
 };
 
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_VOLUME_H
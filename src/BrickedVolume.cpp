@@ -0,0 +1,303 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "BrickedVolume.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Returns a spill file path that no other volume in this or another process is using
+std::filesystem::path uniqueSpillPath(const std::string& directory) {
+    static std::atomic<unsigned long> counter{0};
+    static const unsigned long processTag = std::random_device{}();
+    std::filesystem::path base = directory.empty() ? std::filesystem::temp_directory_path()
+                                                   : std::filesystem::path(directory);
+    return base / ("ziggurat_bricks_" + std::to_string(processTag) + "_" + std::to_string(counter++) + ".bin");
+}
+
+} // namespace
+
+// Least-recently-used brick cache backed by a spill file. Bricks are stored padded to full size,
+// so brick i always lives at offset i * brickBytes in the file.
+struct BrickedVolume::Store {
+    struct Slot {
+        size_t brick;
+        bool dirty;
+        std::unique_ptr<unsigned char[]> data;
+    };
+
+    std::mutex mutex;
+    std::filesystem::path path;
+    std::fstream file;
+    size_t brickBytes;
+    size_t capacity;
+    std::list<Slot> slots; ///< Most recently used first
+    std::unordered_map<size_t, std::list<Slot>::iterator> resident;
+    std::vector<bool> onDisk; ///< Whether each brick has been written to the spill file
+    CacheStatistics statistics;
+
+    Store(std::filesystem::path spillPath, size_t brickBytes, size_t capacity, size_t brickCount)
+            : path(std::move(spillPath)), brickBytes(brickBytes), capacity(std::max<size_t>(1, capacity)),
+              onDisk(brickCount, false) {
+        file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Failed to create brick spill file: " + path.string());
+        }
+    }
+
+    ~Store() {
+        file.close();
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+    }
+
+    void writeBrick(const Slot& slot) {
+        file.seekp(static_cast<std::streamoff>(slot.brick * brickBytes));
+        file.write(reinterpret_cast<const char*>(slot.data.get()), static_cast<std::streamsize>(brickBytes));
+        if (!file) {
+            throw std::runtime_error("Failed to write brick spill file: " + path.string());
+        }
+        onDisk[slot.brick] = true;
+        statistics.spills++;
+    }
+
+    // Returns the cached data of a brick, loading it (and evicting the oldest brick) if needed.
+    // The caller must hold the mutex; the pointer is valid until the next call.
+    unsigned char* acquire(size_t brick, bool forWriting) {
+        auto found = resident.find(brick);
+        if (found != resident.end()) {
+            statistics.hits++;
+            slots.splice(slots.begin(), slots, found->second);
+            slots.front().dirty |= forWriting;
+            return slots.front().data.get();
+        }
+
+        statistics.misses++;
+        std::unique_ptr<unsigned char[]> data;
+        if (slots.size() >= capacity) {
+            Slot& oldest = slots.back();
+            if (oldest.dirty) {
+                writeBrick(oldest);
+            }
+            data = std::move(oldest.data);
+            resident.erase(oldest.brick);
+            slots.pop_back();
+            statistics.evictions++;
+        } else {
+            data.reset(new unsigned char[brickBytes]);
+        }
+
+        if (onDisk[brick]) {
+            file.seekg(static_cast<std::streamoff>(brick * brickBytes));
+            file.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(brickBytes));
+            if (!file) {
+                throw std::runtime_error("Failed to read brick spill file: " + path.string());
+            }
+        } else {
+            std::memset(data.get(), 0, brickBytes);
+        }
+
+        slots.push_front(Slot{brick, forWriting, std::move(data)});
+        resident[brick] = slots.begin();
+        return slots.front().data.get();
+    }
+};
+
+BrickedVolume::BrickedVolume(int width, int height, int depth, int channels, size_t cacheBytes, int brickSide,
+                             const std::string& spillDirectory)
+        : width(width), height(height), depth(depth), channels(channels), brickSide(brickSide),
+          cacheBytes(cacheBytes), spillDirectory(spillDirectory) {
+    if (width <= 0 || height <= 0 || depth <= 0 || channels <= 0 || brickSide <= 0) {
+        throw std::invalid_argument("Bricked volume dimensions and brick side must be positive");
+    }
+    size_t bricksX = (width + brickSide - 1) / brickSide;
+    size_t bricksY = (height + brickSide - 1) / brickSide;
+    size_t bricksZ = (depth + brickSide - 1) / brickSide;
+    size_t brickBytes = static_cast<size_t>(brickSide) * brickSide * brickSide * channels;
+    store = std::make_unique<Store>(uniqueSpillPath(spillDirectory), brickBytes, cacheBytes / brickBytes,
+                                    bricksX * bricksY * bricksZ);
+}
+
+BrickedVolume::BrickedVolume(BrickedVolume&& other) noexcept = default;
+
+BrickedVolume& BrickedVolume::operator=(BrickedVolume&& other) noexcept = default;
+
+BrickedVolume::~BrickedVolume() = default;
+
+BrickedVolume BrickedVolume::fromVolume(const Volume& volume, size_t cacheBytes, int brickSide,
+                                        const std::string& spillDirectory) {
+    BrickedVolume bricked(volume.getWidth(), volume.getHeight(), volume.getDepth(), volume.getChannels(),
+                          cacheBytes, brickSide, spillDirectory);
+    bricked.writeRegion(0, 0, 0, volume.getWidth(), volume.getHeight(), volume.getDepth(), volume.getVolumeData());
+    return bricked;
+}
+
+Volume BrickedVolume::toVolume() const {
+    Volume volume(width, height, depth, channels);
+    readRegion(0, 0, 0, width, height, depth, volume.getVolumeData());
+    return volume;
+}
+
+Image BrickedVolume::getSlice(int z) const {
+    if (z < 0 || z >= depth) {
+        throw std::out_of_range("Slice index is out of range.");
+    }
+    Image slice(width, height, channels);
+    readRegion(0, 0, z, width, height, 1, slice.getData());
+    return slice;
+}
+
+void BrickedVolume::readRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                               unsigned char* destination) const {
+    copyRegion(x0, y0, z0, regionWidth, regionHeight, regionDepth, destination, false);
+}
+
+void BrickedVolume::writeRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                                const unsigned char* source) {
+    // copyRegion only reads the buffer when copying into the bricks
+    copyRegion(x0, y0, z0, regionWidth, regionHeight, regionDepth, const_cast<unsigned char*>(source), true);
+}
+
+void BrickedVolume::copyRegion(int x0, int y0, int z0, int regionWidth, int regionHeight, int regionDepth,
+                               unsigned char* buffer, bool toBricks) const {
+    if (regionWidth <= 0 || regionHeight <= 0 || regionDepth <= 0 || x0 < 0 || y0 < 0 || z0 < 0
+        || x0 + regionWidth > width || y0 + regionHeight > height || z0 + regionDepth > depth) {
+        throw std::out_of_range("Region is empty or outside the bricked volume.");
+    }
+
+    size_t bricksX = (width + brickSide - 1) / brickSide;
+    size_t bricksY = (height + brickSide - 1) / brickSide;
+    size_t side = brickSide;
+    size_t regionRow = static_cast<size_t>(regionWidth) * channels;
+    size_t regionSlice = regionRow * regionHeight;
+
+    std::lock_guard<std::mutex> lock(store->mutex);
+    for (int bz = z0 / brickSide; bz <= (z0 + regionDepth - 1) / brickSide; ++bz) {
+        for (int by = y0 / brickSide; by <= (y0 + regionHeight - 1) / brickSide; ++by) {
+            for (int bx = x0 / brickSide; bx <= (x0 + regionWidth - 1) / brickSide; ++bx) {
+                unsigned char* brick = store->acquire((bz * bricksY + by) * bricksX + bx, toBricks);
+
+                // Overlap of the region and this brick, in volume coordinates
+                int xBegin = std::max(x0, bx * brickSide), xEnd = std::min(x0 + regionWidth, (bx + 1) * brickSide);
+                int yBegin = std::max(y0, by * brickSide), yEnd = std::min(y0 + regionHeight, (by + 1) * brickSide);
+                int zBegin = std::max(z0, bz * brickSide), zEnd = std::min(z0 + regionDepth, (bz + 1) * brickSide);
+                size_t rowBytes = static_cast<size_t>(xEnd - xBegin) * channels;
+
+                for (int z = zBegin; z < zEnd; ++z) {
+                    for (int y = yBegin; y < yEnd; ++y) {
+                        size_t local = (((z - bz * brickSide) * side + (y - by * brickSide)) * side
+                                        + (xBegin - bx * brickSide)) * channels;
+                        size_t dense = (z - z0) * regionSlice + (y - y0) * regionRow
+                                       + static_cast<size_t>(xBegin - x0) * channels;
+                        if (toBricks) {
+                            std::memcpy(brick + local, buffer + dense, rowBytes);
+                        } else {
+                            std::memcpy(buffer + dense, brick + local, rowBytes);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void BrickedVolume::transformWithHalo(int halo, const std::function<void(Volume&)>& filter) {
+    BrickedVolume output(width, height, depth, channels, cacheBytes, brickSide, spillDirectory);
+
+    std::vector<unsigned char> interior;
+    for (int z0 = 0; z0 < depth; z0 += brickSide) {
+        for (int y0 = 0; y0 < height; y0 += brickSide) {
+            for (int x0 = 0; x0 < width; x0 += brickSide) {
+                int x1 = std::min(x0 + brickSide, width);
+                int y1 = std::min(y0 + brickSide, height);
+                int z1 = std::min(z0 + brickSide, depth);
+
+                // Brick plus halo, clipped to the volume so the filter clamps at the true border
+                int rx0 = std::max(0, x0 - halo), rx1 = std::min(width, x1 + halo);
+                int ry0 = std::max(0, y0 - halo), ry1 = std::min(height, y1 + halo);
+                int rz0 = std::max(0, z0 - halo), rz1 = std::min(depth, z1 + halo);
+                Volume region(rx1 - rx0, ry1 - ry0, rz1 - rz0, channels);
+                readRegion(rx0, ry0, rz0, rx1 - rx0, ry1 - ry0, rz1 - rz0, region.getVolumeData());
+
+                filter(region);
+
+                // Keep only the brick's own voxels; the halo was there to feed the filter
+                size_t rowBytes = static_cast<size_t>(x1 - x0) * channels;
+                size_t regionRow = static_cast<size_t>(rx1 - rx0) * channels;
+                size_t regionSlice = regionRow * (ry1 - ry0);
+                interior.resize(rowBytes * (y1 - y0) * (z1 - z0));
+                const unsigned char* filtered = region.getVolumeData();
+                for (int z = z0; z < z1; ++z) {
+                    for (int y = y0; y < y1; ++y) {
+                        std::memcpy(interior.data() + ((z - z0) * static_cast<size_t>(y1 - y0) + (y - y0)) * rowBytes,
+                                    filtered + (z - rz0) * regionSlice + (y - ry0) * regionRow
+                                    + static_cast<size_t>(x0 - rx0) * channels,
+                                    rowBytes);
+                    }
+                }
+                output.writeRegion(x0, y0, z0, x1 - x0, y1 - y0, z1 - z0, interior.data());
+            }
+        }
+    }
+
+    *this = std::move(output);
+}
+
+void BrickedVolume::flush() {
+    std::lock_guard<std::mutex> lock(store->mutex);
+    for (auto& slot : store->slots) {
+        if (slot.dirty) {
+            store->writeBrick(slot);
+            slot.dirty = false;
+        }
+    }
+    store->file.flush();
+}
+
+BrickedVolume::CacheStatistics BrickedVolume::getCacheStatistics() const {
+    std::lock_guard<std::mutex> lock(store->mutex);
+    CacheStatistics statistics = store->statistics;
+    statistics.residentBricks = store->slots.size();
+    return statistics;
+}
+
+int BrickedVolume::getWidth() const {
+    return width;
+}
+
+int BrickedVolume::getHeight() const {
+    return height;
+}
+
+int BrickedVolume::getDepth() const {
+    return depth;
+}
+
+int BrickedVolume::getChannels() const {
+    return channels;
+}
+
+int BrickedVolume::getBrickSide() const {
+    return brickSide;
+}
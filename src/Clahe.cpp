@@ -0,0 +1,282 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Clahe.h"
+#include "Histogram.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Interpolation weights are in 1/256ths
+constexpr uint32_t weightOne = 256;
+
+// Brightness values converted per block when counting a colour tile
+constexpr size_t brightnessBlock = size_t(1) << 16;
+
+// For every position along one axis, the two tiles whose centres surround it and the weight of the second
+struct AxisBlend {
+    std::vector<int> first;
+    std::vector<int> second;
+    std::vector<uint32_t> weight;
+};
+
+// First position of tile t when size positions are split into `tiles` nearly equal parts
+int tileStart(int t, int size, int tiles) {
+    return static_cast<int>(static_cast<int64_t>(t) * size / tiles);
+}
+
+AxisBlend axisBlend(int size, int tiles) {
+    AxisBlend blend;
+    blend.first.resize(size);
+    blend.second.resize(size);
+    blend.weight.resize(size);
+    double tileSize = static_cast<double>(size) / tiles;
+    for (int i = 0; i < size; ++i) {
+        // Position in units of tiles, measured from the centre of tile 0
+        double position = (i + 0.5) / tileSize - 0.5;
+        int tile = static_cast<int>(std::floor(position));
+        double fraction = position - tile;
+        // Beyond the outermost centres the nearest table is used alone
+        if (tile < 0) {
+            tile = 0;
+            fraction = 0.0;
+        } else if (tile >= tiles - 1) {
+            tile = tiles - 1;
+            fraction = 0.0;
+        }
+        blend.first[i] = tile;
+        blend.second[i] = std::min(tile + 1, tiles - 1);
+        blend.weight[i] = static_cast<uint32_t>(std::lround(fraction * weightOne));
+    }
+    return blend;
+}
+
+void checkParameters(double clipLimit, int tilesX, int tilesY, int tilesZ) {
+    if (tilesX < 1 || tilesY < 1 || tilesZ < 1) {
+        throw std::invalid_argument("CLAHE needs at least one tile along each axis.");
+    }
+    if (!(clipLimit > 0)) {
+        throw std::invalid_argument("Clip limit must be positive.");
+    }
+}
+
+// Remaps `width` values, `stride` bytes apart, through the row tables blended for this row. Row tables hold
+// 256 times the output (wy-weighted sums of two tables), so after blending along x the result is
+// (sum + half) >> 16. Positions between the same two tile centres form runs that share both table pointers
+void remapRow(const unsigned char* src, unsigned char* dst, int stride, int width, const uint32_t* rowTables,
+              const AxisBlend& blendX) {
+    // Byte stores may alias anything, so the blend arrays are read through local pointers
+    const int* firstTiles = blendX.first.data();
+    const int* secondTiles = blendX.second.data();
+    const uint32_t* weights = blendX.weight.data();
+    int x = 0;
+    while (x < width) {
+        int first = firstTiles[x];
+        int second = secondTiles[x];
+        const uint32_t* left = rowTables + first * 256;
+        const uint32_t* right = rowTables + second * 256;
+        int end = x + 1;
+        while (end < width && firstTiles[end] == first && secondTiles[end] == second) {
+            ++end;
+        }
+        for (; x < end; ++x) {
+            unsigned char v = src[static_cast<size_t>(x) * stride];
+            uint32_t wx = weights[x];
+            dst[static_cast<size_t>(x) * stride] =
+                    static_cast<unsigned char>(((weightOne - wx) * left[v] + wx * right[v] + (1u << 15)) >> 16);
+        }
+    }
+}
+
+// Blends two rows of tables: out[t][v] = (256 - w) * a[t][v] + w * b[t][v]
+template <typename In>
+void blendTables(const In* a, const In* b, uint32_t w, size_t count, uint32_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = (weightOne - w) * a[i] + w * b[i];
+    }
+}
+
+} // namespace
+
+void Clahe::apply(const Image& image, Image& output, double clipLimit, int tilesX, int tilesY, bool isHSV) {
+    checkParameters(clipLimit, tilesX, tilesY, 1);
+    int channels = image.getChannels();
+    if (channels != 1 && channels != 3 && channels != 4) {
+        throw std::invalid_argument("CLAHE requires an image with 1, 3 or 4 channels.");
+    }
+    if (&image == &output) {
+        Image result;
+        apply(image, result, clipLimit, tilesX, tilesY, isHSV);
+        output = std::move(result);
+        return;
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    bool colour = channels >= 3;
+    int outChannels = colour ? 3 : 1;
+    output.resize(width, height, outChannels);
+    if (width == 0 || height == 0) {
+        return;
+    }
+    tilesX = std::min(tilesX, width);
+    tilesY = std::min(tilesY, height);
+    const unsigned char* src = image.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // Clipped equalisation table of every tile, tiles in parallel. Colour tiles are converted to V or L a block
+    // of rows at a time, and each block is counted in one call
+    std::vector<unsigned char> tables(static_cast<size_t>(tilesX) * tilesY * 256);
+    Parallel::forRange(0, tilesX * tilesY, [&](int tileBegin, int tileEnd) {
+        std::vector<unsigned char> brightness(colour ? std::max<size_t>(width, brightnessBlock) : 0);
+        for (int tile = tileBegin; tile < tileEnd; ++tile) {
+            int tx = tile % tilesX, ty = tile / tilesX;
+            int x0 = tileStart(tx, width, tilesX), x1 = tileStart(tx + 1, width, tilesX);
+            int y0 = tileStart(ty, height, tilesY), y1 = tileStart(ty + 1, height, tilesY);
+            size_t tileWidth = x1 - x0;
+            const unsigned char* corner = src + y0 * rowStride + static_cast<size_t>(x0) * channels;
+            Histogram::Counts counts{};
+            if (!colour) {
+                Histogram::accumulate(corner, 1, tileWidth, y1 - y0, rowStride, counts);
+            } else {
+                int blockRows = static_cast<int>(brightness.size() / tileWidth);
+                for (int y = y0; y < y1; y += blockRows) {
+                    int rows = std::min(blockRows, y1 - y);
+                    for (int r = 0; r < rows; ++r) {
+                        const unsigned char* row = corner + (y - y0 + r) * rowStride;
+                        if (isHSV) {
+                            PixelKernels::rgbToValue(row, channels, brightness.data() + r * tileWidth, tileWidth);
+                        } else {
+                            PixelKernels::rgbToLightness(row, channels, brightness.data() + r * tileWidth, tileWidth);
+                        }
+                    }
+                    Histogram::accumulate(brightness.data(), 1, tileWidth * rows, counts);
+                }
+            }
+            Histogram::Table table = Histogram::clippedEqualisationTable(counts, clipLimit);
+            std::copy(table.begin(), table.end(), tables.begin() + static_cast<size_t>(tile) * 256);
+        }
+    }, 1);
+
+    // Remap each row through the bilinear blend of its four surrounding tables
+    AxisBlend blendX = axisBlend(width, tilesX);
+    AxisBlend blendY = axisBlend(height, tilesY);
+    unsigned char* dst = output.getData();
+    size_t outStride = static_cast<size_t>(width) * outChannels;
+    size_t tableRow = static_cast<size_t>(tilesX) * 256;
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<uint32_t> rowTables(tableRow);
+        std::vector<unsigned char> converted(colour ? outStride : 0);
+        for (int y = yBegin; y < yEnd; ++y) {
+            blendTables(tables.data() + blendY.first[y] * tableRow, tables.data() + blendY.second[y] * tableRow,
+                        blendY.weight[y], tableRow, rowTables.data());
+            unsigned char* out = dst + y * outStride;
+            if (!colour) {
+                remapRow(src + y * rowStride, out, 1, width, rowTables.data(), blendX);
+                continue;
+            }
+            if (isHSV) {
+                PixelKernels::rgbToHsv(src + y * rowStride, channels, converted.data(), width);
+            } else {
+                PixelKernels::rgbToHsl(src + y * rowStride, channels, converted.data(), width);
+            }
+            remapRow(converted.data() + 2, converted.data() + 2, 3, width, rowTables.data(), blendX);
+            if (isHSV) {
+                PixelKernels::hsvToRgb(converted.data(), 3, out, width);
+            } else {
+                PixelKernels::hslToRgb(converted.data(), 3, out, width);
+            }
+        }
+    });
+}
+
+void Clahe::apply(Volume& volume, double clipLimit, int tilesX, int tilesY, int tilesZ) {
+    checkParameters(clipLimit, tilesX, tilesY, tilesZ);
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+    if (width == 0 || height == 0 || depth == 0 || channels == 0) {
+        return;
+    }
+    tilesX = std::min(tilesX, width);
+    tilesY = std::min(tilesY, height);
+    tilesZ = std::min(tilesZ, depth);
+    VolumeView<unsigned char> voxels = volume.view();
+    size_t bricks = static_cast<size_t>(tilesX) * tilesY * tilesZ;
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // tables[(channel * bricks + brick) * 256 + v], bricks numbered x fastest, then y, then z
+    std::vector<unsigned char> tables(channels * bricks * 256);
+    Parallel::forRange(0, static_cast<int>(bricks), [&](int brickBegin, int brickEnd) {
+        std::vector<Histogram::Counts> counts(channels);
+        for (int brick = brickBegin; brick < brickEnd; ++brick) {
+            int tx = brick % tilesX, ty = (brick / tilesX) % tilesY, tz = brick / (tilesX * tilesY);
+            int x0 = tileStart(tx, width, tilesX), x1 = tileStart(tx + 1, width, tilesX);
+            int y0 = tileStart(ty, height, tilesY), y1 = tileStart(ty + 1, height, tilesY);
+            int z0 = tileStart(tz, depth, tilesZ), z1 = tileStart(tz + 1, depth, tilesZ);
+            std::fill(counts.begin(), counts.end(), Histogram::Counts{});
+            for (int z = z0; z < z1; ++z) {
+                const unsigned char* corner = voxels.row(y0, z) + static_cast<size_t>(x0) * channels;
+                for (int c = 0; c < channels; ++c) {
+                    Histogram::accumulate(corner + c, channels, x1 - x0, y1 - y0, rowStride, counts[c]);
+                }
+            }
+            for (int c = 0; c < channels; ++c) {
+                Histogram::Table table = Histogram::clippedEqualisationTable(counts[c], clipLimit);
+                std::copy(table.begin(), table.end(), tables.begin() + (c * bricks + brick) * 256);
+            }
+        }
+    }, 1);
+
+    // Every voxel depends only on its own value and the tables, so the volume is remapped in place. Per slice
+    // the two brick layers are blended once (values up to 255 * 256). Volume rows are usually shorter than a
+    // row of tables, so each voxel then blends the four surrounding bricks of the layer itself (up to
+    // 255 * 256^3, which still fits in 32 bits)
+    AxisBlend blendX = axisBlend(width, tilesX);
+    AxisBlend blendY = axisBlend(height, tilesY);
+    AxisBlend blendZ = axisBlend(depth, tilesZ);
+    size_t tableRow = static_cast<size_t>(tilesX) * 256;
+    size_t tableLayer = tableRow * tilesY;
+    Parallel::forRange(0, depth, [&](int zBegin, int zEnd) {
+        std::vector<uint32_t> layerTables(tableLayer);
+        for (int z = zBegin; z < zEnd; ++z) {
+            for (int c = 0; c < channels; ++c) {
+                const unsigned char* channelTables = tables.data() + c * bricks * 256;
+                blendTables(channelTables + blendZ.first[z] * tableLayer, channelTables + blendZ.second[z] * tableLayer,
+                            blendZ.weight[z], tableLayer, layerTables.data());
+                for (int y = 0; y < height; ++y) {
+                    const uint32_t* top = layerTables.data() + blendY.first[y] * tableRow;
+                    const uint32_t* bottom = layerTables.data() + blendY.second[y] * tableRow;
+                    uint32_t wy = blendY.weight[y];
+                    unsigned char* row = voxels.row(y, z) + c;
+                    for (int x = 0; x < width; ++x) {
+                        unsigned char& voxel = row[static_cast<size_t>(x) * channels];
+                        size_t left = blendX.first[x] * 256 + voxel;
+                        size_t right = blendX.second[x] * 256 + voxel;
+                        uint32_t wx = blendX.weight[x];
+                        uint32_t upper = (weightOne - wx) * top[left] + wx * top[right];
+                        uint32_t lower = (weightOne - wx) * bottom[left] + wx * bottom[right];
+                        voxel = static_cast<unsigned char>(((weightOne - wy) * upper + wy * lower + (1u << 23)) >> 24);
+                    }
+                }
+            }
+        }
+    });
+}
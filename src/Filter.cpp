@@ -13,42 +13,63 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
 #include "Filter.h"
+#include "Clahe.h"
+#include "Gradient.h"
+#include "Histogram.h"
+#include "LutChain.h"
 #include "Projection.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
 
 using namespace std;
 
-// Helper functions to convert Image to vector and vice versa
-std::vector<std::vector<unsigned char>> Filter::ConvertImageToVector(const Image& image) {
-    int width = image.getWidth();
-    int height = image.getHeight();
+namespace {
 
-    std::vector<std::vector<unsigned char>> result(height, std::vector<unsigned char>(width));
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            // Assuming the image is grayscale, so only the first channel is needed
-            unsigned char pixelValue = image.getPixel(x, y, 0);
-            result[y][x] = pixelValue;
-        }
+// Handles `filter(image, image, ...)` for filters that read neighbouring pixels: the result is computed
+// into a fresh image which then replaces the input. Returns false when input and output are distinct.
+template <typename Apply>
+bool replaceAliased(const Image& image, Image& output, Apply&& apply) {
+    if (&image != &output) {
+        return false;
     }
-
-    return result;
+    Image result;
+    apply(result);
+    output = std::move(result);
+    return true;
 }
 
-// Helper function to convert a 2D gradient vector to an Image
-Image Filter::convertGradientToImage(const std::vector<std::vector<unsigned char>>& gradient, int width, int height) {
-    Image resultImage(width, height, 1);
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            resultImage.setPixel(x, y, 0, gradient[y][x]);
+// Sets each pixel to 0 or 255 with the given probability, drawing uniform numbers in [0, 1] from draw()
+template <typename Draw>
+void scatterSaltAndPepper(Image& image, double proportion, bool rgb, Draw&& draw) {
+    int w = image.getWidth();
+    int h = image.getHeight();
+    int c = image.getChannels();
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            if (draw() < proportion) {
+                // Randomly set the pixel to either 0 or 255
+                unsigned char color = draw() < 0.5 ? 0 : 255;
+                if (rgb) {
+                    // Apply noise to all channels
+                    for (int channel = 0; channel < c; ++channel) {
+                        image.setPixel(x, y, channel, color);
+                    }
+                } else {
+                    image.setPixel(x, y, 0, color); // Assuming grayscale affects only the first channel
+                }
+            }
         }
     }
-
-    return resultImage;
 }
 
+} // namespace
+
 // Helper function to generate a Gaussian distribution value
 float Filter::gaussian(float x, float y, float z, float sigma) {
     return std::exp(-(x * x + y * y + z * z) / (2 * sigma * sigma)) / (2 * M_PI * sigma * sigma);
@@ -56,251 +77,666 @@ float Filter::gaussian(float x, float y, float z, float sigma) {
 
 
 // Function to apply a median filter to an image
-Image Filter::medianBlur(Image& image, int kernel_size) {
+Image Filter::medianBlur(const Image& image, int kernel_size) {
+    Image output;
+    medianBlur(image, output, kernel_size);
+    return output;
+}
+
+void Filter::medianBlur(const Image& image, Image& output, int kernel_size) {
+    if (replaceAliased(image, output, [&](Image& result) { medianBlur(image, result, kernel_size); })) {
+        return;
+    }
+
     int width = image.getWidth();
     int height = image.getHeight();
     int channels = image.getChannels();
-    int bufferSize = kernel_size * kernel_size;
 
-    // Create a copy of the image to store the filtered result
-    Image filteredImage = image;
+    // Every output pixel is written below, so the input does not need to be copied first
+    output.resize(width, height, channels);
 
     // Calculate the radius of the kernel
     int radius = kernel_size / 2;
-    // Calculate half size of the kernel area for median index
-    int median_index = (kernel_size * kernel_size) / 2;
+    // The window always spans (2 * radius + 1) pixels per side, which is one more than an even kernel size
+    int windowSide = 2 * radius + 1;
+    int bufferSize = windowSide * windowSide;
 
-    // Vector to hold pixel values from the kernel area
-//    std::vector<unsigned char> window;                             // old
-    auto* window = new unsigned char[kernel_size * kernel_size];     // new
+    PlaneView<const unsigned char> in = image.view();
+    PlaneView<unsigned char> out = output.view();
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            for (int k = 0; k < channels; ++k) {
-//                window.clear();                                    //old
+    // Each band of rows sorts into its own window buffer
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<unsigned char> window(bufferSize);
+        std::vector<const unsigned char*> rows(windowSide);
 
-                // Collect pixel values from the kernel area
-                for (int iy = -radius; iy <= radius; ++iy) {
-                    for (int ix = -radius; ix <= radius; ++ix) {
-                        int readX = std::min(std::max(x + ix, 0), width - 1);
-                        int readY = std::min(std::max(y + iy, 0), height - 1);
-//                        window.push_back(image.getPixel(readX, readY, k));                                        //old
-                        window[(iy + radius) * kernel_size + (ix + radius)] = image.getPixel(readX, readY, k);        //new
+        for (int y = yBegin; y < yEnd; ++y) {
+            // Rows under the kernel, clamped at the top and bottom edges
+            for (int iy = -radius; iy <= radius; ++iy) {
+                rows[iy + radius] = in.row(std::min(std::max(y + iy, 0), height - 1));
+            }
+            for (int x = 0; x < width; ++x) {
+                for (int k = 0; k < channels; ++k) {
+                    // Collect pixel values from the kernel area
+                    for (int iy = 0; iy < windowSide; ++iy) {
+                        for (int ix = -radius; ix <= radius; ++ix) {
+                            int readX = std::min(std::max(x + ix, 0), width - 1);
+                            window[iy * windowSide + (ix + radius)] = rows[iy][static_cast<size_t>(readX) * channels + k];
+                        }
                     }
-                }
 
-                // Sort the pixel values to find the median
-                Projection::quickSort(window, 0, bufferSize - 1);                                                    //new
-//                std::nth_element(window.begin(), window.begin() + median_index, window.end());                     //old
-
-                unsigned char median_value;
-
-//                //Handle even-sized kernel by averaging two middle values
-//                if (kernel_size % 2 == 0) {
-//                    // Find the second median value
-//                    std::nth_element(window.begin(), window.begin() + median_index - 1, window.end());
-//                    // Calculate the average of the two median values
-//                    median_value = (window[median_index] + window[median_index - 1]) / 2;
-//                } else {
-//                    // For an odd-sized kernel, take the median value
-//                    median_value = window[median_index];
-//                }
-                // Check if the number of elements is even or odd
-                if (bufferSize % 2 == 0) {                                                                        //new version
-                    median_value = (window[bufferSize / 2 - 1] + window[bufferSize / 2]) / 2;                    //new version
-                } else {                                                                                          //new version
-                    median_value = window[bufferSize / 2];                                                        //new version
-                }                                                                                                 //new version
-                
-                // Set the median value to the corresponding pixel on the filtered image
-                filteredImage.setPixel(x, y, k, median_value);
+                    // Sort the pixel values to find the median
+                    Projection::quickSort(window.data(), 0, bufferSize - 1);
+
+                    unsigned char median_value;
+                    // Check if the number of elements is even or odd
+                    if (bufferSize % 2 == 0) {
+                        median_value = (window[bufferSize / 2 - 1] + window[bufferSize / 2]) / 2;
+                    } else {
+                        median_value = window[bufferSize / 2];
+                    }
+
+                    // Set the median value to the corresponding pixel on the filtered image
+                    out(x, y, k) = median_value;
+                }
             }
         }
-    }
+    });
+}
 
-    // Copy the filtered data back to the original image
-    return filteredImage;// assuming operator= is properly defined
+Image Filter::histomedianBlur(const Image& image, int kernel_size) {
+    Image output;
+    histomedianBlur(image, output, kernel_size);
+    return output;
 }
 
-Image Filter::histomedianBlur(Image& image, int kernel_size) {
+void Filter::histomedianBlur(const Image& image, Image& output, int kernel_size) {
+    if (replaceAliased(image, output, [&](Image& result) { histomedianBlur(image, result, kernel_size); })) {
+        return;
+    }
+
     int width = image.getWidth();
     int height = image.getHeight();
     int channels = image.getChannels();
 
-    Image filteredImage = image; // Assuming there's a copy constructor
+    output.resize(width, height, channels);
 
     int radius = kernel_size / 2;
-    std::vector<int> histogram(256, 0); // Histogram for counting sort
+    PlaneView<const unsigned char> in = image.view();
+    PlaneView<unsigned char> out = output.view();
 
-    for (int k = 0; k < channels; ++k) {
-        for (int y = 0; y < height; ++y) {
-            histogram.assign(256, 0); // Reset the histogram for each row
+    // Every row builds its own sliding histogram, so rows are split into bands across threads
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<int> histogram(256, 0); // Histogram for counting sort
 
-            // Initialize histogram for the first window in this row
-            for (int iy = -radius; iy <= radius; ++iy) {
-                for (int ix = -radius; ix <= radius; ++ix) {
-                    int readX = std::max(ix, 0);
-                    int readY = std::max(y + iy, 0);
-                    readX = std::min(readX, width - 1);
-                    readY = std::min(readY, height - 1);
-                    unsigned char pixelValue = image.getPixel(readX, readY, k);
-                    histogram[pixelValue]++;
+        for (int k = 0; k < channels; ++k) {
+            for (int y = yBegin; y < yEnd; ++y) {
+                histogram.assign(256, 0); // Reset the histogram for each row
+
+                // Initialize histogram for the first window in this row
+                for (int iy = -radius; iy <= radius; ++iy) {
+                    for (int ix = -radius; ix <= radius; ++ix) {
+                        int readX = std::max(ix, 0);
+                        int readY = std::max(y + iy, 0);
+                        readX = std::min(readX, width - 1);
+                        readY = std::min(readY, height - 1);
+                        unsigned char pixelValue = in(readX, readY, k);
+                        histogram[pixelValue]++;
+                    }
+                }
+
+                // Find the median for the first window
+                int median = Filter::findMedianHist(histogram, kernel_size * kernel_size);
+                out(0, y, k) = median;
+
+                for (int x = 1; x < width; ++x) {
+                    // Subtract pixel counts for the outgoing column
+                    for (int iy = -radius; iy <= radius; ++iy) {
+                        int colOutX = std::max(x - radius - 1, 0);
+                        int colOutY = std::min(std::max(y + iy, 0), height - 1);
+                        unsigned char outgoingPixel = in(colOutX, colOutY, k);
+                        histogram[outgoingPixel]--;
+                    }
+
+                    // Add pixel counts for the incoming column
+                    for (int iy = -radius; iy <= radius; ++iy) {
+                        int colInX = std::min(x + radius, width - 1);
+                        int colInY = std::min(std::max(y + iy, 0), height - 1);
+                        unsigned char incomingPixel = in(colInX, colInY, k);
+                        histogram[incomingPixel]++;
+                    }
+
+                    // Find the median for the current window
+                    median = Filter::findMedianHist(histogram, kernel_size * kernel_size);
+                    out(x, y, k) = median;
                 }
             }
+        }
+    });
+}
 
-            // Find the median for the first window
-            int median = Filter::findMedianHist(histogram, kernel_size * kernel_size);
-            filteredImage.setPixel(0, y, k, median);
+// Helper function to slide a kernel histogram along a row of column histograms and write the medians
+void Filter::medianRowFromColumnHistograms(const uint16_t* columnFine, const uint16_t* columnCoarse, int width,
+                                           int radius, unsigned int medianRank, unsigned char* out, int outStride) {
+    int windowSide = 2 * radius + 1;
+
+    // Kernel histogram: the coarse level is kept current for every x, while each
+    // 16-bin fine segment is only brought up to date when the median falls inside it
+    uint32_t kernelCoarse[16] = {0};
+    uint32_t kernelFine[16][16] = {{0}};
+    int fineUpdatedAt[16];
+    std::fill(std::begin(fineUpdatedAt), std::end(fineUpdatedAt), INT_MIN);
+
+    for (int ix = -radius; ix <= radius; ++ix) {
+        const uint16_t* column = &columnCoarse[std::clamp(ix, 0, width - 1) * 16];
+        for (int b = 0; b < 16; ++b) {
+            kernelCoarse[b] += column[b];
+        }
+    }
 
-            for (int x = 1; x < width; ++x) {
-                // Subtract pixel counts for the outgoing column
-                for (int iy = -radius; iy <= radius; ++iy) {
-                    int colOutX = std::max(x - radius - 1, 0);
-                    int colOutY = std::min(std::max(y + iy, 0), height - 1);
-                    unsigned char outgoingPixel = image.getPixel(colOutX, colOutY, k);
-                    histogram[outgoingPixel]--;
+    for (int x = 0; x < width; ++x) {
+        if (x > 0) {
+            const uint16_t* incoming = &columnCoarse[std::min(x + radius, width - 1) * 16];
+            const uint16_t* outgoing = &columnCoarse[std::max(x - radius - 1, 0) * 16];
+            for (int b = 0; b < 16; ++b) {
+                kernelCoarse[b] += incoming[b];
+                kernelCoarse[b] -= outgoing[b];
+            }
+        }
+
+        // Find the coarse bucket holding the median
+        unsigned int below = 0;
+        int bucket = 0;
+        while (below + kernelCoarse[bucket] <= medianRank) {
+            below += kernelCoarse[bucket];
+            ++bucket;
+        }
+
+        // Bring that bucket's fine segment up to date for this x
+        uint32_t* fine = kernelFine[bucket];
+        int last = fineUpdatedAt[bucket];
+        if (last == INT_MIN || x - last > windowSide) {
+            std::fill(fine, fine + 16, 0);
+            for (int ix = x - radius; ix <= x + radius; ++ix) {
+                const uint16_t* column = &columnFine[std::clamp(ix, 0, width - 1) * 256 + bucket * 16];
+                for (int v = 0; v < 16; ++v) {
+                    fine[v] += column[v];
+                }
+            }
+        } else {
+            for (int step = last + 1; step <= x; ++step) {
+                const uint16_t* incoming = &columnFine[std::min(step + radius, width - 1) * 256 + bucket * 16];
+                const uint16_t* outgoing = &columnFine[std::max(step - radius - 1, 0) * 256 + bucket * 16];
+                for (int v = 0; v < 16; ++v) {
+                    fine[v] += incoming[v];
+                    fine[v] -= outgoing[v];
                 }
+            }
+        }
+        fineUpdatedAt[bucket] = x;
 
-                // Add pixel counts for the incoming column
-                for (int iy = -radius; iy <= radius; ++iy) {
-                    int colInX = std::min(x + radius, width - 1);
-                    int colInY = std::min(std::max(y + iy, 0), height - 1);
-                    unsigned char incomingPixel = image.getPixel(colInX, colInY, k);
-                    histogram[incomingPixel]++;
+        // Walk the fine segment to the median value
+        int value = 0;
+        while (below + fine[value] <= medianRank) {
+            below += fine[value];
+            ++value;
+        }
+        out[x * outStride] = static_cast<unsigned char>(bucket * 16 + value);
+    }
+}
+
+// Function to apply a median filter in constant time per pixel (Perreault and Hebert, 2007)
+Image Filter::constantTimeMedianBlur(const Image& image, int kernel_size) {
+    Image output;
+    constantTimeMedianBlur(image, output, kernel_size);
+    return output;
+}
+
+void Filter::constantTimeMedianBlur(const Image& image, Image& output, int kernel_size) {
+    if (kernel_size < 1) {
+        throw std::invalid_argument("Kernel size must be positive");
+    }
+    // The column histograms count 2r + 1 rows in 16 bits, and the window size must fit in an int
+    if (kernel_size > 255) {
+        throw std::invalid_argument("Kernel size must be at most 255");
+    }
+    if (replaceAliased(image, output, [&](Image& result) { constantTimeMedianBlur(image, result, kernel_size); })) {
+        return;
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    int radius = kernel_size / 2;
+    int windowSide = 2 * radius + 1;
+    // Sorted position of the median in the (2r + 1)^2 window, which always has an odd size
+    unsigned int medianRank = static_cast<unsigned int>(windowSide * windowSide) / 2;
+
+    output.resize(width, height, channels);
+    const unsigned char* src = image.getData();
+    unsigned char* dst = output.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // Each band keeps one histogram per image column, covering the 2r + 1 rows around the current row
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<uint16_t> columnFine(static_cast<size_t>(width) * 256);
+        std::vector<uint16_t> columnCoarse(static_cast<size_t>(width) * 16);
+
+        for (int k = 0; k < channels; ++k) {
+            std::fill(columnFine.begin(), columnFine.end(), 0);
+            std::fill(columnCoarse.begin(), columnCoarse.end(), 0);
+
+            // Adds (+1) or removes (-1) one image row from every column histogram
+            auto updateColumns = [&](int row, int delta) {
+                const unsigned char* srcRow = src + std::clamp(row, 0, height - 1) * rowStride;
+                for (int x = 0; x < width; ++x) {
+                    unsigned char value = srcRow[x * channels + k];
+                    columnFine[x * 256 + value] += delta;
+                    columnCoarse[x * 16 + (value >> 4)] += delta;
+                }
+            };
+
+            for (int iy = yBegin - radius; iy <= yBegin + radius; ++iy) {
+                updateColumns(iy, 1);
+            }
+
+            for (int y = yBegin; y < yEnd; ++y) {
+                if (y > yBegin) {
+                    updateColumns(y - radius - 1, -1);
+                    updateColumns(y + radius, 1);
                 }
 
-                // Find the median for the current window
-                median = Filter::findMedianHist(histogram, kernel_size * kernel_size);
-                filteredImage.setPixel(x, y, k, median);
+                medianRowFromColumnHistograms(columnFine.data(), columnCoarse.data(), width, radius, medianRank,
+                                              dst + y * rowStride + k, channels);
             }
         }
-    }
-    return filteredImage; // Assuming operator= is properly defined
+    });
 }
 
 // Function to apply a box blur to an image
-Image Filter::boxBlur(Image &image, int kernel_size) {
+Image Filter::boxBlur(const Image& image, int kernel_size) {
+    Image output;
+    boxBlur(image, output, kernel_size);
+    return output;
+}
+
+void Filter::boxBlur(const Image& image, Image& output, int kernel_size) {
+    // Large kernels are cheaper with running sums
+    if (kernel_size >= boxBlurRunningSumThreshold) {
+        boxBlurRunningSum(image, output, kernel_size);
+        return;
+    }
+    if (replaceAliased(image, output, [&](Image& result) { boxBlur(image, result, kernel_size); })) {
+        return;
+    }
+
     int width = image.getWidth();
     int height = image.getHeight();
     int channels = image.getChannels();
 
     // Create a temporary image to store the intermediate results
     Image tempImage(width, height, channels);
-    // Create the result image to store the final results
-    Image resultImage(width, height, channels);
+    // Size the output to hold the final results
+    output.resize(width, height, channels);
 
     // Calculate the radius of the kernel
     int radius = kernel_size / 2;
     bool isKernelEven = kernel_size % 2 == 0;
 
-    // Horizontal pass
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            for (int k = 0; k < channels; ++k) {
-                unsigned int sum = 0;
-                int count = 0;
+    // The kernel spans one extra pixel after the centre when its size is even
+    int last = radius + (isKernelEven ? 1 : 0);
+    unsigned int count = radius + last + 1;
+    PlaneView<const unsigned char> in = image.view();
+    PlaneView<unsigned char> temp = tempImage.view();
+    PlaneView<unsigned char> out = output.view();
 
-                for (int ix = -radius; ix <= radius + (isKernelEven ? 1 : 0); ++ix) {
-                    int currentX = std::min(std::max(x + ix, 0), width - 1);
-                    sum += image.getPixel(currentX, y, k);
-                    count++;
+    // Horizontal pass
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* src = in.row(y);
+            unsigned char* dst = temp.row(y);
+            for (int x = 0; x < width; ++x) {
+                for (int k = 0; k < channels; ++k) {
+                    unsigned int sum = 0;
+                    for (int ix = -radius; ix <= last; ++ix) {
+                        int currentX = std::min(std::max(x + ix, 0), width - 1);
+                        sum += src[static_cast<size_t>(currentX) * channels + k];
+                    }
+                    dst[static_cast<size_t>(x) * channels + k] = static_cast<unsigned char>(sum / count);
                 }
-
-                tempImage.setPixel(x, y, k, static_cast<unsigned char>(sum / count));
             }
         }
+    });
+
+    // Vertical pass, started only once every row of tempImage is complete. Whole rows are summed
+    // element by element, which the compiler vectorises.
+    size_t rowLength = static_cast<size_t>(width) * channels;
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<unsigned int> sums(rowLength);
+        for (int y = yBegin; y < yEnd; ++y) {
+            std::fill(sums.begin(), sums.end(), 0);
+            for (int iy = -radius; iy <= last; ++iy) {
+                const unsigned char* src = temp.row(std::min(std::max(y + iy, 0), height - 1));
+                for (size_t i = 0; i < rowLength; ++i) {
+                    sums[i] += src[i];
+                }
+            }
+            unsigned char* dst = out.row(y);
+            for (size_t i = 0; i < rowLength; ++i) {
+                dst[i] = static_cast<unsigned char>(sums[i] / count);
+            }
+        }
+    });
+}
+
+// Function to apply a box blur to an image in constant time per pixel
+Image Filter::boxBlurRunningSum(const Image& image, int kernel_size) {
+    Image output;
+    boxBlurRunningSum(image, output, kernel_size);
+    return output;
+}
+
+void Filter::boxBlurRunningSum(const Image& image, Image& output, int kernel_size) {
+    if (replaceAliased(image, output, [&](Image& result) { boxBlurRunningSum(image, result, kernel_size); })) {
+        return;
     }
 
-    // Vertical pass
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+
+    Image tempImage(width, height, channels);
+    output.resize(width, height, channels);
+
+    // The window covers [i - radius, i + radius + extra], matching boxBlur for odd and even kernels
+    int radius = kernel_size / 2;
+    int extra = kernel_size % 2 == 0 ? 1 : 0;
+    unsigned int count = 2 * radius + 1 + extra;
+
+    const unsigned char* src = image.getData();
+    unsigned char* temp = tempImage.getData();
+    unsigned char* dst = output.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // Horizontal pass: one running sum per row and channel
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* srcRow = src + y * rowStride;
+            unsigned char* tempRow = temp + y * rowStride;
+
             for (int k = 0; k < channels; ++k) {
                 unsigned int sum = 0;
-                int count = 0;
+                for (int ix = -radius; ix <= radius + extra; ++ix) {
+                    sum += srcRow[std::clamp(ix, 0, width - 1) * channels + k];
+                }
+                tempRow[k] = static_cast<unsigned char>(sum / count);
+
+                for (int x = 1; x < width; ++x) {
+                    int inX = std::min(x + radius + extra, width - 1);
+                    int outX = std::max(x - radius - 1, 0);
+                    sum += srcRow[inX * channels + k];
+                    sum -= srcRow[outX * channels + k];
+                    tempRow[x * channels + k] = static_cast<unsigned char>(sum / count);
+                }
+            }
+        }
+    });
+
+    // Vertical pass: each band keeps one running sum per column and channel
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<unsigned int> sums(rowStride, 0);
+        for (int iy = yBegin - radius; iy <= yBegin + radius + extra; ++iy) {
+            const unsigned char* tempRow = temp + std::clamp(iy, 0, height - 1) * rowStride;
+            for (size_t i = 0; i < rowStride; ++i) {
+                sums[i] += tempRow[i];
+            }
+        }
 
-                for (int iy = -radius; iy <= radius + (isKernelEven ? 1 : 0); ++iy) {
-                    int currentY = std::min(std::max(y + iy, 0), height - 1);
-                    sum += tempImage.getPixel(x, currentY, k);
-                    count++;
+        for (int y = yBegin; y < yEnd; ++y) {
+            if (y > yBegin) {
+                const unsigned char* inRow = temp + std::min(y + radius + extra, height - 1) * rowStride;
+                const unsigned char* outRow = temp + std::max(y - radius - 1, 0) * rowStride;
+                for (size_t i = 0; i < rowStride; ++i) {
+                    sums[i] += inRow[i];
+                    sums[i] -= outRow[i];
                 }
+            }
 
-                // The result should be stored in resultImage, not the original image
-                resultImage.setPixel(x, y, k, static_cast<unsigned char>(sum / count));
+            unsigned char* dstRow = dst + y * rowStride;
+            for (size_t i = 0; i < rowStride; ++i) {
+                dstRow[i] = static_cast<unsigned char>(sums[i] / count);
             }
         }
+    });
+}
+
+// Function to get a cached, normalised 1D Gaussian kernel
+const std::vector<float>& Filter::gaussianKernel1D(int kernelSize, float sigma) {
+    static std::map<std::pair<int, float>, std::vector<float>> cache;
+    static std::mutex cacheMutex;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto found = cache.find({kernelSize, sigma});
+    if (found != cache.end()) {
+        return found->second;
     }
 
-    // Return the result image containing the blurred image data
-    return resultImage;
+    int radius = kernelSize / 2;
+    std::vector<float> kernel(kernelSize);
+    float sum = 0.0f;
+    for (int i = 0; i < kernelSize; ++i) {
+        int x = i - radius;
+        kernel[i] = std::exp(-(x * x) / (2.0f * sigma * sigma));
+        sum += kernel[i];
+    }
+
+    // Normalize the kernel
+    for (float &value : kernel) {
+        value /= sum;
+    }
+
+    // std::map never moves its elements, so the reference stays valid after later insertions
+    return cache.emplace(std::make_pair(kernelSize, sigma), std::move(kernel)).first->second;
 }
 
 // Function to apply Gaussian blur to an image
-Image Filter::gaussianBlur(Image& image, int kernelSize, float sigma) {
-        if (kernelSize % 2 == 0) {
-            throw std::invalid_argument("Kernel size must be odd");
-        }
+Image Filter::gaussianBlur(const Image& image, int kernelSize, float sigma, bool allowApproximation) {
+    Image output;
+    gaussianBlur(image, output, kernelSize, sigma, allowApproximation);
+    return output;
+}
 
-        int width = image.getWidth();
-        int height = image.getHeight();
-        int channels = image.getChannels();
-        int radius = kernelSize / 2;
-        std::vector<float> kernel(kernelSize * kernelSize);
-        float sum = 0.0f; // For normalizing the kernel
-        
-        Image resultImage(width, height, channels);
-        // Create Gaussian kernel
-        for (int i = 0; i < kernelSize; ++i) {
-            for (int j = 0; j < kernelSize; ++j) {
-                int x = i - radius;
-                int y = j - radius;
-                float exponent = -(x * x + y * y) / (2.0f * sigma * sigma);
-                kernel[i * kernelSize + j] = std::exp(exponent) / (2.0f * M_PI * sigma * sigma);
-                sum += kernel[i * kernelSize + j];
-            }
-        }
+void Filter::gaussianBlur(const Image& image, Image& output, int kernelSize, float sigma, bool allowApproximation) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd");
+    }
 
-        // Normalize the kernel
-        for (float &value : kernel) {
-            value /= sum;
-        }
+    // A kernel reaching about three sigma either side is well approximated by the recursive filter
+    if (allowApproximation && sigma >= recursiveGaussianSigmaThreshold && kernelSize >= 6 * sigma) {
+        gaussianBlurRecursive(image, output, sigma);
+        return;
+    }
 
-        // Apply Gaussian blur
-        Image tempImage(width, height, channels); // Create a temporary image for the output
-        for (int y = 0; y < height; ++y) {
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    int radius = kernelSize / 2;
+    const std::vector<float>& kernel = gaussianKernel1D(kernelSize, sigma);
+
+    const unsigned char* src = image.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // Horizontal pass into a float buffer so no precision is lost between the passes
+    std::vector<float> horizontal(rowStride * height);
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* srcRow = src + y * rowStride;
+            float* outRow = horizontal.data() + y * rowStride;
             for (int x = 0; x < width; ++x) {
                 for (int c = 0; c < channels; ++c) {
                     float blurredPixel = 0.0f;
-
-                    for (int ky = -radius; ky <= radius; ++ky) {
-                        for (int kx = -radius; kx <= radius; ++kx) {
-                            int pixelPosX = std::clamp(x + kx, 0, width - 1);
-                            int pixelPosY = std::clamp(y + ky, 0, height - 1);
-                            blurredPixel += image.getPixel(pixelPosX, pixelPosY, c) * kernel[(ky + radius) * kernelSize + (kx + radius)];
-                        }
+                    for (int kx = -radius; kx <= radius; ++kx) {
+                        int pixelPosX = std::clamp(x + kx, 0, width - 1);
+                        blurredPixel += srcRow[pixelPosX * channels + c] * kernel[kx + radius];
                     }
-
-                    tempImage.setPixel(x, y, c, static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, blurredPixel))));
+                    outRow[x * channels + c] = blurredPixel;
                 }
             }
         }
-
-        // Copy the blurred tempImage data back to the original image
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                for (int c = 0; c < channels; ++c) {
-                    resultImage.setPixel(x, y, c, tempImage.getPixel(x, y, c));
+    });
+
+    // The source is fully consumed, so the output may now reuse its buffer even when applied in place
+    output.resize(width, height, channels);
+    unsigned char* dst = output.getData();
+
+    // Vertical pass, accumulating whole rows at a time
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<float> accumulator(rowStride);
+        for (int y = yBegin; y < yEnd; ++y) {
+            std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+            for (int ky = -radius; ky <= radius; ++ky) {
+                int pixelPosY = std::clamp(y + ky, 0, height - 1);
+                const float* inRow = horizontal.data() + pixelPosY * rowStride;
+                float weight = kernel[ky + radius];
+                for (size_t i = 0; i < rowStride; ++i) {
+                    accumulator[i] += inRow[i] * weight;
                 }
             }
+
+            unsigned char* dstRow = dst + y * rowStride;
+            for (size_t i = 0; i < rowStride; ++i) {
+                dstRow[i] = static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, accumulator[i])));
+            }
         }
-       return resultImage;
+    });
+}
+
+// Function to apply an approximate Gaussian blur with a recursive filter
+Image Filter::gaussianBlurRecursive(const Image& image, float sigma) {
+    Image output;
+    gaussianBlurRecursive(image, output, sigma);
+    return output;
+}
+
+void Filter::gaussianBlurRecursive(const Image& image, Image& output, float sigma) {
+    if (sigma < 0.5f) {
+        throw std::invalid_argument("Sigma must be at least 0.5 for the recursive Gaussian");
     }
 
+    // Young and van Vliet (1995) coefficients
+    double q = sigma >= 2.5 ? 0.98711 * sigma - 0.96330
+                            : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+    double q2 = q * q;
+    double q3 = q2 * q;
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    auto b1 = static_cast<float>((2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0);
+    auto b2 = static_cast<float>(-(1.4281 * q2 + 1.26661 * q3) / b0);
+    auto b3 = static_cast<float>(0.422205 * q3 / b0);
+    float B = 1.0f - (b1 + b2 + b3);
+
+    // Samples past the right edge over which the causal response is run out before the
+    // anti-causal pass starts, so the repeated border is honoured on both sides
+    int tail = static_cast<int>(std::ceil(10.0f * sigma));
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    const unsigned char* src = image.getData();
+    std::vector<float> buffer(src, src + rowStride * height);
+
+    // Filters `lanes` interleaved lines of n samples in place; sample j of lane i is at base[j * step + i].
+    // Running several lanes together lets the column pass walk memory row by row.
+    auto filterLanes = [&](float* base, int n, size_t step, size_t lanes) {
+        std::vector<float> w1(lanes), w2(lanes), w3(lanes), last(lanes);
+        std::vector<float> tailResponse(static_cast<size_t>(tail) * lanes);
+
+        // Causal pass, primed with the first sample (the steady state of a repeated border)
+        for (size_t i = 0; i < lanes; ++i) {
+            w1[i] = w2[i] = w3[i] = base[i];
+            last[i] = base[(n - 1) * step + i];
+        }
+        for (int j = 0; j < n; ++j) {
+            float* sample = base + j * step;
+            for (size_t i = 0; i < lanes; ++i) {
+                float w = B * sample[i] + b1 * w1[i] + b2 * w2[i] + b3 * w3[i];
+                sample[i] = w;
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+        for (int t = 0; t < tail; ++t) {
+            for (size_t i = 0; i < lanes; ++i) {
+                float w = B * last[i] + b1 * w1[i] + b2 * w2[i] + b3 * w3[i];
+                tailResponse[t * lanes + i] = w;
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+
+        // Anti-causal pass, starting from the far end of the extended border
+        for (size_t i = 0; i < lanes; ++i) {
+            w1[i] = w2[i] = w3[i] = last[i];
+        }
+        for (int t = tail - 1; t >= 0; --t) {
+            for (size_t i = 0; i < lanes; ++i) {
+                float w = B * tailResponse[t * lanes + i] + b1 * w1[i] + b2 * w2[i] + b3 * w3[i];
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+        for (int j = n - 1; j >= 0; --j) {
+            float* sample = base + j * step;
+            for (size_t i = 0; i < lanes; ++i) {
+                float w = B * sample[i] + b1 * w1[i] + b2 * w2[i] + b3 * w3[i];
+                sample[i] = w;
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+    };
+
+    // Rows, with the channels of a row as interleaved lanes
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            filterLanes(buffer.data() + y * rowStride, width, channels, channels);
+        }
+    });
+
+    // Columns, split into bands of x so each thread owns whole columns
+    Parallel::forRange(0, width, [&](int xBegin, int xEnd) {
+        size_t bandOffset = static_cast<size_t>(xBegin) * channels;
+        size_t bandWidth = static_cast<size_t>(xEnd - xBegin) * channels;
+        filterLanes(buffer.data() + bandOffset, height, rowStride, bandWidth);
+    });
+
+    // The whole image lives in the float buffer, so the output may reuse the input's bytes
+    output.resize(width, height, channels);
+    unsigned char* dst = output.getData();
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        dst[i] = static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, buffer[i])));
+    }
+}
+
 // Function to convert RGB images to grayscale
-Image Filter::grayScale(Image &inputImg) {
+Image Filter::grayScale(const Image &inputImg) {
+    Image output;
+    grayScale(inputImg, output);
+    return output;
+}
+
+void Filter::grayScale(const Image &inputImg, Image &outputImg) {
     // Check if the image is already grayscale
     if (inputImg.getChannels() == 1)
     {
-        return inputImg;
+        if (&inputImg != &outputImg) {
+            outputImg = inputImg;
+        }
+        return;
     }
 
     // Check if the image has 1, 3, or 4 channels
@@ -311,39 +747,39 @@ Image Filter::grayScale(Image &inputImg) {
 
     int width = inputImg.getWidth();
     int height = inputImg.getHeight();
+    int channels = inputImg.getChannels();
 
-    // Create a new Image object to store the grayscale image
-    Image outputImg = Image(width, height, 1);
-
-    // For each pixel in the image, calculate the grayscale value
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
-        {
-            unsigned char r = inputImg.getPixel(x, y, 0);
-            unsigned char g = inputImg.getPixel(x, y, 1);
-            unsigned char b = inputImg.getPixel(x, y, 2);
+    if (replaceAliased(inputImg, outputImg, [&](Image& result) { grayScale(inputImg, result); })) {
+        return;
+    }
 
-            auto gray = static_cast<unsigned char>(0.2126 * r + 0.7152 * g + 0.0722 * b);
+    // Size the output image to store the grayscale image
+    outputImg.resize(width, height, 1);
 
-            // Set grayscale value for the pixel
-            outputImg.setPixel(x, y, 0, gray);
-        }
-    }
-    return outputImg;
+    // For each pixel in the image, calculate the grayscale value (vectorised, one row band per task)
+    const unsigned char* src = inputImg.getData();
+    unsigned char* dst = outputImg.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::grayscale(src + first * channels, channels, dst + first, static_cast<size_t>(yEnd - yBegin) * width);
+    });
 }
 
 // Function to apply a brightness adjustment to an image
-Image Filter::setBrightness(Image &inputImg, int value, bool autoBrightness)
+Image Filter::setBrightness(const Image &inputImg, int value, bool autoBrightness)
+{
+    Image output;
+    setBrightness(inputImg, output, value, autoBrightness);
+    return output;
+}
+
+void Filter::setBrightness(const Image &inputImg, Image &outputImg, int value, bool autoBrightness)
 {
     int width = inputImg.getWidth();
     int height = inputImg.getHeight();
     int channels = inputImg.getChannels();
 
-    Image outputImg = Image(width, height, channels);
-
-    int totalIntensity = 0;
-    int totalPixels = width * height * channels;
+    long long totalPixels = static_cast<long long>(width) * height * channels;
 
     // Check if autoBrightness is true
     if (autoBrightness)
@@ -358,314 +794,241 @@ Image Filter::setBrightness(Image &inputImg, int value, bool autoBrightness)
         throw std::invalid_argument("Brightness value must be in the range [-255, 255]");
     }
 
-    // Apply the brightness adjustment to each pixel
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
-        {
-            for (int c = 0; c < channels; ++c)
-            {
-                int allPixels = inputImg.getPixel(x, y, c);
-
-                // If autobrightness is true, calculate the total intensity
-                if (autoBrightness){
-                    totalIntensity += allPixels;
-                }
-
-                else {
-                    // Add the brightness value to the pixel intensity
-                    int newValue = allPixels + value;
-                    newValue = std::max(0, std::min(newValue, 255));
-                    outputImg.setPixel(x, y, c, newValue);
+    // If autobrightness is true, calculate the total intensity and re-run with the derived offset
+    if (autoBrightness){
+        long long totalIntensity = 0;
+        std::mutex totalMutex;
+        Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+            long long bandIntensity = 0;
+            for (int y = yBegin; y < yEnd; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    for (int c = 0; c < channels; ++c) {
+                        bandIntensity += inputImg.getPixel(x, y, c);
+                    }
                 }
             }
-        }
-    }
+            std::lock_guard<std::mutex> lock(totalMutex);
+            totalIntensity += bandIntensity;
+        });
 
-    if (autoBrightness){
         // Calculate the average intensity
-        int averageIntensity = totalIntensity / totalPixels;
+        int averageIntensity = static_cast<int>(totalIntensity / totalPixels);
         // Set the brightness to make the average intensity 128
         value = 128 - averageIntensity;
-        return setBrightness(inputImg, value, false);
-    } 
+        setBrightness(inputImg, outputImg, value, false);
+        return;
+    }
 
-    return outputImg;
+    // Apply the brightness adjustment to each byte of the image; every byte depends only on itself,
+    // so when applied in place the resize keeps the buffer and the kernel rewrites it directly
+    outputImg.resize(width, height, channels);
+    const unsigned char* src = inputImg.getData();
+    unsigned char* dst = outputImg.getData();
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * rowBytes;
+        PixelKernels::addBrightness(src + first, dst + first, (yEnd - yBegin) * rowBytes, value);
+    });
+}
+
+Image Filter::adjustGamma(const Image& image, double gamma) {
+    Image output;
+    adjustGamma(image, output, gamma);
+    return output;
+}
+
+void Filter::adjustGamma(const Image& image, Image& output, double gamma) {
+    LutChain().gamma(gamma).apply(image, output);
 }
 
 // Function to convert RGB images to HSL
-Image Filter::RGBtoHSL(Image &image) {
+Image Filter::RGBtoHSL(const Image &image) {
     int width = image.getWidth();
     int height = image.getHeight();
-    // int channels = image.getChannels();
-
-    Image outputImg = Image(width, height, 3);
-
-    // Iterate through each pixel in the image
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            // Get the RGB values of the pixel
-            double r = image.getPixel(x, y, 0) / 255.0;
-            double g = image.getPixel(x, y, 1) / 255.0;
-            double b = image.getPixel(x, y, 2) / 255.0;
-
-            double max = std::max({r, g, b});
-            double min = std::min({r, g, b});
-            double delta = max - min;
-
-            double h, s, l;
-
-            // Calculate lightness
-            l = (max + min) / 2.0;
+    int channels = image.getChannels();
 
-            // Calculate saturation
-            if (delta == 0) {
-                s = 0;
-            } else {
-                s = delta / (1 - std::abs(2 * l - 1));
-            }
+    if (channels < 3) {
+        throw std::runtime_error("RGBtoHSL requires an image with at least 3 channels.");
+    }
 
-            // Calculate hue
-            if (delta == 0) {
-                h = 0;
-            } else {
-                if (max == r) {
-                    h = 60 * std::fmod((g - b) / delta, 6);
-                } else if (max == g) {
-                    h = 60 * ((b - r) / delta + 2);
-                } else {
-                    h = 60 * ((r - g) / delta + 4);
-                }
-            }
+    Image outputImg = Image(width, height, 3);
 
-            // Set the HSL values for the pixel
-            outputImg.setPixel(x, y, 0, h/360 *255);
-            outputImg.setPixel(x, y, 1, s* 255);
-            outputImg.setPixel(x, y, 2, l*255);
-        }
-    }
+    // Convert each row band with the vectorised kernel
+    const unsigned char* src = image.getData();
+    unsigned char* dst = outputImg.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::rgbToHsl(src + first * channels, channels, dst + first * 3, static_cast<size_t>(yEnd - yBegin) * width);
+    });
     return outputImg;
 }
 
 // Function to convert HSL images to RGB
-Image Filter::HSLtoRGB(Image &inputImg){
+Image Filter::HSLtoRGB(const Image &inputImg){
     int width = inputImg.getWidth();
     int height = inputImg.getHeight();
-    // int channels = inputImg.getChannels();
-
-    Image outputImg = Image(width, height, 3);
-
-    // Iterate through each pixel in the image
-    for (int y = 0; y < height; ++y){
-        for (int x = 0; x < width; ++x){
-            // Get the HSL values of the pixel
-            // Note capitalised variables to not confuse between
-            // x, position and X utilised
-            // for the HSL to RGB conversion
-            double H = inputImg.getPixel(x, y, 0) / 255.0 * 360;
-            double S = inputImg.getPixel(x, y, 1) / 255.0;
-            double L = inputImg.getPixel(x, y, 2) / 255.0;
-
-            double C = (1 - std::abs(2 * L - 1)) * S;
-            double X = C * (1 - std::abs(std::fmod(H / 60, 2) - 1));
-            double M = L - C / 2;
-
-            double R, G, B;
-
-            // Calculate RGB values
-            if (H >= 0 && H < 60) {
-                R = C;
-                G = X;
-                B = 0;
-            } else if (H >= 60 && H < 120) {
-                R = X;
-                G = C;
-                B = 0;
-            } else if (H >= 120 && H < 180) {
-                R = 0;
-                G = C;
-                B = X;
-            } else if (H >= 180 && H < 240) {
-                R = 0;
-                G = X;
-                B = C;
-            } else if (H >= 240 && H < 300) {
-                R = X;
-                G = 0;
-                B = C;
-            } else {
-                R = C;
-                G = 0;
-                B = X;
-            }
-
-            // Set the RGB values for the pixel
-            outputImg.setPixel(x, y, 0, (R + M) * 255);
-            outputImg.setPixel(x, y, 1, (G + M) * 255);
-            outputImg.setPixel(x, y, 2, (B + M) * 255);
+    int channels = inputImg.getChannels();
 
-        }
+    if (channels < 3) {
+        throw std::runtime_error("HSLtoRGB requires an image with at least 3 channels.");
     }
 
+    Image outputImg = Image(width, height, 3);
+
+    // Convert each row band with the vectorised kernel
+    const unsigned char* src = inputImg.getData();
+    unsigned char* dst = outputImg.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::hslToRgb(src + first * channels, channels, dst + first * 3, static_cast<size_t>(yEnd - yBegin) * width);
+    });
     return outputImg;
 }
 
 // Function to apply histogram equalization to an image
-Image Filter::histogramEqualization(Image &inputImg, const bool &isHSV){
-    int width = inputImg.getWidth();
-    int height = inputImg.getHeight();
-    int channels = inputImg.getChannels();
+Image Filter::histogramEqualization(const Image &inputImg, const bool &isHSV) {
+    Image output;
+    histogramEqualization(inputImg, output, isHSV);
+    return output;
+}
 
-    // Create new output image
-    Image outputImg = Image(width, height, channels);
+void Filter::histogramEqualization(const Image &inputImg, Image &outputImg, const bool &isHSV) {
+    int channels = inputImg.getChannels();
 
     // Check if 1, 3, or 4 channels
     if (channels == 3 || channels == 4){
-        // Check if to convert to HSV or HSL
-        if (isHSV){
-            Image hsvImg = rgb_to_hsv(inputImg);
-            // Perform histogram equalization on the lightness channel (L)
-            Image equalisedImg = calculateHistogramEqualization(hsvImg, 2);
-            // Convert back from HSL to RGB
-            outputImg = hsv_to_rgb(equalisedImg);
-        }
-        else{
-            // transform RGB to HSL
-            Image hslImg = RGBtoHSL(inputImg);
-            // Perform histogram equalization on the lightness channel (L)
-            Image equalisedImg = calculateHistogramEqualization(hslImg, 2);
-            // Convert back from HSL to RGB
-            outputImg = HSLtoRGB(equalisedImg);
+        // Equalise V (HSV) or L (HSL): its histogram is read straight from the RGB pixels, then each row is
+        // converted, remapped and converted back through a one-row buffer, so no HSV/HSL image is built
+        if (replaceAliased(inputImg, outputImg, [&](Image& result) { histogramEqualization(inputImg, result, isHSV); })) {
+            return;
         }
+        const Histogram::Table table = Histogram::equalisationTable(Histogram::computeBrightness(inputImg, isHSV));
+
+        int width = inputImg.getWidth();
+        int height = inputImg.getHeight();
+        outputImg.resize(width, height, 3);
+        const unsigned char* src = inputImg.getData();
+        unsigned char* dst = outputImg.getData();
+        size_t srcStride = static_cast<size_t>(width) * channels;
+        size_t dstStride = static_cast<size_t>(width) * 3;
+        Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+            std::vector<unsigned char> converted(dstStride);
+            for (int y = yBegin; y < yEnd; ++y) {
+                if (isHSV) {
+                    PixelKernels::rgbToHsv(src + y * srcStride, channels, converted.data(), width);
+                } else {
+                    PixelKernels::rgbToHsl(src + y * srcStride, channels, converted.data(), width);
+                }
+                PixelKernels::lookup(converted.data() + 2, converted.data() + 2, 3, width, table.data());
+                if (isHSV) {
+                    PixelKernels::hsvToRgb(converted.data(), 3, dst + y * dstStride, width);
+                } else {
+                    PixelKernels::hslToRgb(converted.data(), 3, dst + y * dstStride, width);
+                }
+            }
+        });
     }
 
     else if (channels == 1){
-        // Perform histogram equalization on the single channel
-        outputImg = calculateHistogramEqualization(inputImg, 0);
+        // Perform histogram equalization on the single channel; the table is complete before any pixel is
+        // rewritten, so this also works in place
+        const Histogram::Table table = Histogram::equalisationTable(Histogram::compute(inputImg, 0));
+        int width = inputImg.getWidth();
+        outputImg.resize(width, inputImg.getHeight(), 1);
+        const unsigned char* src = inputImg.getData();
+        unsigned char* dst = outputImg.getData();
+        Parallel::forRange(0, inputImg.getHeight(), [&](int yBegin, int yEnd) {
+            size_t first = static_cast<size_t>(yBegin) * width;
+            PixelKernels::lookup(src + first, dst + first, 1, static_cast<size_t>(yEnd - yBegin) * width, table.data());
+        });
     }
 
         // If the image has an invalid number of channels
     else{
         throw std::invalid_argument("Image must have 1, 3, or 4 channels to be converted to grayscale");
     }
-
-    return outputImg;
-
 }
 
-Image Filter::calculateHistogramEqualization(Image &inputImg, int channelIndex) {
+Image Filter::calculateHistogramEqualization(const Image &inputImg, int channelIndex) {
     int width = inputImg.getWidth();
     int height = inputImg.getHeight();
     int channels = inputImg.getChannels();
 
-    Image outputImg = Image(width, height, channels);
+    // Per-band histograms merged once, then the equalisation table
+    const Histogram::Table table = Histogram::equalisationTable(Histogram::compute(inputImg, channelIndex));
 
-    // Initialize histogram array
-    int histogram[256] = {0};
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int intensity = inputImg.getPixel(x, y, channelIndex);
-            histogram[intensity]++;
-        }
-    }
+    // The other channels are preserved by the copy; only the equalised channel is remapped
+    Image outputImg(inputImg);
+    unsigned char* data = outputImg.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::lookup(data + first * channels + channelIndex, data + first * channels + channelIndex, channels,
+                             static_cast<size_t>(yEnd - yBegin) * width, table.data());
+    });
 
-    // Calculate CDF
-    int cdf[256] = {0};
-    cdf[0] = histogram[0];
-    for (int i = 1; i < 256; ++i) {
-        cdf[i] = cdf[i-1] + histogram[i];
-    }
-
-    // Find the minimum CDF value (remove 0 values)
-    int minCDF = cdf[0];
-    for (int i = 1; i < 256; ++i) {
-        if (cdf[i] != 0) {
-            minCDF = cdf[i];
-            break;
-        }
-    }
-
-    // Find the minimum and maximum intensity values
-    int newValues[256];
-    for (int i = 0; i < 256; ++i) {
-        newValues[i] = static_cast<int>(255.0 * (cdf[i] - minCDF) / (width * height - minCDF));
-    }
+    return outputImg;
+}
 
-    // Apply histogram equalization to the specified channel
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            if (channels > 1) {
-                // Preserve other channels' values
-                for (int c = 0; c < channels; ++c) {
-                    if (c != channelIndex) {
-                        outputImg.setPixel(x, y, c, inputImg.getPixel(x, y, c));
-                    }
-                }
-            }
-            int originalIntensity = inputImg.getPixel(x, y, channelIndex);
-            int adjustedIntensity = newValues[originalIntensity];
-            outputImg.setPixel(x, y, channelIndex, adjustedIntensity);
-        }
-    }
+Image Filter::adaptiveHistogramEqualization(const Image& image, double clipLimit, int tilesX, int tilesY,
+                                            bool isHSV) {
+    Image output;
+    adaptiveHistogramEqualization(image, output, clipLimit, tilesX, tilesY, isHSV);
+    return output;
+}
 
-    return outputImg;
+void Filter::adaptiveHistogramEqualization(const Image& image, Image& output, double clipLimit, int tilesX,
+                                           int tilesY, bool isHSV) {
+    Clahe::apply(image, output, clipLimit, tilesX, tilesY, isHSV);
 }
 
 // Function to apply salt and pepper noise to an image
 Image Filter::salt_and_pepper(Image image, const double &proportion, const bool &rgb) {
-    int w = image.getWidth();
-    int h = image.getHeight();
-    int c = image.getChannels();
     srand(static_cast<unsigned int>(time(0)));
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            if (random_number() < proportion) {
-                // Randomly set the pixel to either 0 or 255
-                unsigned char color = random_number() < 0.5 ? 0 : 255;
-                if (rgb) {
-                    // Apply noise to all channels
-                    for (int channel = 0; channel < c; ++channel) {
-                        image.setPixel(x, y, channel, color);
-                    }
-                } else {
-                    image.setPixel(x, y, 0, color); // Assuming grayscale affects only the first channel
-                }
-            }
-        }
-    }
+    scatterSaltAndPepper(image, proportion, rgb, [] { return random_number(); });
+    return image;
+}
+
+Image Filter::salt_and_pepper(Image image, const double &proportion, const bool &rgb, unsigned int seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    scatterSaltAndPepper(image, proportion, rgb, [&] { return unit(engine); });
     return image;
 }
 
 // Function to apply a threshold to an image
-Image Filter::threshold(Image& image, const double &thresholdValue, const bool &rgb, bool isHSV) {
+Image Filter::threshold(const Image& image, const double &thresholdValue, const bool &rgb, bool isHSV) {
+    Image output;
+    threshold(image, output, thresholdValue, rgb, isHSV);
+    return output;
+}
+
+void Filter::threshold(const Image& image, Image& output, const double &thresholdValue, const bool &rgb, bool isHSV) {
+    // A single-channel image is thresholded byte for byte, which the kernel can do in place
+    if (image.getChannels() != 1
+        && replaceAliased(image, output, [&](Image& result) { threshold(image, result, thresholdValue, rgb, isHSV); })) {
+        return;
+    }
+
     int width = image.getWidth();
     int height = image.getHeight();
-    Image resultImage(width, height, 1); // Output is a single-channel image for thresholded results.
 
-    if (!rgb) {
-        // Grayscale thresholding
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                unsigned char pixelValue = image.getPixel(x, y, 0);
-                unsigned char newValue = (pixelValue >= thresholdValue) ? 255 : 0;
-                resultImage.setPixel(x, y, 0, newValue);
-            }
-        }
-    } else {
-        // Convert the entire RGB image to HSV or HSL once before thresholding
-        Image convertedImage = isHSV ? rgb_to_hsv(image) : RGBtoHSL(image);
-
-        // Apply thresholding based on the V/L channel
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                unsigned char channelValue = convertedImage.getPixel(x, y, 2); // Use V/L channel
-                unsigned char newValue = (channelValue >= thresholdValue) ? 255 : 0;
-                resultImage.setPixel(x, y, 0, newValue); // Set pixel in the result image
-            }
-        }
+    // Grayscale thresholding reads channel 0; for RGB the image is converted to HSV or HSL once
+    // and the V/L channel (channel 2) is thresholded instead
+    Image convertedImage;
+    const unsigned char* src = image.getData();
+    int stride = image.getChannels();
+    if (rgb && image.getChannels() >= 3) {
+        convertedImage = isHSV ? rgb_to_hsv(image) : RGBtoHSL(image);
+        src = convertedImage.getData() + 2;
+        stride = 3;
     }
 
-    return resultImage;
+    output.resize(width, height, 1); // Output is a single-channel image for thresholded results.
+    unsigned char* dst = output.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::threshold(src + first * stride, stride, dst + first, static_cast<size_t>(yEnd - yBegin) * width, thresholdValue);
+    });
 }
 
 // Function to generate a random number between 0 and 1
@@ -675,7 +1038,7 @@ double Filter::random_number(){
 }
 
 // Function to convert RGB images to HSV
-Image Filter::rgb_to_hsv(Image& image) {
+Image Filter::rgb_to_hsv(const Image& image) {
     int width = image.getWidth();
     int height = image.getHeight();
     int channels = image.getChannels();
@@ -688,45 +1051,13 @@ Image Filter::rgb_to_hsv(Image& image) {
     // Create a new image to store the HSV values, maintaining the input image dimensions but forcing 3 channels
     Image hsvImage(width, height, 3);
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            float r = image.getPixel(x, y, 0) / 255.0f;
-            float g = image.getPixel(x, y, 1) / 255.0f;
-            float b = image.getPixel(x, y, 2) / 255.0f;
-
-            float max = std::max({r, g, b});
-            float min = std::min({r, g, b});
-            float delta = max - min;
-
-            float h, s, v;
-            v = max;
-
-            if (delta < 0.00001f) {
-                s = 0;
-                h = 0; // Undefined, maybe nan?
-            } else {
-                s = (max > 0.0f) ? (delta / max) : 0.0f;
-
-                if (r >= max) {
-                    h = (g - b) / delta; // Between yellow & magenta
-                } else if (g >= max) {
-                    h = 2.0f + (b - r) / delta; // Between cyan & yellow
-                } else {
-                    h = 4.0f + (r - g) / delta; // Between magenta & cyan
-                }
-
-                h *= 60.0f; // Convert to degrees
-
-                if (h < 0.0f) {
-                    h += 360.0f;
-                }
-            }
-
-            hsvImage.setPixel(x, y, 0, static_cast<unsigned char>((h / 360.0f) * 255)); // H: 0-360 degrees -> scaled to 0-255
-            hsvImage.setPixel(x, y, 1, static_cast<unsigned char>(s * 255)); // S: 0-1 -> scaled to 0-255
-            hsvImage.setPixel(x, y, 2, static_cast<unsigned char>(v * 255)); // V: 0-1 -> scaled to 0-255
-        }
-    }
+    // H: 0-360 degrees, S and V: 0-1, all scaled to 0-255
+    const unsigned char* src = image.getData();
+    unsigned char* dst = hsvImage.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::rgbToHsv(src + first * channels, channels, dst + first * 3, static_cast<size_t>(yEnd - yBegin) * width);
+    });
 
     return hsvImage;
 }
@@ -735,144 +1066,85 @@ Image Filter::rgb_to_hsv(Image& image) {
 Image Filter::hsv_to_rgb(const Image& hsvImage) {
     int width = hsvImage.getWidth();
     int height = hsvImage.getHeight();
-    // Assuming the output RGB image will have 3 channels.
-    Image rgbImage(width, height, 3);
+    int channels = hsvImage.getChannels();
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            float h = hsvImage.getPixel(x, y, 0) * (360.0f / 255.0f); // Rescale to 0-360
-            float s = hsvImage.getPixel(x, y, 1) / 255.0f; // Scale to 0-1
-            float v = hsvImage.getPixel(x, y, 2) / 255.0f; // Scale to 0-1
-
-            float c = v * s; // Chroma
-            float xVal = c * (1 - fabs(fmod(h / 60.0, 2) - 1));
-            float m = v - c;
-
-            float rPrime, gPrime, bPrime;
-
-            if (h >= 0 && h < 60) {
-                rPrime = c;
-                gPrime = xVal;
-                bPrime = 0;
-            } else if (h >= 60 && h < 120) {
-                rPrime = xVal;
-                gPrime = c;
-                bPrime = 0;
-            } else if (h >= 120 && h < 180) {
-                rPrime = 0;
-                gPrime = c;
-                bPrime = xVal;
-            } else if (h >= 180 && h < 240) {
-                rPrime = 0;
-                gPrime = xVal;
-                bPrime = c;
-            } else if (h >= 240 && h < 300) {
-                rPrime = xVal;
-                gPrime = 0;
-                bPrime = c;
-            } else {
-                rPrime = c;
-                gPrime = 0;
-                bPrime = xVal;
-            }
-
-            // Convert to RGB format
-            auto r = static_cast<unsigned char>((rPrime + m) * 255);
-            auto g = static_cast<unsigned char>((gPrime + m) * 255);
-            auto b = static_cast<unsigned char>((bPrime + m) * 255);
-
-            // Set RGB pixel values
-            rgbImage.setPixel(x, y, 0, r);
-            rgbImage.setPixel(x, y, 1, g);
-            rgbImage.setPixel(x, y, 2, b);
-        }
+    if (channels < 3) {
+        throw std::runtime_error("hsv_to_rgb requires an image with at least 3 channels (HSV).");
     }
 
-    return rgbImage;
-}
+    // Assuming the output RGB image will have 3 channels.
+    Image rgbImage(width, height, 3);
 
-// Helper function to apply an edge operator to an image
-Image Filter::applyEdgeOperator(Image& image, const int kernelX[3][3], const int kernelY[3][3]) {
-    auto imageVector = ConvertImageToVector(image);
-    int width = image.getWidth();
-    int height = image.getHeight();
-    std::vector<std::vector<unsigned char>> gradient(height, std::vector<unsigned char>(width, 0));
-
-    for (int y = 1; y < height - 1; ++y) {
-        for (int x = 1; x < width - 1; ++x) {
-            int sumX = 0, sumY = 0;
-            for (int ky = -1; ky <= 1; ++ky) {
-                for (int kx = -1; kx <= 1; ++kx) {
-                    sumX += imageVector[y + ky][x + kx] * kernelX[ky + 1][kx + 1];
-                    sumY += imageVector[y + ky][x + kx] * kernelY[ky + 1][kx + 1];
-                }
-            }
-            int magnitude = std::sqrt(sumX * sumX + sumY * sumY);
-            magnitude = std::min(255, std::max(0, magnitude));
-            gradient[y][x] = static_cast<unsigned char>(magnitude);
-        }
-    }
+    const unsigned char* src = hsvImage.getData();
+    unsigned char* dst = rgbImage.getData();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t first = static_cast<size_t>(yBegin) * width;
+        PixelKernels::hsvToRgb(src + first * channels, channels, dst + first * 3, static_cast<size_t>(yEnd - yBegin) * width);
+    });
 
-    return convertGradientToImage(gradient, width, height);
+    return rgbImage;
 }
 
 // Function to apply the Sobel operator edge detection to an image
-Image Filter::applySobelOperator(Image& image) {
-    int Gx[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
-    int Gy[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+Image Filter::applySobelOperator(const Image& image) {
+    Image output;
+    applySobelOperator(image, output);
+    return output;
+}
 
-    return applyEdgeOperator(image, Gx, Gy);
+void Filter::applySobelOperator(const Image& image, Image& output) {
+    Gradient::magnitude(image, Gradient::Operator::Sobel, output);
 }
 
 // Function to apply the Prewitt operator edge detection to an image
-Image Filter::applyPrewittOperator(Image& image) {
-    int Gx[3][3] = {{-1, 0, 1}, {-1, 0, 1}, {-1, 0, 1}};
-    int Gy[3][3] = {{-1, -1, -1}, {0, 0, 0}, {1, 1, 1}};
+Image Filter::applyPrewittOperator(const Image& image) {
+    Image output;
+    applyPrewittOperator(image, output);
+    return output;
+}
 
-    return applyEdgeOperator(image, Gx, Gy);
+void Filter::applyPrewittOperator(const Image& image, Image& output) {
+    Gradient::magnitude(image, Gradient::Operator::Prewitt, output);
 }
 
 // Function to apply the Scharr operator edge detection to an image
-Image Filter::applyScharrOperator(Image& image) {
-    int Gx[3][3] = {{-3, 0, 3}, {-10, 0, 10}, {-3, 0, 3}};
-    int Gy[3][3] = {{-3, -10, -3}, {0, 0, 0}, {3, 10, 3}};
+Image Filter::applyScharrOperator(const Image& image) {
+    Image output;
+    applyScharrOperator(image, output);
+    return output;
+}
 
-    return applyEdgeOperator(image, Gx, Gy);
+void Filter::applyScharrOperator(const Image& image, Image& output) {
+    Gradient::magnitude(image, Gradient::Operator::Scharr, output);
 }
 
 // Function to apply the Roberts Cross operator edge detection to an image
-Image Filter::applyRobertsCrossOperator(Image& image) {
-    int Gx[4] = {1, 0, 0, -1};
-    int Gy[4] = {0, 1, -1, 0};
-    int width = image.getWidth();
-    int height = image.getHeight();
-    Image resultImage(width, height, 1);
-
-    for (int y = 0; y < height - 1; ++y) {
-        for (int x = 0; x < width - 1; ++x) {
-            // Applying Gx
-            int pixelValue00 = image.getPixel(x, y, 0);
-            int pixelValue11 = image.getPixel(x + 1, y + 1, 0);
-            int sumX = pixelValue00 - pixelValue11;
-
-            // Applying Gy
-            int pixelValue01 = image.getPixel(x, y + 1, 0);
-            int pixelValue10 = image.getPixel(x + 1, y, 0);
-            int sumY = pixelValue01 - pixelValue10;
-
-            // Compute gradient
-            int magnitude = std::min(255, std::max(0, static_cast<int>(std::sqrt(sumX * sumX + sumY * sumY))));
-            resultImage.setPixel(x, y, 0, magnitude);
-        }
-    }
+Image Filter::applyRobertsCrossOperator(const Image& image) {
+    Image output;
+    applyRobertsCrossOperator(image, output);
+    return output;
+}
+
+void Filter::applyRobertsCrossOperator(const Image& image, Image& output) {
+    Gradient::magnitude(image, Gradient::Operator::Roberts, output);
+}
+
+// Function to apply Canny edge detection to an image
+Image Filter::applyCannyEdgeDetector(const Image& image, float lowThreshold, float highThreshold, int kernelSize,
+                                     float sigma) {
+    Image output;
+    applyCannyEdgeDetector(image, output, lowThreshold, highThreshold, kernelSize, sigma);
+    return output;
+}
 
-    // Handle the last row and column
-    for (int y = 0; y < height; ++y)
-        resultImage.setPixel(width - 1, y, 0, 0);
-    for (int x = 0; x < width; ++x)
-        resultImage.setPixel(x, height - 1, 0, 0);
+void Filter::applyCannyEdgeDetector(const Image& image, Image& output, float lowThreshold, float highThreshold,
+                                    int kernelSize, float sigma) {
+    Gradient::canny(image, output, lowThreshold, highThreshold, kernelSize, sigma);
+}
 
-    return resultImage;
+void Filter::apply3DAdaptiveHistogramEqualization(Volume& volume, double clipLimit, int tilesX, int tilesY,
+                                                  int tilesZ) {
+    Clahe::apply(volume, clipLimit, tilesX, tilesY, tilesZ);
 }
 
 // Create a 3D Gaussian kernel
@@ -904,101 +1176,229 @@ std::vector<std::vector<std::vector<float>>> Filter::create3DKernel(int kernelSi
 }
 
 void Filter::apply3DGaussianBlur(Volume& volume, int kernelSize, float sigma) {
-    auto kernel = create3DKernel(kernelSize, sigma);
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd.");
+    }
+
+    // The normalised 3D Gaussian is the product of three normalised 1D kernels
+    const std::vector<float>& kernel = gaussianKernel1D(kernelSize, sigma);
+    int radius = kernelSize / 2;
     int width = volume.getWidth();
     int height = volume.getHeight();
     int depth = volume.getDepth();
-
-    // Temporary volume to store the blurred data
-    Volume tempVolume(volume);
-
-    for (int z = 0; z < depth; ++z) {
-        std::cout << "Blurring Depth: " << z + 1 << " / " << depth << std::endl;
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                std::vector<float> newValue(volume.getChannels(), 0.0f);
-
-                for (int kz = -kernelSize/2; kz <= kernelSize/2; ++kz) {
-                    for (int ky = -kernelSize/2; ky <= kernelSize/2; ++ky) {
-                        for (int kx = -kernelSize/2; kx <= kernelSize/2; ++kx) {
-                            int sz = std::clamp(z + kz, 0, depth - 1);
-                            int sy = std::clamp(y + ky, 0, height - 1);
-                            int sx = std::clamp(x + kx, 0, width - 1);
-
-                            for (int channel = 0; channel < volume.getChannels(); ++channel) {
-                                unsigned char voxelValue = volume.getVoxel(sx, sy, sz, channel);
-                                newValue[channel] += voxelValue * kernel[kz + kernelSize/2][ky + kernelSize/2][kx + kernelSize/2];
-                            }
-                        }
+    int channels = volume.getChannels();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t sliceSize = rowStride * height;
+
+    const unsigned char* src = volume.getVolumeData();
+    Volume blurredVolume(width, height, depth, channels);
+    unsigned char* dst = blurredVolume.getVolumeData();
+
+    // Blurring along z first reads the source bytes directly, so each thread only keeps the kernelSize
+    // z-blurred rows the y pass needs, however large the slices are
+    Parallel::forRange(0, depth, [&](int zBegin, int zEnd) {
+        // Ring of z-blurred rows; row y lives in slot y % kernelSize, which is unique inside the window
+        std::vector<float> ring(static_cast<size_t>(kernelSize) * rowStride);
+        std::vector<int> ringRow(kernelSize);
+        std::vector<float> columnBlurred(rowStride);
+        std::vector<const unsigned char*> window(kernelSize);
+        std::vector<const float*> rows(kernelSize);
+
+        for (int z = zBegin; z < zEnd; ++z) {
+            for (int kz = -radius; kz <= radius; ++kz) {
+                window[kz + radius] = src + std::clamp(z + kz, 0, depth - 1) * sliceSize;
+            }
+            std::fill(ringRow.begin(), ringRow.end(), -1);
+
+            // Blurs row y of slice z along z into its ring slot
+            auto blurRow = [&](int y) -> const float* {
+                int slot = y % kernelSize;
+                float* out = ring.data() + slot * rowStride;
+                if (ringRow[slot] == y) {
+                    return out;
+                }
+                std::fill(out, out + rowStride, 0.0f);
+                for (int k = 0; k < kernelSize; ++k) {
+                    const unsigned char* inRow = window[k] + y * rowStride;
+                    float weight = kernel[k];
+                    for (size_t i = 0; i < rowStride; ++i) {
+                        out[i] += inRow[i] * weight;
+                    }
+                }
+                ringRow[slot] = y;
+                return out;
+            };
+
+            unsigned char* dstSlice = dst + z * sliceSize;
+            for (int y = 0; y < height; ++y) {
+                // y pass over the ring, then x pass into the output row
+                for (int ky = -radius; ky <= radius; ++ky) {
+                    rows[ky + radius] = blurRow(std::clamp(y + ky, 0, height - 1));
+                }
+                std::fill(columnBlurred.begin(), columnBlurred.end(), 0.0f);
+                for (int k = 0; k < kernelSize; ++k) {
+                    const float* inRow = rows[k];
+                    float weight = kernel[k];
+                    for (size_t i = 0; i < rowStride; ++i) {
+                        columnBlurred[i] += inRow[i] * weight;
                     }
                 }
 
-                for (int channel = 0; channel < volume.getChannels(); ++channel) {
-                    tempVolume.setVoxel(x, y, z, channel, static_cast<unsigned char>(std::min(std::max(static_cast<int>(newValue[channel]), 0), 255)));
+                unsigned char* dstRow = dstSlice + y * rowStride;
+                for (int x = 0; x < width; ++x) {
+                    for (int c = 0; c < channels; ++c) {
+                        float sum = 0.0f;
+                        for (int kx = -radius; kx <= radius; ++kx) {
+                            sum += columnBlurred[std::clamp(x + kx, 0, width - 1) * channels + c] * kernel[kx + radius];
+                        }
+                        dstRow[x * channels + c] = static_cast<unsigned char>(std::min(std::max(static_cast<int>(sum), 0), 255));
+                    }
                 }
             }
         }
-    }
+    });
 
-    volume = std::move(tempVolume);
+    volume = std::move(blurredVolume);
 }
 
 void Filter::apply3DMedianFilter(Volume& volume, int kernelSize) {
     if (kernelSize % 2 == 0) {
         throw std::invalid_argument("Kernel size must be odd.");
     }
+    // The sliding histogram counts up to kernelSize^2 voxels per column in 16 bits
+    if (kernelSize > 255) {
+        throw std::invalid_argument("Kernel size must be at most 255.");
+    }
 
+    // Small windows are cheapest to sort; beyond that the sliding histogram wins
+    if (kernelSize < medianHistogramKernelThreshold) {
+        volumeMedianSort(volume, kernelSize);
+    } else {
+        volumeMedianHistogram(volume, kernelSize);
+    }
+}
+
+void Filter::apply3DGaussianBlur(BrickedVolume& volume, int kernelSize, float sigma) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd.");
+    }
+    volume.transformWithHalo(kernelSize / 2, [&](Volume& region) {
+        apply3DGaussianBlur(region, kernelSize, sigma);
+    });
+}
+
+void Filter::apply3DMedianFilter(BrickedVolume& volume, int kernelSize) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd.");
+    }
+    if (kernelSize > 255) {
+        throw std::invalid_argument("Kernel size must be at most 255.");
+    }
+    volume.transformWithHalo(kernelSize / 2, [&](Volume& region) {
+        apply3DMedianFilter(region, kernelSize);
+    });
+}
+
+void Filter::volumeMedianSort(Volume& volume, int kernelSize) {
     int width = volume.getWidth();
     int height = volume.getHeight();
     int depth = volume.getDepth();
     int channels = volume.getChannels();
     int offset = kernelSize / 2;
     int bufferSize = kernelSize * kernelSize * kernelSize;
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t sliceSize = rowStride * height;
+
+    const unsigned char* src = volume.getVolumeData();
+    Volume filteredVolume(width, height, depth, channels);
+    unsigned char* dst = filteredVolume.getVolumeData();
+
+    Parallel::forRange(0, depth, [&](int zBegin, int zEnd) {
+        // One neighbourhood buffer per band, reused for every voxel
+        std::vector<unsigned char> neighborhood(bufferSize);
+
+        for (int z = zBegin; z < zEnd; ++z) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    for (int channel = 0; channel < channels; ++channel) {
+                        int n = 0;
+                        for (int kz = -offset; kz <= offset; ++kz) {
+                            const unsigned char* slice = src + std::clamp(z + kz, 0, depth - 1) * sliceSize;
+                            for (int ky = -offset; ky <= offset; ++ky) {
+                                const unsigned char* row = slice + std::clamp(y + ky, 0, height - 1) * rowStride;
+                                for (int kx = -offset; kx <= offset; ++kx) {
+                                    neighborhood[n++] = row[std::clamp(x + kx, 0, width - 1) * channels + channel];
+                                }
+                            }
+                        }
+
+                        // The window size is odd, so the median is the middle element
+                        std::nth_element(neighborhood.begin(), neighborhood.begin() + bufferSize / 2, neighborhood.end());
+                        dst[z * sliceSize + y * rowStride + x * channels + channel] = neighborhood[bufferSize / 2];
+                    }
+                }
+            }
+        }
+    });
 
-    Volume tempVolume(volume);
+    volume = std::move(filteredVolume);
+}
 
-    for (int z = 0; z < depth; ++z) {
-        std::cout << "Applying Median Filter at Depth: " << z + 1 << " / " << depth << std::endl;
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                for (int channel = 0; channel < channels; ++channel) {
-                    auto* neighborhood = new unsigned char[bufferSize];                                        //new version
-//                    std::vector<unsigned char> neighborhood;                                                                      //old version
-
-                    for (int kz = -offset; kz <= offset; ++kz) {
-                        for (int ky = -offset; ky <= offset; ++ky) {
-                            for (int kx = -offset; kx <= offset; ++kx) {
-                                int nz = std::clamp(z + kz, 0, depth - 1);
-                                int ny = std::clamp(y + ky, 0, height - 1);
-                                int nx = std::clamp(x + kx, 0, width - 1);
-
-                                neighborhood[(kz + offset) * kernelSize * kernelSize + (ky + offset) * kernelSize + (kx + offset)] = volume.getVoxel(nx, ny, nz, channel);    //new version
-//                                neighborhood.push_back(volume.getVoxel(nx, ny, nz, channel));                                    //old version
-                            }
+void Filter::volumeMedianHistogram(Volume& volume, int kernelSize) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+    int radius = kernelSize / 2;
+    unsigned int medianRank = static_cast<unsigned int>(kernelSize * kernelSize * kernelSize) / 2;
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t sliceSize = rowStride * height;
+
+    const unsigned char* src = volume.getVolumeData();
+    Volume filteredVolume(width, height, depth, channels);
+    unsigned char* dst = filteredVolume.getVolumeData();
+
+    // Slabs of z are independent; the histograms are allocated once per slab
+    Parallel::forRange(0, depth, [&](int zBegin, int zEnd) {
+        // Histogram of every (y, z) column block at each x: the (2r + 1) x (2r + 1) voxels in y and z
+        std::vector<uint16_t> columnFine(static_cast<size_t>(width) * 256);
+        std::vector<uint16_t> columnCoarse(static_cast<size_t>(width) * 16);
+
+        for (int z = zBegin; z < zEnd; ++z) {
+            for (int channel = 0; channel < channels; ++channel) {
+                std::fill(columnFine.begin(), columnFine.end(), 0);
+                std::fill(columnCoarse.begin(), columnCoarse.end(), 0);
+
+                // Adds (+1) or removes (-1) row y of every slice in the z window from the column histograms
+                auto updateColumns = [&](int y, int delta) {
+                    size_t rowOffset = std::clamp(y, 0, height - 1) * rowStride;
+                    for (int kz = -radius; kz <= radius; ++kz) {
+                        const unsigned char* row = src + std::clamp(z + kz, 0, depth - 1) * sliceSize + rowOffset;
+                        for (int x = 0; x < width; ++x) {
+                            unsigned char value = row[x * channels + channel];
+                            columnFine[x * 256 + value] += delta;
+                            columnCoarse[x * 16 + (value >> 4)] += delta;
                         }
                     }
+                };
 
-//                    std::nth_element(neighborhood.begin(), neighborhood.begin() + neighborhood.size() / 2, neighborhood.end());    //old version
-                    // Sort the neighborhood using Projection::quickSort
-                    Projection::quickSort(neighborhood, 0, bufferSize - 1);                                  //new version
+                for (int ky = -radius; ky <= radius; ++ky) {
+                    updateColumns(ky, 1);
+                }
 
-                    // Find the median intensity value
-                    unsigned char median;                                                                   //new version
-                    // Check if the number of elements is even or odd
-                    if (bufferSize % 2 == 0) {                                                             //new version
-                        median = (neighborhood[bufferSize / 2 - 1] + neighborhood[bufferSize / 2]) / 2;    //new version
-                    } else {                                                                                //new version
-                        median = neighborhood[bufferSize / 2];                                             //new version
-                    }                                                                                        //new version
-
-//                    unsigned char median = neighborhood[neighborhood.size() / 2];//old version
-                    tempVolume.setVoxel(x, y, z, channel, median);
+                for (int y = 0; y < height; ++y) {
+                    if (y > 0) {
+                        updateColumns(y - radius - 1, -1);
+                        updateColumns(y + radius, 1);
+                    }
+                    medianRowFromColumnHistograms(columnFine.data(), columnCoarse.data(), width, radius, medianRank,
+                                                  dst + z * sliceSize + y * rowStride + channel, channels);
                 }
             }
         }
-    }
+    });
 
-    volume = std::move(tempVolume);
+    volume = std::move(filteredVolume);
 }
 
 int Filter::findMedianHist(const std::vector<int>& histogram, int windowSize) {
@@ -1013,90 +1413,25 @@ int Filter::findMedianHist(const std::vector<int>& histogram, int windowSize) {
     return -1; // Error case, should not happen if histogram is correctly filled
 }
 
-int Filter::findMedianHist3D(const std::vector<int>& histogram, int windowSize) {
-    int count = 0;
-    int medianIndex = (windowSize - 1) / 2; // For a zero-based index array
-    for (size_t i = 0; i < histogram.size(); i++) {
-        count += histogram[i];
-        if (count > medianIndex) {
-            return static_cast<int>(i); // The median value
-        }
+void Filter::apply3DMedianHistFilter(Volume& volume, int kernelSize) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd.");
     }
-    return -1; // Error case, should not happen if histogram is correctly filled
+    // Column histograms count up to kernelSize^2 voxels in 16 bits
+    if (kernelSize > 255) {
+        throw std::invalid_argument("Kernel size must be at most 255.");
+    }
+    volumeMedianHistogram(volume, kernelSize);
 }
 
-void Filter::volumeMedianFilter(Volume& volume, int kernelSize) {
-    // Ensure that the kernel size is odd to have a central voxel
+void Filter::apply3DMedianHistFilter(BrickedVolume& volume, int kernelSize) {
     if (kernelSize % 2 == 0) {
-        std::cerr << "Kernel size must be odd." << std::endl;
-        return;
-    }
-
-    int numChannels = volume.getChannels();
-    int width = volume.getWidth();
-    int height = volume.getHeight();
-    int depth = volume.getDepth();
-    int halfKernel = kernelSize / 2;
-
-    std::vector<std::vector<int>> histograms(numChannels, std::vector<int>(256, 0));
-    Volume filteredVolume(width, height, depth, numChannels);
-
-    for (int z = 0; z < depth; ++z) {
-        for (int y = 0; y < height; ++y) {
-            for (int c = 0; c < numChannels; ++c) { // Initialize histograms for the first window in each row
-                std::fill(histograms[c].begin(), histograms[c].end(), 0);
-                for (int dz = -halfKernel; dz <= halfKernel; ++dz) {
-                    for (int dy = -halfKernel; dy <= halfKernel; ++dy) {
-                        for (int dx = -halfKernel; dx <= halfKernel; ++dx) {
-                            int nx = std::min(std::max(0 + dx, 0), width - 1);
-                            int ny = std::min(std::max(y + dy, 0), height - 1);
-                            int nz = std::min(std::max(z + dz, 0), depth - 1);
-                            unsigned char voxelValue = volume.getVoxel(nx, ny, nz, c);
-                            histograms[c][voxelValue]++;
-                        }
-                    }
-                }
-            }
-
-            for (int x = 0; x < width; ++x) {
-                for (int c = 0; c < numChannels; ++c) {
-                    // Find the median using the histogram for the current channel
-                    unsigned char medianValue = findMedianHist3D(histograms[c], kernelSize * kernelSize * kernelSize);
-                    filteredVolume.setVoxel(x, y, z, c, medianValue);
-
-                    // Update histograms by sliding the window
-                    if (x < width - 1) {
-                        for (int dy = -halfKernel; dy <= halfKernel; ++dy) {
-                            for (int dz = -halfKernel; dz <= halfKernel; ++dz) {
-                                int ny = std::min(std::max(y + dy, 0), height - 1);
-                                int nz = std::min(std::max(z + dz, 0), depth - 1);
-                                // Subtract the voxel that is left behind as the window slides
-                                unsigned char voxelOut = volume.getVoxel(std::max(x - halfKernel, 0), ny, nz, c);
-                                histograms[c][voxelOut]--;
-                                // Add the voxel that comes into the window as it slides
-                                unsigned char voxelIn = volume.getVoxel(std::min(x + halfKernel + 1, width - 1), ny, nz, c);
-                                histograms[c][voxelIn]++;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        // Optionally, print progress
-        std::cout << "Processing on depth: " << z << std::endl;
+        throw std::invalid_argument("Kernel size must be odd.");
     }
-    // Update the original volume with the filtered data
-    for (int z = 0; z < depth; ++z) {
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                for (int c = 0; c < numChannels; ++c) {
-                    volume.setVoxel(x, y, z, c, filteredVolume.getVoxel(x, y, z, c));
-                }
-            }
-        }
+    if (kernelSize > 255) {
+        throw std::invalid_argument("Kernel size must be at most 255.");
     }
+    volume.transformWithHalo(kernelSize / 2, [&](Volume& region) {
+        volumeMedianHistogram(region, kernelSize);
+    });
 }
-void Filter::apply3DMedianHistFilter(Volume& volume, int kernelSize) {
-    Filter filter; // Create an instance of the Filter class
-    filter.volumeMedianFilter(volume, kernelSize); // Call the volumeMedianFilter function using the instance
-}
\ No newline at end of file
@@ -0,0 +1,506 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Gradient.h"
+#include "Filter.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// 3x3 operator whose x derivative is the central difference weighted Side, Centre, Side across the rows,
+// and whose y derivative is the same kernel transposed. Rows may be bytes or floats
+template <int Side, int Centre>
+struct CentralDifference {
+    static constexpr bool usesAbove = true; ///< Reads the row above
+    static constexpr int first = 1;         ///< First row and column with a full neighbourhood
+
+    template <typename In, typename Out>
+    static void row(const In* above, const In* centre, const In* below, int width, Out* gx, Out* gy) {
+        for (int x = 1; x < width - 1; ++x) {
+            gx[x] = Side * (above[x + 1] - above[x - 1]) + Centre * (centre[x + 1] - centre[x - 1])
+                    + Side * (below[x + 1] - below[x - 1]);
+            gy[x] = Side * (below[x - 1] - above[x - 1]) + Centre * (below[x] - above[x])
+                    + Side * (below[x + 1] - above[x + 1]);
+        }
+    }
+};
+
+// 2x2 diagonal differences anchored at the top-left pixel
+struct RobertsCross {
+    static constexpr bool usesAbove = false;
+    static constexpr int first = 0;
+
+    template <typename In, typename Out>
+    static void row(const In*, const In* centre, const In* below, int width, Out* gx, Out* gy) {
+        for (int x = 0; x < width - 1; ++x) {
+            gx[x] = centre[x] - below[x + 1];
+            gy[x] = below[x] - centre[x + 1];
+        }
+    }
+};
+
+// Direction of (gx, gy) in 1/256ths of a turn, before rounding, in [0, 256]. The gradient is folded into the
+// first octant, where atan(min / max) comes from a minimax polynomial accurate to about 1e-5 radians (under
+// 1e-3 of a step), and unfolded with selects instead of branches so whole rows vectorise. A zero gradient gives 0
+inline float orientationSteps(float gx, float gy) {
+    float ax = std::fabs(gx), ay = std::fabs(gy);
+    float high = std::max(ax, ay), low = std::min(ax, ay);
+    float t = low / std::max(high, 1.0f);
+    float t2 = t * t;
+    float atan = t * (0.9998660f + t2 * (-0.3302995f + t2 * (0.1801410f + t2 * (-0.0851330f + t2 * 0.0208351f))));
+    float steps = atan * static_cast<float>(128.0 / M_PI);
+    steps = ay > ax ? 64.0f - steps : steps;
+    steps = gx < 0 ? 128.0f - steps : steps;
+    return gy < 0 ? 256.0f - steps : steps;
+}
+
+// Rounds orientationSteps to the nearest step; a full turn wraps to 0
+inline unsigned char roundOrientation(float steps) {
+    return static_cast<unsigned char>(static_cast<int>(steps + 0.5f) & 255);
+}
+
+// Runs one operator over the image in row bands; either output may be null
+template <class Kernel>
+void computeBands(const Image& image, Gradient::Source source, unsigned char* magnitude, unsigned char* orientation) {
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    bool luminance = source == Gradient::Source::Luminance && channels >= 3;
+    PlaneView<const unsigned char> in = image.view();
+    size_t step = in.getPixelStride();
+
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        // Ring of three source rows; row y lives in slot y % 3. Single-channel rows are read from the image itself
+        bool contiguous = step == 1;
+        std::vector<unsigned char> ring(contiguous ? 0 : 3 * static_cast<size_t>(width));
+        int ringRow[3] = {-1, -1, -1};
+        std::vector<int32_t> gx(width), gy(width);
+
+        auto sourceRow = [&](int y) -> const unsigned char* {
+            const unsigned char* pixels = in.row(y);
+            if (contiguous) {
+                return pixels;
+            }
+            int slot = y % 3;
+            unsigned char* row = ring.data() + slot * static_cast<size_t>(width);
+            if (ringRow[slot] != y) {
+                // Luminance is converted straight into the ring slot the derivatives read
+                if (luminance) {
+                    PixelKernels::grayscale(pixels, channels, row, width);
+                } else {
+                    for (int x = 0; x < width; ++x) {
+                        row[x] = pixels[x * step];
+                    }
+                }
+                ringRow[slot] = y;
+            }
+            return row;
+        };
+
+        for (int y = yBegin; y < yEnd; ++y) {
+            unsigned char* magnitudeRow = magnitude ? magnitude + static_cast<size_t>(y) * width : nullptr;
+            unsigned char* orientationRow = orientation ? orientation + static_cast<size_t>(y) * width : nullptr;
+            int xEnd = width - 1; // Pixels [first, xEnd) have a full neighbourhood
+            if (y < Kernel::first || y >= height - 1 || xEnd <= Kernel::first) {
+                if (magnitudeRow) std::fill(magnitudeRow, magnitudeRow + width, 0);
+                if (orientationRow) std::fill(orientationRow, orientationRow + width, 0);
+                continue;
+            }
+
+            const unsigned char* above = nullptr;
+            if constexpr (Kernel::usesAbove) {
+                above = sourceRow(y - 1);
+            }
+            const unsigned char* centre = sourceRow(y);
+            const unsigned char* below = sourceRow(y + 1);
+            Kernel::row(above, centre, below, width, gx.data(), gy.data());
+
+            if (magnitudeRow) {
+                std::fill(magnitudeRow, magnitudeRow + Kernel::first, 0);
+                for (int x = Kernel::first; x < xEnd; ++x) {
+                    // Sums of squares below 255^2 are exact in float, and larger ones clamp to 255 anyway
+                    auto squared = static_cast<float>(gx[x] * gx[x] + gy[x] * gy[x]);
+                    magnitudeRow[x] = static_cast<unsigned char>(std::min(std::sqrt(squared), 255.0f));
+                }
+                magnitudeRow[xEnd] = 0;
+            }
+            if (orientationRow) {
+                std::fill(orientationRow, orientationRow + Kernel::first, 0);
+                for (int x = Kernel::first; x < xEnd; ++x) {
+                    orientationRow[x] = roundOrientation(orientationSteps(static_cast<float>(gx[x]),
+                                                                          static_cast<float>(gy[x])));
+                }
+                orientationRow[xEnd] = 0;
+            }
+        }
+    });
+}
+
+void dispatch(const Image& image, Gradient::Operator op, Gradient::Source source,
+              unsigned char* magnitude, unsigned char* orientation) {
+    switch (op) {
+        case Gradient::Operator::Sobel:
+            computeBands<CentralDifference<1, 2>>(image, source, magnitude, orientation);
+            break;
+        case Gradient::Operator::Prewitt:
+            computeBands<CentralDifference<1, 1>>(image, source, magnitude, orientation);
+            break;
+        case Gradient::Operator::Scharr:
+            computeBands<CentralDifference<3, 10>>(image, source, magnitude, orientation);
+            break;
+        case Gradient::Operator::Roberts:
+            computeBands<RobertsCross>(image, source, magnitude, orientation);
+            break;
+    }
+}
+
+// Rows per Canny tile. Each tile recomputes a halo of smoothed rows, so taller tiles waste less work
+constexpr int cannyTileRows = 64;
+
+// Classes left by non-maximum suppression
+enum EdgeState : uint8_t {
+    NotEdge = 0,
+    WeakEdge = 1,
+    StrongEdge = 2
+};
+
+// Direction of the gradient rounded to one of the four neighbour axes
+enum Sector : uint8_t {
+    AlongX = 0,     // Compare with the left and right neighbours
+    Falling = 1,    // Compare with the top-left and bottom-right neighbours
+    AlongY = 2,     // Compare with the neighbours above and below
+    Rising = 3      // Compare with the top-right and bottom-left neighbours
+};
+
+Sector gradientSector(float gx, float gy) {
+    const float tan22 = 0.41421356f; // tan(22.5 degrees)
+    const float tan67 = 2.41421356f; // tan(67.5 degrees)
+    float ax = std::fabs(gx), ay = std::fabs(gy);
+    if (ay <= ax * tan22) {
+        return AlongX;
+    }
+    if (ay >= ax * tan67) {
+        return AlongY;
+    }
+    // y grows down the image, so equal signs point towards the bottom-right
+    return (gx > 0) == (gy > 0) ? Falling : Rising;
+}
+
+// Candidate numbers are 32-bit, counted in raster order within each tile; noCandidate marks other pixels
+constexpr uint32_t noCandidate = UINT32_MAX;
+
+// Root of a union-find tree, halving the path on the way. Only safe while no other thread reads the trees
+uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// Read-only variant for the parallel labelling pass
+uint32_t findRoot(const std::vector<uint32_t>& parent, uint32_t i) {
+    while (parent[i] != i) {
+        i = parent[i];
+    }
+    return i;
+}
+
+// Joins two candidates. The smaller number becomes the root and inherits the stronger state
+void unite(std::vector<uint32_t>& parent, std::vector<uint8_t>& strength, uint32_t a, uint32_t b) {
+    uint32_t rootA = findRoot(parent, a);
+    uint32_t rootB = findRoot(parent, b);
+    if (rootA == rootB) {
+        return;
+    }
+    if (rootB < rootA) {
+        std::swap(rootA, rootB);
+    }
+    parent[rootB] = rootA;
+    strength[rootA] = std::max(strength[rootA], strength[rootB]);
+}
+
+// Joins candidate a with the candidates of the row above at x - 1, x and x + 1, numbered from offset
+void uniteWithRowAbove(std::vector<uint32_t>& parent, std::vector<uint8_t>& strength, uint32_t a,
+                       const std::vector<uint32_t>& above, uint32_t offset, int x) {
+    int width = static_cast<int>(above.size());
+    for (int dx = -1; dx <= 1; ++dx) {
+        if (x + dx >= 0 && x + dx < width && above[x + dx] != noCandidate) {
+            unite(parent, strength, a, above[x + dx] + offset);
+        }
+    }
+}
+
+// Candidates of one tile: their forest, the state of each, and the numbers on its first and last rows
+struct CannyTile {
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> strength;
+    std::vector<uint32_t> firstRow;
+    std::vector<uint32_t> lastRow;
+};
+
+} // namespace
+
+Gradient::Result Gradient::compute(const Image& image, Operator op, unsigned int outputs, Source source) {
+    Result result;
+    compute(image, op, outputs, result, source);
+    return result;
+}
+
+void Gradient::compute(const Image& image, Operator op, unsigned int outputs, Result& result, Source source) {
+    // The source is read until the last band finishes, so it must not be overwritten while computing
+    if (&image == &result.magnitude || &image == &result.orientation) {
+        Result fresh;
+        compute(image, op, outputs, fresh, source);
+        if (outputs & Magnitude) result.magnitude = std::move(fresh.magnitude);
+        if (outputs & Orientation) result.orientation = std::move(fresh.orientation);
+        return;
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    unsigned char* magnitude = nullptr;
+    unsigned char* orientation = nullptr;
+    if (outputs & Magnitude) {
+        result.magnitude.resize(width, height, 1);
+        magnitude = result.magnitude.getData();
+    }
+    if (outputs & Orientation) {
+        result.orientation.resize(width, height, 1);
+        orientation = result.orientation.getData();
+    }
+    if (magnitude || orientation) {
+        dispatch(image, op, source, magnitude, orientation);
+    }
+}
+
+void Gradient::magnitude(const Image& image, Operator op, Image& output, Source source) {
+    if (&image == &output) {
+        Image fresh;
+        magnitude(image, op, fresh, source);
+        output = std::move(fresh);
+        return;
+    }
+    output.resize(image.getWidth(), image.getHeight(), 1);
+    dispatch(image, op, source, output.getData(), nullptr);
+}
+
+unsigned char Gradient::encodeOrientation(int gx, int gy) {
+    return roundOrientation(orientationSteps(static_cast<float>(gx), static_cast<float>(gy)));
+}
+
+Image Gradient::canny(const Image& image, float lowThreshold, float highThreshold, int kernelSize, float sigma,
+                      Source source) {
+    Image output;
+    canny(image, output, lowThreshold, highThreshold, kernelSize, sigma, source);
+    return output;
+}
+
+void Gradient::canny(const Image& image, Image& output, float lowThreshold, float highThreshold, int kernelSize,
+                     float sigma, Source source) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd");
+    }
+    if (lowThreshold < 0 || lowThreshold > highThreshold) {
+        throw std::invalid_argument("Canny thresholds must satisfy 0 <= low <= high");
+    }
+    if (&image == &output) {
+        Image fresh;
+        canny(image, fresh, lowThreshold, highThreshold, kernelSize, sigma, source);
+        output = std::move(fresh);
+        return;
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    int radius = kernelSize / 2;
+    const std::vector<float>& kernel = Filter::gaussianKernel1D(kernelSize, sigma);
+    bool luminance = source == Source::Luminance && channels >= 3;
+    PlaneView<const unsigned char> in = image.view();
+    size_t step = in.getPixelStride();
+
+    // Suppression writes each pixel's EdgeState straight into the output; only candidates enter a forest, kept
+    // per tile with 32-bit numbers
+    output.resize(width, height, 1);
+    unsigned char* dst = output.getData();
+    int tileCount = (height + cannyTileRows - 1) / cannyTileRows;
+    std::vector<CannyTile> tiles(tileCount);
+
+    // Smoothing, gradient, suppression and tile-local linking, all in float buffers the size of one tile
+    Parallel::forRange(0, tileCount, [&](int tileBegin, int tileEnd) {
+        std::vector<float> intensity(width), blurred, smoothed, magnitude, gx(width), gy(width);
+        std::vector<uint8_t> sector;
+        std::vector<uint32_t> labels(width), labelsAbove(width);
+
+        for (int tile = tileBegin; tile < tileEnd; ++tile) {
+            int yBegin = tile * cannyTileRows;
+            int yEnd = std::min(height, yBegin + cannyTileRows);
+            // Suppression needs magnitudes one row either side, and each gradient row one smoothed row either side
+            int magnitudeBegin = std::max(0, yBegin - 1), magnitudeEnd = std::min(height, yEnd + 1);
+            int smoothBegin = std::max(0, yBegin - 2), smoothEnd = std::min(height, yEnd + 2);
+            int blurBegin = std::max(0, smoothBegin - radius), blurEnd = std::min(height, smoothEnd + radius);
+
+            // Horizontal pass of the Gaussian, clamped at the borders as in Filter::gaussianBlur
+            blurred.resize(static_cast<size_t>(blurEnd - blurBegin) * width);
+            for (int y = blurBegin; y < blurEnd; ++y) {
+                const unsigned char* pixels = in.row(y);
+                for (int x = 0; x < width; ++x) {
+                    const unsigned char* p = pixels + x * step;
+                    intensity[x] = luminance ? 0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2] : p[0];
+                }
+                float* out = blurred.data() + static_cast<size_t>(y - blurBegin) * width;
+                for (int x = 0; x < width; ++x) {
+                    float sum = 0.0f;
+                    for (int kx = -radius; kx <= radius; ++kx) {
+                        sum += intensity[std::clamp(x + kx, 0, width - 1)] * kernel[kx + radius];
+                    }
+                    out[x] = sum;
+                }
+            }
+
+            // Vertical pass, a whole row at a time
+            smoothed.assign(static_cast<size_t>(smoothEnd - smoothBegin) * width, 0.0f);
+            for (int y = smoothBegin; y < smoothEnd; ++y) {
+                float* out = smoothed.data() + static_cast<size_t>(y - smoothBegin) * width;
+                for (int ky = -radius; ky <= radius; ++ky) {
+                    int sourceY = std::clamp(y + ky, 0, height - 1);
+                    const float* row = blurred.data() + static_cast<size_t>(sourceY - blurBegin) * width;
+                    float weight = kernel[ky + radius];
+                    for (int x = 0; x < width; ++x) {
+                        out[x] += row[x] * weight;
+                    }
+                }
+            }
+
+            // Sobel magnitude and direction sector; pixels without a full neighbourhood have no gradient
+            magnitude.assign(static_cast<size_t>(magnitudeEnd - magnitudeBegin) * width, 0.0f);
+            sector.assign(magnitude.size(), AlongX);
+            for (int y = std::max(1, magnitudeBegin); y < std::min(height - 1, magnitudeEnd); ++y) {
+                auto smoothRow = [&](int row) { return smoothed.data() + static_cast<size_t>(row - smoothBegin) * width; };
+                CentralDifference<1, 2>::row(smoothRow(y - 1), smoothRow(y), smoothRow(y + 1), width,
+                                             gx.data(), gy.data());
+                size_t offset = static_cast<size_t>(y - magnitudeBegin) * width;
+                for (int x = 1; x < width - 1; ++x) {
+                    magnitude[offset + x] = std::sqrt(gx[x] * gx[x] + gy[x] * gy[x]);
+                    sector[offset + x] = gradientSector(gx[x], gy[x]);
+                }
+            }
+
+            // Non-maximum suppression and double threshold, numbering each candidate and linking it to its
+            // 8-connected neighbours on the left and in the row above; no other tile touches these trees yet.
+            // Rows 0 and height - 1 have zero magnitude throughout
+            CannyTile& candidates = tiles[tile];
+            for (int y = yBegin; y < yEnd; ++y) {
+                unsigned char* states = dst + static_cast<size_t>(y) * width;
+                std::fill(states, states + width, NotEdge);
+                std::fill(labels.begin(), labels.end(), noCandidate);
+                if (y > 0 && y < height - 1) {
+                    const float* centre = magnitude.data() + static_cast<size_t>(y - magnitudeBegin) * width;
+                    const float* above = centre - width;
+                    const float* below = centre + width;
+                    const uint8_t* sectors = sector.data() + static_cast<size_t>(y - magnitudeBegin) * width;
+                    for (int x = 1; x < width - 1; ++x) {
+                        float m = centre[x];
+                        if (m < lowThreshold || m == 0.0f) {
+                            continue;
+                        }
+                        float first, second;
+                        switch (sectors[x]) {
+                            case AlongX:  first = centre[x - 1]; second = centre[x + 1]; break;
+                            case Falling: first = above[x - 1];  second = below[x + 1];  break;
+                            case AlongY:  first = above[x];      second = below[x];      break;
+                            default:      first = above[x + 1];  second = below[x - 1];  break;
+                        }
+                        // Strict on one side so a plateau two pixels wide keeps exactly one of them
+                        if (!(m > first && m >= second)) {
+                            continue;
+                        }
+                        auto label = static_cast<uint32_t>(candidates.parent.size());
+                        states[x] = m >= highThreshold ? StrongEdge : WeakEdge;
+                        labels[x] = label;
+                        candidates.parent.push_back(label);
+                        candidates.strength.push_back(states[x]);
+                        if (labels[x - 1] != noCandidate) {
+                            unite(candidates.parent, candidates.strength, label, labels[x - 1]);
+                        }
+                        if (y > yBegin) {
+                            uniteWithRowAbove(candidates.parent, candidates.strength, label, labelsAbove, 0, x);
+                        }
+                    }
+                }
+                if (y == yBegin) {
+                    candidates.firstRow = labels;
+                }
+                labels.swap(labelsAbove);
+            }
+            candidates.lastRow = labelsAbove;
+        }
+    }, 1);
+
+    // Number every tile's candidates after those of the tiles above, in one forest
+    std::vector<uint32_t> offsets(tileCount);
+    size_t total = 0;
+    for (int tile = 0; tile < tileCount; ++tile) {
+        if (total + tiles[tile].parent.size() >= noCandidate) {
+            throw std::runtime_error("Too many Canny edge candidates to number in 32 bits");
+        }
+        offsets[tile] = static_cast<uint32_t>(total);
+        total += tiles[tile].parent.size();
+    }
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> strength;
+    parent.reserve(total);
+    strength.reserve(total);
+    for (int tile = 0; tile < tileCount; ++tile) {
+        for (uint32_t p : tiles[tile].parent) {
+            parent.push_back(p + offsets[tile]);
+        }
+        strength.insert(strength.end(), tiles[tile].strength.begin(), tiles[tile].strength.end());
+        std::vector<uint32_t>().swap(tiles[tile].parent);
+        std::vector<uint8_t>().swap(tiles[tile].strength);
+    }
+
+    // Join components across tile seams; only one row pair per seam, so this runs serially
+    for (int tile = 1; tile < tileCount; ++tile) {
+        const std::vector<uint32_t>& firstRow = tiles[tile].firstRow;
+        for (int x = 0; x < width; ++x) {
+            if (firstRow[x] != noCandidate) {
+                uniteWithRowAbove(parent, strength, firstRow[x] + offsets[tile], tiles[tile - 1].lastRow,
+                                  offsets[tile - 1], x);
+            }
+        }
+    }
+
+    // Hysteresis: a candidate is an edge when its component holds a strong pixel, recorded at the root.
+    // Each tile meets its candidates in the order they were numbered
+    const std::vector<uint32_t>& forest = parent;
+    Parallel::forRange(0, tileCount, [&](int tileBegin, int tileEnd) {
+        for (int tile = tileBegin; tile < tileEnd; ++tile) {
+            uint32_t label = offsets[tile];
+            size_t end = static_cast<size_t>(std::min(height, (tile + 1) * cannyTileRows)) * width;
+            for (size_t i = static_cast<size_t>(tile) * cannyTileRows * width; i < end; ++i) {
+                if (dst[i] != NotEdge) {
+                    dst[i] = strength[findRoot(forest, label++)] == StrongEdge ? 255 : 0;
+                }
+            }
+        }
+    }, 1);
+}
@@ -0,0 +1,207 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Histogram.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Number of interleaved sub-histograms each run is counted into
+constexpr int histogramLanes = 4;
+
+// Values counted before the 32-bit lane counters are flushed, well below their limit
+constexpr size_t laneFlushInterval = size_t(1) << 30;
+
+// Fewer values count straight into the result, since clearing and merging the lanes would cost more than
+// the stalls they avoid
+constexpr size_t shortRunLength = 1024;
+
+// Counts row bands in parallel, each into a private histogram, and merges the bands at the end
+template <typename CountBand>
+Histogram::Counts countBands(int height, CountBand&& countBand) {
+    Histogram::Counts total{};
+    std::mutex totalMutex;
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        Histogram::Counts band{};
+        countBand(yBegin, yEnd, band);
+        std::lock_guard<std::mutex> lock(totalMutex);
+        for (int i = 0; i < 256; ++i) {
+            total[i] += band[i];
+        }
+    });
+    return total;
+}
+
+} // namespace
+
+void Histogram::accumulate(const unsigned char* src, size_t stride, size_t count, Counts& counts) {
+    accumulate(src, stride, count, 1, 0, counts);
+}
+
+void Histogram::accumulate(const unsigned char* src, size_t stride, size_t count, size_t rows, size_t rowStride,
+                           Counts& counts) {
+    if (count * rows < shortRunLength) {
+        for (size_t row = 0; row < rows; ++row) {
+            const unsigned char* values = src + row * rowStride;
+            for (size_t i = 0; i < count; ++i) {
+                counts[values[i * stride]]++;
+            }
+        }
+        return;
+    }
+
+    // The lanes are flushed after whole rows, or within a row that alone would overflow them
+    uint32_t lanes[histogramLanes][256];
+    size_t row = 0;
+    size_t offset = 0;
+    while (row < rows) {
+        std::fill(&lanes[0][0], &lanes[0][0] + histogramLanes * 256, 0u);
+        size_t counted = 0;
+        while (row < rows && counted < laneFlushInterval) {
+            size_t chunk = std::min(count - offset, laneFlushInterval - counted);
+            const unsigned char* values = src + row * rowStride + offset * stride;
+            size_t i = 0;
+            for (; i + histogramLanes <= chunk; i += histogramLanes) {
+                lanes[0][values[i * stride]]++;
+                lanes[1][values[(i + 1) * stride]]++;
+                lanes[2][values[(i + 2) * stride]]++;
+                lanes[3][values[(i + 3) * stride]]++;
+            }
+            for (; i < chunk; ++i) {
+                lanes[0][values[i * stride]]++;
+            }
+            counted += chunk;
+            offset += chunk;
+            if (offset == count) {
+                offset = 0;
+                ++row;
+            }
+        }
+
+        for (int v = 0; v < 256; ++v) {
+            counts[v] += static_cast<size_t>(lanes[0][v]) + lanes[1][v] + lanes[2][v] + lanes[3][v];
+        }
+    }
+}
+
+Histogram::Counts Histogram::compute(const Image& image, int channel) {
+    if (channel < 0 || channel >= image.getChannels()) {
+        throw std::out_of_range("Channel index is out of range.");
+    }
+    int width = image.getWidth();
+    int channels = image.getChannels();
+    const unsigned char* data = image.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    return countBands(image.getHeight(), [&](int yBegin, int yEnd, Counts& band) {
+        // Rows are contiguous, so a band is one run of values
+        accumulate(data + yBegin * rowStride + channel, channels, static_cast<size_t>(yEnd - yBegin) * width, band);
+    });
+}
+
+Histogram::Counts Histogram::computeBrightness(const Image& image, bool isHSV) {
+    int channels = image.getChannels();
+    if (channels < 3) {
+        throw std::invalid_argument("Brightness histograms require an image with at least 3 channels.");
+    }
+    int width = image.getWidth();
+    const unsigned char* data = image.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    return countBands(image.getHeight(), [&](int yBegin, int yEnd, Counts& band) {
+        std::vector<unsigned char> brightness(width);
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* row = data + y * rowStride;
+            if (isHSV) {
+                PixelKernels::rgbToValue(row, channels, brightness.data(), width);
+            } else {
+                PixelKernels::rgbToLightness(row, channels, brightness.data(), width);
+            }
+            accumulate(brightness.data(), 1, width, band);
+        }
+    });
+}
+
+Histogram::Table Histogram::equalisationTable(const Counts& counts) {
+    size_t cdf[256];
+    size_t total = 0;
+    for (int i = 0; i < 256; ++i) {
+        total += counts[i];
+        cdf[i] = total;
+    }
+
+    // Count of the lowest occupied value
+    size_t minCDF = 0;
+    for (int i = 0; i < 256; ++i) {
+        if (cdf[i] != 0) {
+            minCDF = cdf[i];
+            break;
+        }
+    }
+
+    Table table{};
+    if (total == minCDF) {
+        return table; // Empty, or a single value
+    }
+    double range = static_cast<double>(total) - static_cast<double>(minCDF);
+    for (int i = 0; i < 256; ++i) {
+        table[i] = cdf[i] < minCDF ? 0 : static_cast<unsigned char>(255.0 * static_cast<double>(cdf[i] - minCDF) / range);
+    }
+    return table;
+}
+
+Histogram::Table Histogram::clippedEqualisationTable(Counts counts, double clipLimit) {
+    if (!(clipLimit > 0)) {
+        throw std::invalid_argument("Clip limit must be positive.");
+    }
+    size_t total = 0;
+    for (size_t count : counts) {
+        total += count;
+    }
+    Table table{};
+    if (total == 0) {
+        return table;
+    }
+
+    // Clip every bin, then hand the excess back evenly, the remainder one count at a time across the range
+    double limitValue = std::max(1.0, clipLimit * static_cast<double>(total) / 256.0);
+    size_t limit = limitValue >= static_cast<double>(total) ? total : static_cast<size_t>(limitValue);
+    size_t excess = 0;
+    for (size_t& count : counts) {
+        if (count > limit) {
+            excess += count - limit;
+            count = limit;
+        }
+    }
+    size_t share = excess / 256;
+    size_t remainder = excess % 256;
+    size_t step = remainder > 0 ? std::max<size_t>(256 / remainder, 1) : 256;
+    for (size_t i = 0; i < 256; ++i) {
+        counts[i] += share + (remainder > 0 && i % step == 0 && i / step < remainder ? 1 : 0);
+    }
+
+    double scale = 255.0 / static_cast<double>(total);
+    size_t cdf = 0;
+    for (int i = 0; i < 256; ++i) {
+        cdf += counts[i];
+        table[i] = static_cast<unsigned char>(std::min(255.0, std::round(static_cast<double>(cdf) * scale)));
+    }
+    return table;
+}
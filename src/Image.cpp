@@ -12,8 +12,15 @@
 
 #include "Image.h"
 
+#include <new>
+#include <utility>
+
+// stb_image allocates with the C allocator, the same one Image::BufferDeleter releases with
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size) std::malloc(size)
+#define STBI_REALLOC(pointer, newSize) std::realloc(pointer, newSize)
+#define STBI_FREE(pointer) std::free(pointer)
 #include "stb_image.h"
 #endif
 
@@ -22,10 +29,21 @@
 #include "stb_image_write.h"
 #endif
 
-Image::Image(const std::string &filename)
+Image::Buffer Image::allocateBuffer(size_t size)
+{
+    // malloc(0) may return nullptr, so always ask for at least one byte
+    auto* buffer = static_cast<unsigned char*>(std::malloc(size == 0 ? 1 : size));
+    if (!buffer)
+    {
+        throw std::bad_alloc();
+    }
+    return Buffer(buffer);
+}
+
+Image::Image(const std::string &filename) : width(0), height(0), channels(0)
 {
-    // Load image data from file using stbi_load function
-    data = stbi_load(filename.c_str(), &width, &height, &channels, STBI_default);
+    // Load image data from file using stbi_load function; the buffer is adopted without copying
+    data.reset(stbi_load(filename.c_str(), &width, &height, &channels, STBI_default));
     if (!data)
     {
         // Throws a runtime error if the image cannot be loaded (e.g. file not found, invalid format, etc.)
@@ -33,32 +51,37 @@ Image::Image(const std::string &filename)
     }
 }
 
-Image::Image(int width, int height, int channels) : width(width), height(height), channels(channels)
+Image::Image(int width, int height, int channels)
+        : width(width), height(height), channels(channels), data(allocateBuffer(getSize()))
 {
-    // Allocate memory for image data
-    data = new unsigned char[width * height * channels];
 }
 
-Image::Image(const Image &inputImg) : width(inputImg.width), height(inputImg.height), channels(inputImg.channels)
+Image::Image(const Image &inputImg)
+        : width(inputImg.width), height(inputImg.height), channels(inputImg.channels), data(allocateBuffer(getSize()))
 {
-    // Allocate memory for image data based on input image size
-    size_t dataSize = width * height * channels;
-    data = new unsigned char[dataSize];
-    for (size_t i = 0; i < dataSize; ++i)
+    // Copy image data from input image to new image
+    if (inputImg.data)
     {
-        // Copy image data from input image to new image
-        data[i] = inputImg.data[i];
+        std::memcpy(data.get(), inputImg.data.get(), getSize());
     }
 }
 
+Image::Image(Image &&inputImg) noexcept
+        : width(inputImg.width), height(inputImg.height), channels(inputImg.channels), data(std::move(inputImg.data))
+{
+    inputImg.width = 0;
+    inputImg.height = 0;
+    inputImg.channels = 0;
+}
+
 // Default constructor initializes an empty image with zero width, height, and channels
-Image::Image() : width(0), height(0), channels(0), data(nullptr) {}
+Image::Image() : width(0), height(0), channels(0) {}
 
 Image::Image(int width, int height, int channels, const unsigned char* pixelData)
-        : width(width), height(height), channels(channels), data(new unsigned char[width * height * channels]) {
+        : width(width), height(height), channels(channels), data(allocateBuffer(getSize())) {
     // Copy the pixel data into this Image's data array
     if (pixelData != nullptr) {
-        std::memcpy(data, pixelData, width * height * channels);
+        std::memcpy(data.get(), pixelData, getSize());
     }
 }
 
@@ -67,63 +90,88 @@ Image &Image::operator=(const Image &inputImg)
     // Check for self-assignment
     if (this != &inputImg)
     {
-        // Free existing memory
-        delete[] data;
-        // Set image dimensions and allocate memory for new image data
+        // Reuse the existing buffer when the sizes match, otherwise allocate a new one
+        if (!inputImg.data)
+        {
+            data.reset();
+        }
+        else
+        {
+            if (!data || getSize() != inputImg.getSize())
+            {
+                data = allocateBuffer(inputImg.getSize());
+            }
+            std::memcpy(data.get(), inputImg.data.get(), inputImg.getSize());
+        }
         width = inputImg.width;
         height = inputImg.height;
         channels = inputImg.channels;
-        size_t dataSize = width * height * channels;
-        data = new unsigned char[dataSize];
-
-        // Copy image data from input image to this image
-        for (size_t i = 0; i < dataSize; ++i)
-        {
-            data[i] = inputImg.data[i];
-        }
+    }
+    return *this;
+}
 
+Image &Image::operator=(Image &&inputImg) noexcept
+{
+    if (this != &inputImg)
+    {
+        data = std::move(inputImg.data);
+        width = inputImg.width;
+        height = inputImg.height;
+        channels = inputImg.channels;
+        inputImg.width = 0;
+        inputImg.height = 0;
+        inputImg.channels = 0;
     }
     return *this;
 }
 
-Image::~Image()
+// The buffer is released by the unique_ptr
+Image::~Image() = default;
+
+void Image::swap(Image &other) noexcept
 {
-    // Free memory allocated for image data
-    delete[] data;
-    data = nullptr;
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(channels, other.channels);
+    std::swap(data, other.data);
 }
 
-int Image::getWidth() const
+void Image::resize(int newWidth, int newHeight, int newChannels)
 {
-    return width;
+    size_t newSize = static_cast<size_t>(newWidth) * newHeight * newChannels;
+    if (!data || newSize != getSize())
+    {
+        data = allocateBuffer(newSize);
+    }
+    width = newWidth;
+    height = newHeight;
+    channels = newChannels;
 }
 
-int Image::getHeight() const
+size_t Image::getSize() const
 {
-    return height;
+    return static_cast<size_t>(width) * height * channels;
 }
 
-int Image::getChannels() const
+int Image::getWidth() const
 {
-    return channels;
+    return width;
 }
 
-unsigned char Image::getPixel(int x, int y, int channel) const
+int Image::getHeight() const
 {
-    // Return pixel value at specified coordinates and channel
-    return data[(y * width + x) * channels + channel];
+    return height;
 }
 
-void Image::setPixel(int x, int y, int channel, unsigned char value)
+int Image::getChannels() const
 {
-    // Set pixel value at specified coordinates and channel
-    data[(y * width + x) * channels + channel] = value;
+    return channels;
 }
 
 void Image::save(const std::string &filename) const
 {
     // Save image data to file using stbi_write_png function
-    int success = stbi_write_png(filename.c_str(), width, height, channels, data, STBI_default);
+    int success = stbi_write_png(filename.c_str(), width, height, channels, data.get(), STBI_default);
     if (!success)
     {
         // Throws a runtime error if the image cannot be saved (e.g. invalid filename, insufficient permissions, etc.)
@@ -138,12 +186,14 @@ void Image::setData(const unsigned char* newData) {
         throw std::invalid_argument("New data pointer is null.");
     }
 
-    // Copy new image data to this image
-    size_t dataSize = width * height * channels;
     // Copy the new data to the internal data buffer of the image
-    std::memcpy(data, newData, dataSize);
+    std::memcpy(data.get(), newData, getSize());
 }
 
 const unsigned char* Image::getData() const {
-    return data;
-}
\ No newline at end of file
+    return data.get();
+}
+
+unsigned char* Image::getData() {
+    return data.get();
+}
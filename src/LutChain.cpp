@@ -0,0 +1,181 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "LutChain.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+LutChain::Table identityTable() {
+    LutChain::Table table{};
+    for (int v = 0; v < 256; ++v) {
+        table[v] = static_cast<unsigned char>(v);
+    }
+    return table;
+}
+
+bool isIdentity(const LutChain::Table& table) {
+    for (int v = 0; v < 256; ++v) {
+        if (table[v] != v) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+LutChain::LutChain() : before(identityTable()), after(identityTable()) {}
+
+LutChain& LutChain::brightness(int value) {
+    if (value < -255 || value > 255) {
+        throw std::invalid_argument("Brightness value must be in the range [-255, 255]");
+    }
+    Table table{};
+    for (int v = 0; v < 256; ++v) {
+        table[v] = static_cast<unsigned char>(std::max(0, std::min(v + value, 255)));
+    }
+    append(table);
+    return *this;
+}
+
+LutChain& LutChain::gamma(double gamma) {
+    if (!(gamma > 0)) {
+        throw std::invalid_argument("Gamma must be positive.");
+    }
+    Table table{};
+    for (int v = 0; v < 256; ++v) {
+        double scaled = 255.0 * std::pow(v / 255.0, 1.0 / gamma);
+        table[v] = static_cast<unsigned char>(std::min(255L, std::lround(scaled)));
+    }
+    append(table);
+    return *this;
+}
+
+LutChain& LutChain::threshold(double thresholdValue) {
+    // A threshold of a multi-channel image reads channel 0
+    if (reduction == Reduction::None) {
+        reduction = Reduction::FirstChannel;
+    }
+    Table table{};
+    for (int v = 0; v < 256; ++v) {
+        table[v] = v >= thresholdValue ? 255 : 0;
+    }
+    append(table);
+    return *this;
+}
+
+LutChain& LutChain::grayscale() {
+    if (reduction == Reduction::None) {
+        reduction = Reduction::Grayscale;
+    }
+    return *this;
+}
+
+LutChain& LutChain::map(const Table& table) {
+    append(table);
+    return *this;
+}
+
+const LutChain::Table& LutChain::getBefore() const {
+    return before;
+}
+
+LutChain::Reduction LutChain::getReduction() const {
+    return reduction;
+}
+
+const LutChain::Table& LutChain::getAfter() const {
+    return after;
+}
+
+void LutChain::append(const Table& table) {
+    Table& target = reduction == Reduction::None ? before : after;
+    for (unsigned char& value : target) {
+        value = table[value];
+    }
+}
+
+Image LutChain::apply(const Image& image) const {
+    Image output;
+    apply(image, output);
+    return output;
+}
+
+void LutChain::apply(const Image& image, Image& output) const {
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    const unsigned char* src = image.getData();
+
+    // Without a reduction, on a single-channel image or keeping channel 0, both tables compose into one
+    Table combined{};
+    for (int v = 0; v < 256; ++v) {
+        combined[v] = after[before[v]];
+    }
+
+    // Without a reduction, or on a single-channel image, the whole chain is one table over contiguous bytes,
+    // which also works in place
+    if (reduction == Reduction::None || channels == 1) {
+        output.resize(width, height, channels);
+        unsigned char* dst = output.getData();
+        size_t rowBytes = static_cast<size_t>(width) * channels;
+        Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+            size_t first = static_cast<size_t>(yBegin) * rowBytes;
+            PixelKernels::lookup(src + first, dst + first, 1, (yEnd - yBegin) * rowBytes, combined.data());
+        });
+        return;
+    }
+
+    if (reduction == Reduction::Grayscale && channels != 3 && channels != 4) {
+        throw std::invalid_argument("Image must have 1, 3, or 4 channels to be converted to grayscale");
+    }
+    if (&image == &output) {
+        Image result;
+        apply(image, result);
+        output = std::move(result);
+        return;
+    }
+
+    output.resize(width, height, 1);
+    unsigned char* dst = output.getData();
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    bool mapBefore = !isIdentity(before);
+    bool mapAfter = !isIdentity(after);
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<unsigned char> mapped(mapBefore ? rowBytes : 0);
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* row = src + y * rowBytes;
+            unsigned char* out = dst + static_cast<size_t>(y) * width;
+            if (reduction == Reduction::FirstChannel) {
+                // Channel 0 is gathered into the output row, then goes through the combined table in place
+                PixelKernels::firstChannel(row, channels, out, width);
+                PixelKernels::lookup(out, out, 1, width, combined.data());
+                continue;
+            }
+            if (mapBefore) {
+                PixelKernels::lookup(row, mapped.data(), 1, rowBytes, before.data());
+                row = mapped.data();
+            }
+            PixelKernels::grayscale(row, channels, out, width);
+            if (mapAfter) {
+                PixelKernels::lookup(out, out, 1, width, after.data());
+            }
+        }
+    });
+}
@@ -0,0 +1,240 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Set while a thread is executing a band, used to run nested loops serially
+thread_local bool insideRegion = false;
+
+// One parallel loop shared between the caller and the workers
+struct Job {
+    const std::function<void(int, int)>* body = nullptr;
+    int end = 0;
+    int grain = 1;
+    // Wider than the range so claiming past an end near INT_MAX cannot wrap
+    std::atomic<long long> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Claim bands until the range is exhausted
+void drain(Job& job) {
+    bool wasInside = insideRegion;
+    insideRegion = true;
+    while (true) {
+        long long start = job.next.fetch_add(job.grain);
+        if (start >= job.end) {
+            break;
+        }
+        long long stop = std::min<long long>(job.end, start + job.grain);
+        try {
+            (*job.body)(static_cast<int>(start), static_cast<int>(stop));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.errorMutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+            // Stop handing out further bands
+            job.next.store(job.end);
+        }
+    }
+    insideRegion = wasInside;
+}
+
+int defaultThreadCount() {
+    if (const char* env = std::getenv("ZIGGURAT_THREADS")) {
+        int requested = std::atoi(env);
+        if (requested > 0) {
+            return requested;
+        }
+    }
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+// Persistent pool of (threadCount - 1) workers; the calling thread is the last member
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    ~WorkerPool() {
+        stopWorkers();
+    }
+
+    int threadCount() const {
+        return size.load();
+    }
+
+    void resize(int count) {
+        // Wait for any running loop to finish before touching the workers
+        std::lock_guard<std::mutex> runLock(runMutex);
+        stopWorkers();
+        startWorkers(std::max(1, count));
+    }
+
+    // Returns false if the pool is busy with another caller's loop
+    bool tryRun(Job& job) {
+        std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+        if (!runLock.owns_lock()) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &job;
+            pending = static_cast<int>(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+
+        drain(job);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+        return true;
+    }
+
+private:
+    WorkerPool() {
+        startWorkers(defaultThreadCount());
+    }
+
+    void startWorkers(int count) {
+        stopping = false;
+        size.store(count);
+        // Workers start from the current generation so a job posted before they get scheduled is not missed
+        unsigned long startGeneration = generation;
+        for (int i = 1; i < count; ++i) {
+            workers.emplace_back([this, startGeneration] { workerLoop(startGeneration); });
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    void workerLoop(unsigned long seen) {
+        while (true) {
+            Job* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                job = current;
+            }
+            drain(*job);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::atomic<int> size{1};
+    std::mutex mutex;     ///< Guards the job hand-off state below
+    std::mutex runMutex;  ///< Held by the caller for the duration of one loop
+    std::condition_variable wake;
+    std::condition_variable done;
+    Job* current = nullptr;
+    unsigned long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+} // namespace
+
+void Parallel::setThreadCount(int count) {
+    // Resizing waits for the running loop to finish, which a band of that loop would never do
+    if (insideRegion) {
+        throw std::logic_error("Parallel::setThreadCount cannot be called from inside a parallel loop");
+    }
+    WorkerPool::instance().resize(count <= 0 ? defaultThreadCount() : count);
+}
+
+int Parallel::getThreadCount() {
+    return WorkerPool::instance().threadCount();
+}
+
+bool Parallel::inParallelRegion() {
+    return insideRegion;
+}
+
+void Parallel::forRange(int begin, int end, const std::function<void(int, int)>& body, int grain) {
+    if (end <= begin) {
+        return;
+    }
+
+    long long count = static_cast<long long>(end) - begin;
+    int threads = insideRegion ? 1 : getThreadCount();
+    if (grain <= 0) {
+        // A few bands per thread keeps every core busy when bands take uneven time
+        grain = static_cast<int>(std::max<long long>(1, count / (threads * 4LL)));
+    }
+
+    // Not worth waking the pool: run on the calling thread
+    if (threads == 1 || count <= grain) {
+        bool wasInside = insideRegion;
+        insideRegion = true;
+        try {
+            body(begin, end);
+        } catch (...) {
+            insideRegion = wasInside;
+            throw;
+        }
+        insideRegion = wasInside;
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.end = end;
+    job.grain = grain;
+    job.next.store(begin);
+
+    if (!WorkerPool::instance().tryRun(job)) {
+        // Another thread owns the pool; do the work here rather than queueing behind it
+        drain(job);
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
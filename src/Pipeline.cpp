@@ -0,0 +1,386 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Pipeline.h"
+#include "Filter.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Splits text at every delimiter, trimming surrounding whitespace from each part
+std::vector<std::string> split(const std::string& text, char delimiter) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (true) {
+        size_t stop = text.find(delimiter, start);
+        std::string part = text.substr(start, stop == std::string::npos ? std::string::npos : stop - start);
+        size_t first = part.find_first_not_of(" \t");
+        size_t last = part.find_last_not_of(" \t");
+        parts.push_back(first == std::string::npos ? "" : part.substr(first, last - first + 1));
+        if (stop == std::string::npos) {
+            return parts;
+        }
+        start = stop + 1;
+    }
+}
+
+// Parses a whole argument as a number, rejecting trailing characters
+double parseNumber(const std::string& text, const std::string& step) {
+    size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (text.empty() || used != text.size()) {
+        throw std::invalid_argument("Invalid number '" + text + "' in pipeline step '" + step + "'");
+    }
+    return value;
+}
+
+int parseKernelSize(const std::string& text, const std::string& step) {
+    double value = parseNumber(text, step);
+    if (value < 1 || value > 255 || value != static_cast<int>(value) || static_cast<int>(value) % 2 == 0) {
+        throw std::invalid_argument("Kernel size in pipeline step '" + step + "' must be an odd integer from 1 to 255");
+    }
+    return static_cast<int>(value);
+}
+
+// Reads the optional colour-space argument of threshold and equalize
+bool parseColourSpace(const std::string& text, const std::string& step) {
+    if (text == "hsv") {
+        return true;
+    }
+    if (text == "hsl") {
+        return false;
+    }
+    throw std::invalid_argument("Colour space in pipeline step '" + step + "' must be 'hsv' or 'hsl'");
+}
+
+} // namespace
+
+Pipeline Pipeline::parse(const std::string& specification) {
+    Pipeline pipeline;
+    for (const std::string& text : split(specification, ',')) {
+        if (text.empty()) {
+            throw std::invalid_argument("Empty step in pipeline '" + specification + "'");
+        }
+
+        std::vector<std::string> fields = split(text, ':');
+        std::string name = fields[0];
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        std::vector<std::string> args(fields.begin() + 1, fields.end());
+
+        auto expectArguments = [&](size_t minimum, size_t maximum) {
+            if (args.size() < minimum || args.size() > maximum) {
+                throw std::invalid_argument("Wrong number of arguments in pipeline step '" + text + "'");
+            }
+        };
+
+        Step step{Operation::Grayscale};
+        if (name == "grayscale") {
+            expectArguments(0, 0);
+        } else if (name == "brightness") {
+            expectArguments(1, 1);
+            if (args[0] == "auto") {
+                step.operation = Operation::AutoBrightness;
+            } else {
+                step.operation = Operation::Brightness;
+                step.value = parseNumber(args[0], text);
+                if (step.value < -255 || step.value > 255 || step.value != static_cast<int>(step.value)) {
+                    throw std::invalid_argument("Brightness in pipeline step '" + text + "' must be an integer from -255 to 255");
+                }
+            }
+        } else if (name == "gamma") {
+            expectArguments(1, 1);
+            step.operation = Operation::Gamma;
+            step.value = parseNumber(args[0], text);
+            if (step.value <= 0) {
+                throw std::invalid_argument("Gamma in pipeline step '" + text + "' must be positive");
+            }
+        } else if (name == "equalize") {
+            expectArguments(0, 1);
+            step.operation = Operation::Equalize;
+            step.isHSV = !args.empty() && parseColourSpace(args[0], text);
+        } else if (name == "clahe") {
+            expectArguments(0, 2);
+            step.operation = Operation::AdaptiveEqualize;
+            step.value = args.empty() ? 2.0 : parseNumber(args[0], text);
+            if (step.value <= 0) {
+                throw std::invalid_argument("Clip limit in pipeline step '" + text + "' must be positive");
+            }
+            double tiles = args.size() < 2 ? 8.0 : parseNumber(args[1], text);
+            if (tiles < 1 || tiles > 256 || tiles != static_cast<int>(tiles)) {
+                throw std::invalid_argument("Tile count in pipeline step '" + text + "' must be an integer from 1 to 256");
+            }
+            step.tiles = static_cast<int>(tiles);
+        } else if (name == "threshold") {
+            expectArguments(1, 2);
+            step.operation = Operation::Threshold;
+            step.value = parseNumber(args[0], text);
+            if (step.value < 0 || step.value > 255) {
+                throw std::invalid_argument("Threshold in pipeline step '" + text + "' must be from 0 to 255");
+            }
+            if (args.size() == 2) {
+                step.rgb = true;
+                step.isHSV = parseColourSpace(args[1], text);
+            }
+        } else if (name == "saltpepper") {
+            expectArguments(1, 1);
+            step.operation = Operation::SaltAndPepper;
+            step.value = parseNumber(args[0], text);
+            if (step.value < 0 || step.value > 1) {
+                throw std::invalid_argument("Noise proportion in pipeline step '" + text + "' must be from 0 to 1");
+            }
+        } else if (name == "median" || name == "box") {
+            expectArguments(1, 1);
+            step.operation = name == "median" ? Operation::MedianBlur : Operation::BoxBlur;
+            step.kernelSize = parseKernelSize(args[0], text);
+        } else if (name == "gaussian") {
+            expectArguments(2, 2);
+            step.operation = Operation::GaussianBlur;
+            step.kernelSize = parseKernelSize(args[0], text);
+            step.value = parseNumber(args[1], text);
+            if (step.value <= 0) {
+                throw std::invalid_argument("Sigma in pipeline step '" + text + "' must be positive");
+            }
+        } else if (name == "sobel" || name == "prewitt" || name == "scharr" || name == "roberts") {
+            expectArguments(0, 0);
+            step.operation = name == "sobel"     ? Operation::Sobel
+                           : name == "prewitt"   ? Operation::Prewitt
+                           : name == "scharr"    ? Operation::Scharr
+                                                 : Operation::RobertsCross;
+        } else if (name == "canny") {
+            expectArguments(2, 2);
+            step.operation = Operation::Canny;
+            step.value = parseNumber(args[0], text);
+            step.upperValue = parseNumber(args[1], text);
+            if (step.value < 0 || step.value > step.upperValue) {
+                throw std::invalid_argument("Thresholds in pipeline step '" + text + "' must satisfy 0 <= low <= high");
+            }
+        } else {
+            throw std::invalid_argument("Unknown pipeline step '" + fields[0] + "'");
+        }
+        pipeline.steps.push_back(step);
+    }
+    return pipeline;
+}
+
+const std::vector<Pipeline::Step>& Pipeline::getSteps() const {
+    return steps;
+}
+
+void Pipeline::applyStep(const Step& step, Image& image, Image& scratch, unsigned int seed) {
+    switch (step.operation) {
+        // Point operations that rewrite the working image in place
+        case Operation::Brightness:
+            Filter::setBrightness(image, image, static_cast<int>(step.value));
+            return;
+        case Operation::AutoBrightness:
+            Filter::setBrightness(image, image, 0, true);
+            return;
+        case Operation::Gamma:
+            Filter::adjustGamma(image, image, step.value);
+            return;
+        case Operation::SaltAndPepper:
+            image = Filter::salt_and_pepper(std::move(image), step.value, true, seed);
+            return;
+
+        // Everything else writes into the scratch image, which then becomes the working image
+        case Operation::Grayscale:
+            Filter::grayScale(image, scratch);
+            break;
+        case Operation::Equalize:
+            Filter::histogramEqualization(image, scratch, step.isHSV);
+            break;
+        case Operation::AdaptiveEqualize:
+            Filter::adaptiveHistogramEqualization(image, scratch, step.value, step.tiles, step.tiles);
+            break;
+        case Operation::Threshold:
+            Filter::threshold(image, scratch, step.value, step.rgb, step.isHSV);
+            break;
+        case Operation::MedianBlur:
+            // Same result as Filter::medianBlur at a cost that does not grow with the kernel
+            Filter::constantTimeMedianBlur(image, scratch, step.kernelSize);
+            break;
+        case Operation::BoxBlur:
+            Filter::boxBlur(image, scratch, step.kernelSize);
+            break;
+        case Operation::GaussianBlur:
+            Filter::gaussianBlur(image, scratch, step.kernelSize, static_cast<float>(step.value));
+            break;
+        case Operation::Sobel:
+            Filter::applySobelOperator(image, scratch);
+            break;
+        case Operation::Prewitt:
+            Filter::applyPrewittOperator(image, scratch);
+            break;
+        case Operation::Scharr:
+            Filter::applyScharrOperator(image, scratch);
+            break;
+        case Operation::RobertsCross:
+            Filter::applyRobertsCrossOperator(image, scratch);
+            break;
+        case Operation::Canny:
+            Filter::applyCannyEdgeDetector(image, scratch, static_cast<float>(step.value),
+                                           static_cast<float>(step.upperValue));
+            break;
+    }
+    image.swap(scratch);
+}
+
+bool Pipeline::appendPointwise(const Step& step, LutChain& chain) {
+    switch (step.operation) {
+        case Operation::Brightness:
+            chain.brightness(static_cast<int>(step.value));
+            return true;
+        case Operation::Gamma:
+            chain.gamma(step.value);
+            return true;
+        case Operation::Grayscale:
+            chain.grayscale();
+            return true;
+        case Operation::Threshold:
+            // Thresholding V or L needs the whole pixel, not one byte
+            if (step.rgb) {
+                return false;
+            }
+            chain.threshold(step.value);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void Pipeline::apply(Image& image) const {
+    apply(image, std::random_device{}());
+}
+
+void Pipeline::apply(Image& image, unsigned int seed) const {
+    Image scratch;
+    size_t i = 0;
+    while (i < steps.size()) {
+        // Collect the run of pointwise steps starting here into one chain of tables
+        LutChain chain;
+        size_t end = i;
+        while (end < steps.size() && appendPointwise(steps[end], chain)) {
+            ++end;
+        }
+        if (end - i >= 2) {
+            chain.apply(image, scratch);
+            image.swap(scratch);
+            i = end;
+        } else {
+            applyStep(steps[i], image, scratch, seed);
+            ++i;
+        }
+    }
+}
+
+Pipeline::BatchResult Pipeline::runBatch(const std::vector<std::string>& inputs,
+                                         const std::string& outputDirectory) const {
+    fs::create_directories(outputDirectory);
+
+    BatchResult result;
+    int count = static_cast<int>(inputs.size());
+
+    // Inputs that differ only in extension would overwrite each other's output, so none of them is processed
+    std::vector<fs::path> outputs(count);
+    std::map<fs::path, std::vector<int>> writers;
+    for (int i = 0; i < count; ++i) {
+        outputs[i] = fs::path(outputDirectory) / fs::path(inputs[i]).filename().replace_extension(".png");
+        writers[outputs[i]].push_back(i);
+    }
+    std::vector<bool> skipped(count, false);
+    for (const auto& writer : writers) {
+        if (writer.second.size() > 1) {
+            for (int i : writer.second) {
+                skipped[i] = true;
+                result.failures.emplace_back(inputs[i], "Output " + writer.first.string() + " is shared with "
+                                                        + std::to_string(writer.second.size() - 1) + " other input(s)");
+            }
+        }
+    }
+
+    // Every file gets its own noise engine, seeded from one draw per batch
+    unsigned int batchSeed = std::random_device{}();
+    std::mutex resultMutex;
+    auto processFile = [&](int index) {
+        if (skipped[index]) {
+            return;
+        }
+        const std::string& input = inputs[index];
+        try {
+            Image image(input);
+            apply(image, batchSeed + static_cast<unsigned int>(index));
+            image.save(outputs[index].string());
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.processed++;
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.failures.emplace_back(input, e.what());
+        }
+    };
+
+    if (count >= Parallel::getThreadCount()) {
+        // One file per band; the filters inside a band run serially on its thread
+        Parallel::forRange(0, count, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                processFile(i);
+            }
+        }, 1);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            processFile(i);
+        }
+    }
+
+    // Sort failures by path so the report does not depend on which worker finished first
+    std::sort(result.failures.begin(), result.failures.end());
+    return result;
+}
+
+std::vector<std::string> Pipeline::collectInputs(const std::string& path) {
+    if (!fs::exists(path)) {
+        throw std::invalid_argument("Input path does not exist: " + path);
+    }
+    if (!fs::is_directory(path)) {
+        return {path};
+    }
+
+    std::vector<std::string> inputs;
+    for (const auto& entry : fs::directory_iterator(path)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (entry.is_regular_file()
+            && (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp")) {
+            inputs.push_back(entry.path().string());
+        }
+    }
+    if (inputs.empty()) {
+        throw std::invalid_argument("No images found in directory: " + path);
+    }
+    std::sort(inputs.begin(), inputs.end());
+    return inputs;
+}
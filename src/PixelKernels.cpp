@@ -0,0 +1,386 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "PixelKernels.h"
+#include "PixelKernelsSimd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+// Returns the vectorised kernels for an instruction set, or nullptr for the scalar path
+const PixelKernelTable* tableFor(PixelKernels::Isa isa) {
+    switch (isa) {
+        case PixelKernels::Isa::AVX2:
+            return avx2PixelKernels();
+        case PixelKernels::Isa::SSE41:
+            return sse41PixelKernels();
+        default:
+            return nullptr;
+    }
+}
+
+// Checks whether the running CPU can execute an instruction set
+bool cpuSupports(PixelKernels::Isa isa) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    switch (isa) {
+        case PixelKernels::Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case PixelKernels::Isa::SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        default:
+            return true;
+    }
+#else
+    return isa == PixelKernels::Isa::Scalar;
+#endif
+}
+
+bool available(PixelKernels::Isa isa) {
+    return isa == PixelKernels::Isa::Scalar || (tableFor(isa) != nullptr && cpuSupports(isa));
+}
+
+std::atomic<PixelKernels::Isa>& activeIsa() {
+    static std::atomic<PixelKernels::Isa> isa{PixelKernels::detectIsa()};
+    return isa;
+}
+
+const PixelKernelTable* activeTable() {
+    return tableFor(activeIsa().load(std::memory_order_relaxed));
+}
+
+using ColourKernel = size_t (*)(const unsigned char*, int, unsigned char*, size_t);
+
+// Runs a vector colour kernel over a whole run of pixels. The few pixels left after the last
+// full block go through a zero-padded copy, so every pixel gets the same arithmetic wherever
+// the run (e.g. a thread's row band) happens to start and end.
+size_t runColourKernel(ColourKernel kernel, const unsigned char* src, int channels,
+                    unsigned char* dst, int outChannels, size_t count) {
+    if (channels < 3 || channels > 4) {
+        return 0; // Pixel format not handled by the vector kernels
+    }
+
+    size_t done = kernel(src, channels, dst, count);
+
+    constexpr int paddedPixels = 32;
+    unsigned char in[paddedPixels * 4];
+    unsigned char out[paddedPixels * 3];
+    while (done < count) {
+        size_t chunk = std::min<size_t>(count - done, paddedPixels / 2);
+        std::fill(in, in + sizeof(in), 0);
+        std::copy(src + done * channels, src + (done + chunk) * channels, in);
+        kernel(in, channels, out, paddedPixels);
+        std::copy(out, out + chunk * outChannels, dst + done * outChannels);
+        done += chunk;
+    }
+    return done;
+}
+
+// Scalar reference implementations; these define the results the vector kernels must match
+
+void scalarGrayscale(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        dst[i] = static_cast<unsigned char>(0.2126 * p[0] + 0.7152 * p[1] + 0.0722 * p[2]);
+    }
+}
+
+void scalarAddBrightness(const unsigned char* src, unsigned char* dst, size_t count, int value) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<unsigned char>(std::max(0, std::min(src[i] + value, 255)));
+    }
+}
+
+void scalarThreshold(const unsigned char* src, int stride, unsigned char* dst, size_t count, double thresholdValue) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = (src[i * stride] >= thresholdValue) ? 255 : 0;
+    }
+}
+
+void scalarRgbToHsv(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        float r = p[0] / 255.0f;
+        float g = p[1] / 255.0f;
+        float b = p[2] / 255.0f;
+
+        float max = std::max({r, g, b});
+        float min = std::min({r, g, b});
+        float delta = max - min;
+
+        float h, s, v;
+        v = max;
+
+        if (delta < 0.00001f) {
+            s = 0;
+            h = 0; // Undefined for greys
+        } else {
+            s = (max > 0.0f) ? (delta / max) : 0.0f;
+
+            if (r >= max) {
+                h = (g - b) / delta; // Between yellow & magenta
+            } else if (g >= max) {
+                h = 2.0f + (b - r) / delta; // Between cyan & yellow
+            } else {
+                h = 4.0f + (r - g) / delta; // Between magenta & cyan
+            }
+
+            h *= 60.0f; // Convert to degrees
+
+            if (h < 0.0f) {
+                h += 360.0f;
+            }
+        }
+
+        unsigned char* out = dst + i * 3;
+        out[0] = static_cast<unsigned char>((h / 360.0f) * 255); // H: 0-360 degrees -> scaled to 0-255
+        out[1] = static_cast<unsigned char>(s * 255); // S: 0-1 -> scaled to 0-255
+        out[2] = static_cast<unsigned char>(v * 255); // V: 0-1 -> scaled to 0-255
+    }
+}
+
+// Picks the R, G, B primes of the hexcone sector containing hue h (degrees)
+template <typename T>
+void hueSectorToRgb(T h, T c, T x, T& r, T& g, T& b) {
+    if (h >= 0 && h < 60) {
+        r = c; g = x; b = 0;
+    } else if (h >= 60 && h < 120) {
+        r = x; g = c; b = 0;
+    } else if (h >= 120 && h < 180) {
+        r = 0; g = c; b = x;
+    } else if (h >= 180 && h < 240) {
+        r = 0; g = x; b = c;
+    } else if (h >= 240 && h < 300) {
+        r = x; g = 0; b = c;
+    } else {
+        r = c; g = 0; b = x;
+    }
+}
+
+void scalarHsvToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        float h = p[0] * (360.0f / 255.0f); // Rescale to 0-360
+        float s = p[1] / 255.0f; // Scale to 0-1
+        float v = p[2] / 255.0f; // Scale to 0-1
+
+        float c = v * s; // Chroma
+        float xVal = c * (1 - std::fabs(std::fmod(h / 60.0, 2) - 1));
+        float m = v - c;
+
+        float rPrime, gPrime, bPrime;
+        hueSectorToRgb(h, c, xVal, rPrime, gPrime, bPrime);
+
+        unsigned char* out = dst + i * 3;
+        out[0] = static_cast<unsigned char>((rPrime + m) * 255);
+        out[1] = static_cast<unsigned char>((gPrime + m) * 255);
+        out[2] = static_cast<unsigned char>((bPrime + m) * 255);
+    }
+}
+
+void scalarRgbToHsl(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        double r = p[0] / 255.0;
+        double g = p[1] / 255.0;
+        double b = p[2] / 255.0;
+
+        double max = std::max({r, g, b});
+        double min = std::min({r, g, b});
+        double delta = max - min;
+
+        double h, s, l;
+
+        // Calculate lightness
+        l = (max + min) / 2.0;
+
+        // Calculate saturation
+        if (delta == 0) {
+            s = 0;
+        } else {
+            s = delta / (1 - std::abs(2 * l - 1));
+        }
+
+        // Calculate hue, wrapped into [0, 360)
+        if (delta == 0) {
+            h = 0;
+        } else {
+            if (max == r) {
+                h = 60 * std::fmod((g - b) / delta, 6);
+            } else if (max == g) {
+                h = 60 * ((b - r) / delta + 2);
+            } else {
+                h = 60 * ((r - g) / delta + 4);
+            }
+            if (h < 0) {
+                h += 360;
+            }
+        }
+
+        unsigned char* out = dst + i * 3;
+        out[0] = static_cast<unsigned char>(h / 360 * 255);
+        out[1] = static_cast<unsigned char>(s * 255);
+        // L is the mean of the extremes rounded down, as the vector kernels give it; l * 255 can land just below
+        out[2] = static_cast<unsigned char>((std::max({p[0], p[1], p[2]}) + std::min({p[0], p[1], p[2]})) / 2);
+    }
+}
+
+void scalarHslToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        double H = p[0] / 255.0 * 360;
+        double S = p[1] / 255.0;
+        double L = p[2] / 255.0;
+
+        double C = (1 - std::abs(2 * L - 1)) * S;
+        double X = C * (1 - std::abs(std::fmod(H / 60, 2) - 1));
+        double M = L - C / 2;
+
+        double R, G, B;
+        hueSectorToRgb(H, C, X, R, G, B);
+
+        unsigned char* out = dst + i * 3;
+        out[0] = static_cast<unsigned char>((R + M) * 255);
+        out[1] = static_cast<unsigned char>((G + M) * 255);
+        out[2] = static_cast<unsigned char>((B + M) * 255);
+    }
+}
+
+void scalarRgbToValue(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        dst[i] = std::max({p[0], p[1], p[2]});
+    }
+}
+
+void scalarRgbToLightness(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = src + i * channels;
+        dst[i] = static_cast<unsigned char>((std::max({p[0], p[1], p[2]}) + std::min({p[0], p[1], p[2]})) / 2);
+    }
+}
+
+void scalarFirstChannel(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i * channels];
+    }
+}
+
+void scalarLookup(const unsigned char* src, unsigned char* dst, int stride, size_t count, const unsigned char* table) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i * stride] = table[src[i * stride]];
+    }
+}
+
+} // namespace
+
+PixelKernels::Isa PixelKernels::detectIsa() {
+    if (available(Isa::AVX2)) {
+        return Isa::AVX2;
+    }
+    if (available(Isa::SSE41)) {
+        return Isa::SSE41;
+    }
+    return Isa::Scalar;
+}
+
+PixelKernels::Isa PixelKernels::getIsa() {
+    return activeIsa().load();
+}
+
+void PixelKernels::setIsa(Isa isa) {
+    activeIsa().store(available(isa) ? isa : detectIsa());
+}
+
+const char* PixelKernels::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2:
+            return "AVX2";
+        case Isa::SSE41:
+            return "SSE4.1";
+        default:
+            return "Scalar";
+    }
+}
+
+void PixelKernels::grayscale(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->grayscale, src, channels, dst, 1, count) : 0;
+    scalarGrayscale(src + done * channels, channels, dst + done, count - done);
+}
+
+void PixelKernels::addBrightness(const unsigned char* src, unsigned char* dst, size_t count, int value) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? table->addBrightness(src, dst, count, value) : 0;
+    scalarAddBrightness(src + done, dst + done, count - done, value);
+}
+
+void PixelKernels::threshold(const unsigned char* src, int stride, unsigned char* dst, size_t count, double thresholdValue) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = 0;
+    // For byte values, v >= t is the same as v >= ceil(t); the all-or-nothing cases need no compare
+    if (table && stride == 1 && thresholdValue > 0 && thresholdValue <= 255) {
+        done = table->threshold(src, dst, count, static_cast<int>(std::ceil(thresholdValue)));
+    }
+    scalarThreshold(src + done * stride, stride, dst + done, count - done, thresholdValue);
+}
+
+void PixelKernels::rgbToHsv(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->rgbToHsv, src, channels, dst, 3, count) : 0;
+    scalarRgbToHsv(src + done * channels, channels, dst + done * 3, count - done);
+}
+
+void PixelKernels::hsvToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->hsvToRgb, src, channels, dst, 3, count) : 0;
+    scalarHsvToRgb(src + done * channels, channels, dst + done * 3, count - done);
+}
+
+void PixelKernels::rgbToHsl(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->rgbToHsl, src, channels, dst, 3, count) : 0;
+    scalarRgbToHsl(src + done * channels, channels, dst + done * 3, count - done);
+}
+
+void PixelKernels::hslToRgb(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->hslToRgb, src, channels, dst, 3, count) : 0;
+    scalarHslToRgb(src + done * channels, channels, dst + done * 3, count - done);
+}
+
+void PixelKernels::rgbToValue(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->rgbToValue, src, channels, dst, 1, count) : 0;
+    scalarRgbToValue(src + done * channels, channels, dst + done, count - done);
+}
+
+void PixelKernels::rgbToLightness(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->rgbToLightness, src, channels, dst, 1, count) : 0;
+    scalarRgbToLightness(src + done * channels, channels, dst + done, count - done);
+}
+
+void PixelKernels::firstChannel(const unsigned char* src, int channels, unsigned char* dst, size_t count) {
+    const PixelKernelTable* table = activeTable();
+    size_t done = table ? runColourKernel(table->firstChannel, src, channels, dst, 1, count) : 0;
+    scalarFirstChannel(src + done * channels, channels, dst + done, count - done);
+}
+
+void PixelKernels::lookup(const unsigned char* src, unsigned char* dst, int stride, size_t count,
+                          const unsigned char* table) {
+    const PixelKernelTable* kernels = activeTable();
+    size_t done = kernels && stride == 1 ? kernels->lookup(src, dst, count, table) : 0;
+    scalarLookup(src + done * stride, dst + done * stride, stride, count - done, table);
+}
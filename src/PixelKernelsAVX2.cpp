@@ -0,0 +1,34 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+// AVX2 instantiation of the colour kernels. CMake compiles this file with -mavx2 on x86
+// compilers that accept it; everywhere else it only reports that the kernels are unavailable.
+
+#include "PixelKernelsSimd.h"
+
+#if defined(__AVX2__)
+
+namespace {
+const PixelKernelTable table = makePixelKernelTable<Avx2Vec>();
+} // namespace
+
+const PixelKernelTable* avx2PixelKernels() {
+    return &table;
+}
+
+#else
+
+const PixelKernelTable* avx2PixelKernels() {
+    return nullptr;
+}
+
+#endif
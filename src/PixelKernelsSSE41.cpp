@@ -0,0 +1,34 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+// SSE4.1 instantiation of the colour kernels. CMake compiles this file with -msse4.1 on x86
+// compilers that accept it; everywhere else it only reports that the kernels are unavailable.
+
+#include "PixelKernelsSimd.h"
+
+#if defined(__SSE4_1__)
+
+namespace {
+const PixelKernelTable table = makePixelKernelTable<Sse41Vec>();
+} // namespace
+
+const PixelKernelTable* sse41PixelKernels() {
+    return &table;
+}
+
+#else
+
+const PixelKernelTable* sse41PixelKernels() {
+    return nullptr;
+}
+
+#endif
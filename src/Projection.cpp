@@ -11,113 +11,549 @@
  */
 
 #include "Projection.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Pixels accumulated together by one band pass. Keeps the per-pixel median histograms
+// (256 counters per pixel) small enough to stay in cache while the slices stream past.
+constexpr int projectionTilePixels = 512;
+
+// Per-thread median counters. Deep stacks use a 256-bin histogram per pixel; short stacks select the median
+// digit by digit with 16 counters per pixel and digit, which is far less to clear and scan.
+struct MedianScratch {
+    std::vector<uint32_t> histograms;
+    std::vector<uint32_t> highCounts;  ///< Per pixel, counts of the high 4 bits
+    std::vector<uint32_t> lowerCounts; ///< Per pixel, low-4-bit counts inside the lower middle value's bucket
+    std::vector<uint32_t> upperCounts; ///< The same for the upper middle value
+    std::vector<unsigned char> lowerBucket, upperBucket;
+    std::vector<uint32_t> lowerResidual, upperResidual;
+
+    void resize(size_t pixels) {
+        highCounts.resize(pixels * 16);
+        lowerCounts.resize(pixels * 16);
+        upperCounts.resize(pixels * 16);
+        lowerBucket.resize(pixels);
+        upperBucket.resize(pixels);
+        lowerResidual.resize(pixels);
+        upperResidual.resize(pixels);
+    }
+};
 
-// Function to generate Maximum Intensity Projection (MIP) from a 3D volume
-Image Projection::maximumIntensityProjection(const Volume& volume, int z_start, int z_end){
-    // Get dimensions of the volume
-    int width = volume.getWidth();
-    int height = volume.getHeight();
-    
-    // Create a new image for the maximum intensity projection
-    Image outputImg(width, height, 1);
+thread_local MedianScratch medianScratch;
 
-    // Determine the range of slices to iterate over
-    int startZ = (z_start == -1) ? 0 : z_start - 1;
-    int endZ = (z_end == -1) ? volume.getDepth() : z_end;
+// Finds the bucket of 16 counters that holds the value of the given rank, and that value's rank inside it
+inline void locateRank(const uint32_t* counts, uint32_t rank, unsigned char& bucket, uint32_t& residual) {
+    int b = 0;
+    while (rank >= counts[b]) {
+        rank -= counts[b];
+        ++b;
+    }
+    bucket = static_cast<unsigned char>(b);
+    residual = rank;
+}
 
-    // Iterate through each pixel in the output image
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            unsigned char maxIntensity = 0; // Initialize max intensity
-            
-            // Iterate through each slice in the volume
-            for (int z = startZ; z < endZ; ++z) {
-                // Get intensity value at (x, y) in the current slice
-                unsigned char intensity = volume.getVoxel(x, y, z, 0);
-                // Update max intensity if current intensity is greater
-                maxIntensity = std::max(maxIntensity, intensity);
+// Completes the counting selection for a tile whose high-digit counts were gathered during the main pass:
+// one more pass over the tile's slices counts the low digits of the values in each chosen bucket.
+// `slices` points at channel 0 of the tile's first pixel in the first slice.
+void selectRadixMedians(MedianScratch& scratch, const unsigned char* slices, size_t sliceStride, int channels,
+                        int count, size_t tilePixels, int lowerRank, int upperRank, unsigned char* out) {
+    for (size_t i = 0; i < tilePixels; ++i) {
+        locateRank(&scratch.highCounts[i * 16], lowerRank, scratch.lowerBucket[i], scratch.lowerResidual[i]);
+        locateRank(&scratch.highCounts[i * 16], upperRank, scratch.upperBucket[i], scratch.upperResidual[i]);
+    }
+    std::fill(scratch.lowerCounts.begin(), scratch.lowerCounts.begin() + tilePixels * 16, 0);
+    std::fill(scratch.upperCounts.begin(), scratch.upperCounts.begin() + tilePixels * 16, 0);
+
+    const unsigned char* lowerBucket = scratch.lowerBucket.data();
+    const unsigned char* upperBucket = scratch.upperBucket.data();
+    uint32_t* lowerCounts = scratch.lowerCounts.data();
+    uint32_t* upperCounts = scratch.upperCounts.data();
+    // An odd stack has a single middle value, so one set of low-digit counters serves both ranks
+    bool singleRank = lowerRank == upperRank;
+    for (int z = 0; z < count; ++z) {
+        const unsigned char* slice = slices + z * sliceStride;
+        if (singleRank) {
+            for (size_t i = 0; i < tilePixels; ++i) {
+                unsigned char v = slice[i * channels];
+                lowerCounts[i * 16 + (v & 15)] += (v >> 4) == lowerBucket[i];
+            }
+        } else {
+            for (size_t i = 0; i < tilePixels; ++i) {
+                unsigned char v = slice[i * channels];
+                lowerCounts[i * 16 + (v & 15)] += (v >> 4) == lowerBucket[i];
+                upperCounts[i * 16 + (v & 15)] += (v >> 4) == upperBucket[i];
             }
+        }
+    }
 
-            // Set the maximum intensity value at (x, y) in the output image
-            outputImg.setPixel(x, y, 0, maxIntensity);
+    for (size_t i = 0; i < tilePixels; ++i) {
+        unsigned char lowDigit, highDigit;
+        uint32_t unused;
+        locateRank(&lowerCounts[i * 16], scratch.lowerResidual[i], lowDigit, unused);
+        int lower = lowerBucket[i] * 16 + lowDigit;
+        int upper = lower;
+        if (!singleRank) {
+            locateRank(&upperCounts[i * 16], scratch.upperResidual[i], highDigit, unused);
+            upper = upperBucket[i] * 16 + highDigit;
         }
+        out[i] = static_cast<unsigned char>((lower + upper) / 2);
     }
+}
+
+// Stack depth below which the counting selection beats the histograms; 0 until measured
+std::atomic<int> medianCrossover{0};
+std::mutex medianCrossoverMutex;
+
+} // namespace
 
-    return outputImg;
+// Function to convert z_start/z_end (1-based, inclusive, -1 for the full depth) into [startZ, endZ)
+void Projection::resolveSliceRange(int depth, int z_start, int z_end, int& startZ, int& endZ) {
+    startZ = (z_start == -1) ? 0 : z_start - 1;
+    endZ = (z_end == -1) ? depth : z_end;
+
+    if (startZ < 0 || endZ > depth || startZ >= endZ) {
+        throw std::out_of_range("Projection slice range is empty or outside the volume.");
+    }
 }
 
-// Function to generate Minimum Intensity Projection (mIP) from a 3D volume
-Image Projection::minimumIntensityProjection(const Volume& volume, int z_start, int z_end){
-    // Get dimensions of the volume
-    int width = volume.getWidth();
-    int height = volume.getHeight();
-    
-    // Create a new image for the minimum intensity projection
-    Image mipImage(width, height, 1);
+// Function to measure, once, the stack depth at which the histogram median overtakes the counting selection
+int Projection::medianCrossoverDepth() {
+    int depth = medianCrossover.load();
+    if (depth > 0) {
+        return depth;
+    }
+    std::lock_guard<std::mutex> lock(medianCrossoverMutex);
+    if (medianCrossover.load() > 0) {
+        return medianCrossover.load();
+    }
 
-    // Determine the range of slices to iterate over
-    int startZ = (z_start == -1) ? 0 : z_start - 1;
-    int endZ = (z_end == -1) ? volume.getDepth() : z_end;
+    // Time both engines at doubling depths on a sample larger than the caches, since the counting selection
+    // reads the voxels twice; keep the best of a few runs and stop at the first depth where histograms win
+    constexpr int candidates[] = {4, 8, 16, 32, 64, 128, 256, 512};
+    auto fastest = [](const Volume& sample, bool radix) {
+        auto best = std::chrono::steady_clock::duration::max();
+        for (int run = 0; run < 3; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            project(sample, Median, 0, sample.getDepth(), radix);
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+        }
+        return best;
+    };
+
+    depth = 2 * candidates[std::size(candidates) - 1];
+    uint32_t state = 12345;
+    for (int count : candidates) {
+        Volume sample(256, 128, count, 1);
+        size_t voxels = static_cast<size_t>(sample.getWidth()) * sample.getHeight() * count;
+        for (size_t i = 0; i < voxels; ++i) {
+            state = state * 1664525u + 1013904223u;
+            sample.getVolumeData()[i] = static_cast<unsigned char>(state >> 24);
+        }
+        if (fastest(sample, false) <= fastest(sample, true)) {
+            depth = count;
+            break;
+        }
+    }
+    medianCrossover.store(depth);
+    return depth;
+}
 
-    // Iterate through each pixel in the output image
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            unsigned char minIntensity = 255; // Initialize min intensity to maximum value
-            
-            // Iterate through each slice in the volume
+// Function to override the measured crossover, or to measure it again on the next median projection
+void Projection::setMedianCrossoverDepth(int depth) {
+    std::lock_guard<std::mutex> lock(medianCrossoverMutex);
+    medianCrossover.store(std::max(0, depth));
+}
+
+// Function to compute the selected projections in one z-major pass over the volume
+Projection::Result Projection::computeProjections(const Volume& volume, unsigned int types, int z_start, int z_end) {
+    int startZ, endZ;
+    resolveSliceRange(volume.getDepth(), z_start, z_end, startZ, endZ);
+    bool radixMedian = (types & Median) && endZ - startZ < medianCrossoverDepth();
+    return project(volume, types, startZ, endZ, radixMedian);
+}
+
+// Function to run the projection engine over slices [startZ, endZ) with the chosen median selection
+Projection::Result Projection::project(const Volume& volume, unsigned int types, int startZ, int endZ, bool radixMedian) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int channels = volume.getChannels();
+    int count = endZ - startZ;
+
+    bool wantMax = types & Maximum;
+    bool wantMin = types & Minimum;
+    bool wantAverage = types & Average;
+    bool wantMedian = types & Median;
+    bool wantStdDev = types & StandardDeviation;
+    bool wantSum = wantAverage || wantStdDev;
+
+    Result result;
+    if (wantMax) result.maximum = Image(width, height, 1);
+    if (wantMin) result.minimum = Image(width, height, 1);
+    if (wantAverage) result.average = Image(width, height, 1);
+    if (wantMedian) result.median = Image(width, height, 1);
+    if (wantStdDev) result.standardDeviation = Image(width, height, 1);
+
+    const unsigned char* data = volume.getVolumeData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t sliceStride = rowStride * height;
+
+    // A tile is a run of whole rows; very wide images still get one row per tile
+    int tileRows = std::max(1, projectionTilePixels / std::max(1, width));
+
+    // Ranks (0-based) of the two middle values; equal when the slice count is odd
+    int lowerRank = (count - 1) / 2;
+    int upperRank = count / 2;
+
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t tileCapacity = static_cast<size_t>(std::min(tileRows, yEnd - yBegin)) * width;
+        std::vector<unsigned char> maxAcc(wantMax ? tileCapacity : 0);
+        std::vector<unsigned char> minAcc(wantMin ? tileCapacity : 0);
+        std::vector<uint32_t> sumAcc(wantSum ? tileCapacity : 0);
+        std::vector<uint64_t> squareAcc(wantStdDev ? tileCapacity : 0);
+        // Median counters live in per-thread scratch that is reused across tiles and calls
+        MedianScratch& scratch = medianScratch;
+        std::vector<uint32_t>& histograms = scratch.histograms;
+        histograms.resize(wantMedian && !radixMedian ? tileCapacity * 256 : 0);
+        scratch.resize(wantMedian && radixMedian ? tileCapacity : 0);
+        std::vector<unsigned char> rowBuffer(channels == 1 ? 0 : width);
+
+        for (int tileBegin = yBegin; tileBegin < yEnd; tileBegin += tileRows) {
+            int tileEnd = std::min(yEnd, tileBegin + tileRows);
+            size_t tilePixels = static_cast<size_t>(tileEnd - tileBegin) * width;
+
+            std::fill(maxAcc.begin(), maxAcc.end(), 0);
+            std::fill(minAcc.begin(), minAcc.end(), 255);
+            std::fill(sumAcc.begin(), sumAcc.end(), 0);
+            std::fill(squareAcc.begin(), squareAcc.end(), 0);
+            std::fill(histograms.begin(), histograms.end(), 0);
+            std::fill(scratch.highCounts.begin(), scratch.highCounts.end(), 0);
+
+            // Stream every slice row of the tile once, updating all accumulators from it
             for (int z = startZ; z < endZ; ++z) {
-                // Get intensity value at (x, y) in the current slice
-                unsigned char intensity = volume.getVoxel(x, y, z, 0);
-                // Update min intensity if current intensity is smaller
-                minIntensity = std::min(minIntensity, intensity);
+                for (int y = tileBegin; y < tileEnd; ++y) {
+                    const unsigned char* row = data + z * sliceStride + y * rowStride;
+                    if (channels != 1) {
+                        // Gather channel 0 so the accumulation loops below run over contiguous bytes
+                        for (int x = 0; x < width; ++x) {
+                            rowBuffer[x] = row[static_cast<size_t>(x) * channels];
+                        }
+                        row = rowBuffer.data();
+                    }
+
+                    size_t offset = static_cast<size_t>(y - tileBegin) * width;
+                    if (wantMax) {
+                        unsigned char* acc = maxAcc.data() + offset;
+                        for (int x = 0; x < width; ++x) {
+                            acc[x] = std::max(acc[x], row[x]);
+                        }
+                    }
+                    if (wantMin) {
+                        unsigned char* acc = minAcc.data() + offset;
+                        for (int x = 0; x < width; ++x) {
+                            acc[x] = std::min(acc[x], row[x]);
+                        }
+                    }
+                    if (wantSum) {
+                        uint32_t* acc = sumAcc.data() + offset;
+                        for (int x = 0; x < width; ++x) {
+                            acc[x] += row[x];
+                        }
+                    }
+                    if (wantStdDev) {
+                        uint64_t* acc = squareAcc.data() + offset;
+                        for (int x = 0; x < width; ++x) {
+                            acc[x] += static_cast<uint32_t>(row[x]) * row[x];
+                        }
+                    }
+                    if (wantMedian && radixMedian) {
+                        uint32_t* counts = scratch.highCounts.data() + offset * 16;
+                        for (int x = 0; x < width; ++x) {
+                            ++counts[static_cast<size_t>(x) * 16 + (row[x] >> 4)];
+                        }
+                    } else if (wantMedian) {
+                        uint32_t* histogram = histograms.data() + offset * 256;
+                        for (int x = 0; x < width; ++x) {
+                            ++histogram[static_cast<size_t>(x) * 256 + row[x]];
+                        }
+                    }
+                }
             }
 
-            // Set the minimum intensity value at (x, y) in the output image
-            mipImage.setPixel(x, y, 0, minIntensity);
+            // Write the finished tile into the output images
+            size_t outOffset = static_cast<size_t>(tileBegin) * width;
+            if (wantMax) {
+                std::copy(maxAcc.begin(), maxAcc.begin() + tilePixels, result.maximum.getData() + outOffset);
+            }
+            if (wantMin) {
+                std::copy(minAcc.begin(), minAcc.begin() + tilePixels, result.minimum.getData() + outOffset);
+            }
+            if (wantAverage) {
+                unsigned char* out = result.average.getData() + outOffset;
+                for (size_t i = 0; i < tilePixels; ++i) {
+                    out[i] = static_cast<unsigned char>(sumAcc[i] / count);
+                }
+            }
+            if (wantStdDev) {
+                unsigned char* out = result.standardDeviation.getData() + outOffset;
+                for (size_t i = 0; i < tilePixels; ++i) {
+                    double mean = static_cast<double>(sumAcc[i]) / count;
+                    double variance = static_cast<double>(squareAcc[i]) / count - mean * mean;
+                    double deviation = std::sqrt(std::max(0.0, variance));
+                    out[i] = static_cast<unsigned char>(std::min(255.0, deviation + 0.5));
+                }
+            }
+            if (wantMedian && radixMedian) {
+                selectRadixMedians(scratch, data + startZ * sliceStride + outOffset * channels, sliceStride, channels,
+                                   count, tilePixels, lowerRank, upperRank, result.median.getData() + outOffset);
+            } else if (wantMedian) {
+                unsigned char* out = result.median.getData() + outOffset;
+                for (size_t i = 0; i < tilePixels; ++i) {
+                    const uint32_t* histogram = histograms.data() + i * 256;
+                    int cumulative = 0;
+                    int bin = 0;
+                    // Walk up to the lower middle value, then on to the upper one if it differs
+                    while ((cumulative += histogram[bin]) <= lowerRank) {
+                        ++bin;
+                    }
+                    int lower = bin;
+                    while (cumulative <= upperRank) {
+                        cumulative += histogram[++bin];
+                    }
+                    out[i] = static_cast<unsigned char>((lower + bin) / 2);
+                }
+            }
         }
-    }
+    });
 
-    return mipImage;
+    return result;
 }
 
-// Function to generate Average Intensity Projection (AIP) from a 3D volume
-Image Projection::averageIntensityProjection(const Volume& volume, int z_start, int z_end){
-    // Get dimensions of the volume
+// Function to compute sliding thin-slab projections with block prefix/suffix extremes and running sums
+Projection::SlabStack Projection::computeSlabProjections(const Volume& volume, int slabThickness, unsigned int types) {
     int width = volume.getWidth();
     int height = volume.getHeight();
-    
-    // Create a new image for the average intensity projection
-    Image mipImage(width, height, 1);
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
 
-    // Determine the range of slices to iterate over
-    int startZ = (z_start == -1) ? 0 : z_start - 1;
-    int endZ = (z_end == -1) ? volume.getDepth() : z_end;
+    if (slabThickness < 1 || slabThickness > depth) {
+        throw std::invalid_argument("Slab thickness must be between 1 and the volume depth.");
+    }
+    if (types & ~static_cast<unsigned int>(Maximum | Minimum | Average)) {
+        throw std::invalid_argument("Slab projections support only maximum, minimum and average.");
+    }
 
-    // Iterate through each pixel in the output image
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int sumIntensity = 0; // Initialize sum intensity to 0
-            
-            // Iterate through each slice in the volume
-            for (int z = startZ; z < endZ; ++z) {
-                // Get intensity value at (x, y) in the current slice
-                unsigned char intensity = volume.getVoxel(x, y, z, 0);
-                // Update sum intensity
-                sumIntensity += intensity;
+    bool wantMax = types & Maximum;
+    bool wantMin = types & Minimum;
+    bool wantAverage = types & Average;
+
+    int slabCount = depth - slabThickness + 1;
+    SlabStack stack;
+    for (int i = 0; i < slabCount; ++i) {
+        if (wantMax) stack.maximum.emplace_back(width, height, 1);
+        if (wantMin) stack.minimum.emplace_back(width, height, 1);
+        if (wantAverage) stack.average.emplace_back(width, height, 1);
+    }
+
+    const unsigned char* data = volume.getVolumeData();
+    size_t sliceStride = static_cast<size_t>(width) * height * channels;
+    int tileRows = std::max(1, projectionTilePixels / std::max(1, width));
+    size_t slab = slabThickness;
+
+    // The slices are cut into blocks of slabThickness. A slab starting inside a block is the block's suffix from
+    // that slice joined with the next block's prefix, so keeping per-pixel suffix extremes of one block and a
+    // running prefix of the next gives every slab with two comparisons per voxel, whatever the thickness. All
+    // loops run across the pixels of a tile, slice by slice, so they read the volume contiguously.
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        size_t tileCapacity = static_cast<size_t>(std::min(tileRows, yEnd - yBegin)) * width;
+        std::vector<unsigned char> maxBlock(wantMax ? slab * tileCapacity : 0), maxNext(maxBlock.size());
+        std::vector<unsigned char> minBlock(wantMin ? slab * tileCapacity : 0), minNext(minBlock.size());
+        std::vector<unsigned char> maxPrefix(wantMax ? tileCapacity : 0), minPrefix(wantMin ? tileCapacity : 0);
+        std::vector<uint32_t> sums(wantAverage ? tileCapacity : 0);
+        std::vector<unsigned char> gathered(channels == 1 ? 0 : tileCapacity);
+
+        for (int tileBegin = yBegin; tileBegin < yEnd; tileBegin += tileRows) {
+            int tileEnd = std::min(yEnd, tileBegin + tileRows);
+            size_t tilePixels = static_cast<size_t>(tileEnd - tileBegin) * width;
+            size_t firstPixel = static_cast<size_t>(tileBegin) * width;
+            std::fill(sums.begin(), sums.end(), 0);
+
+            for (int blockStart = 0; blockStart < depth; blockStart += slabThickness) {
+                int blockLength = std::min(slabThickness, depth - blockStart);
+
+                for (int t = 0; t < blockLength; ++t) {
+                    int z = blockStart + t;
+                    const unsigned char* values = data + z * sliceStride + firstPixel * channels;
+                    if (channels != 1) {
+                        // Gather channel 0 so the loops below run over contiguous bytes
+                        for (size_t i = 0; i < tilePixels; ++i) {
+                            gathered[i] = values[i * channels];
+                        }
+                        values = gathered.data();
+                    }
+
+                    // The slab ending at z starts at slice t + 1 of the previous block
+                    bool spansBlocks = blockStart > 0 && t < slabThickness - 1;
+                    int slabIndex = z - slabThickness + 1;
+
+                    if (wantMax) {
+                        unsigned char* raw = &maxNext[t * tilePixels];
+                        unsigned char* prefix = maxPrefix.data();
+                        for (size_t i = 0; i < tilePixels; ++i) {
+                            raw[i] = values[i];
+                            prefix[i] = t == 0 ? values[i] : std::max(prefix[i], values[i]);
+                        }
+                        if (spansBlocks) {
+                            const unsigned char* suffix = &maxBlock[(t + 1) * tilePixels];
+                            unsigned char* out = stack.maximum[slabIndex].getData() + firstPixel;
+                            for (size_t i = 0; i < tilePixels; ++i) {
+                                out[i] = std::max(suffix[i], prefix[i]);
+                            }
+                        }
+                    }
+                    if (wantMin) {
+                        unsigned char* raw = &minNext[t * tilePixels];
+                        unsigned char* prefix = minPrefix.data();
+                        for (size_t i = 0; i < tilePixels; ++i) {
+                            raw[i] = values[i];
+                            prefix[i] = t == 0 ? values[i] : std::min(prefix[i], values[i]);
+                        }
+                        if (spansBlocks) {
+                            const unsigned char* suffix = &minBlock[(t + 1) * tilePixels];
+                            unsigned char* out = stack.minimum[slabIndex].getData() + firstPixel;
+                            for (size_t i = 0; i < tilePixels; ++i) {
+                                out[i] = std::min(suffix[i], prefix[i]);
+                            }
+                        }
+                    }
+                    if (wantAverage) {
+                        for (size_t i = 0; i < tilePixels; ++i) {
+                            sums[i] += values[i];
+                        }
+                        if (z >= slabThickness) {
+                            // Drop the slice that just left the slab
+                            const unsigned char* leaving = data + (z - slab) * sliceStride + firstPixel * channels;
+                            for (size_t i = 0; i < tilePixels; ++i) {
+                                sums[i] -= leaving[i * channels];
+                            }
+                        }
+                        if (slabIndex >= 0) {
+                            unsigned char* out = stack.average[slabIndex].getData() + firstPixel;
+                            for (size_t i = 0; i < tilePixels; ++i) {
+                                out[i] = static_cast<unsigned char>(sums[i] / slab);
+                            }
+                        }
+                    }
+                }
+
+                // Turn the block just read into suffix extremes; a full block is itself the slab starting at it
+                for (int t = blockLength - 2; t >= 0; --t) {
+                    for (size_t i = 0; i < tilePixels; ++i) {
+                        if (wantMax) {
+                            maxNext[t * tilePixels + i] = std::max(maxNext[t * tilePixels + i],
+                                                                   maxNext[(t + 1) * tilePixels + i]);
+                        }
+                        if (wantMin) {
+                            minNext[t * tilePixels + i] = std::min(minNext[t * tilePixels + i],
+                                                                   minNext[(t + 1) * tilePixels + i]);
+                        }
+                    }
+                }
+                maxBlock.swap(maxNext);
+                minBlock.swap(minNext);
+                if (blockLength == slabThickness) {
+                    if (wantMax) {
+                        std::memcpy(stack.maximum[blockStart].getData() + firstPixel, maxBlock.data(), tilePixels);
+                    }
+                    if (wantMin) {
+                        std::memcpy(stack.minimum[blockStart].getData() + firstPixel, minBlock.data(), tilePixels);
+                    }
+                }
             }
+        }
+    });
 
-            // Calculate z range
-            int zRange = endZ - startZ;
+    return stack;
+}
 
-            // Calculate average intensity
-            unsigned char averageIntensity = sumIntensity / zRange;
+// Function to compute projections of a bricked volume one brick-wide column at a time
+Projection::Result Projection::computeProjections(const BrickedVolume& volume, unsigned int types, int z_start, int z_end) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int channels = volume.getChannels();
+    int side = volume.getBrickSide();
+
+    int startZ, endZ;
+    resolveSliceRange(volume.getDepth(), z_start, z_end, startZ, endZ);
+
+    Result result;
+    Image* outputs[] = {&result.maximum, &result.minimum, &result.average, &result.median, &result.standardDeviation};
+    unsigned int flags[] = {Maximum, Minimum, Average, Median, StandardDeviation};
+    for (int i = 0; i < 5; ++i) {
+        if (types & flags[i]) {
+            *outputs[i] = Image(width, height, 1);
+        }
+    }
 
-            // Set the average intensity value at (x, y) in the output image
-            mipImage.setPixel(x, y, 0, averageIntensity);
+    for (int y0 = 0; y0 < height; y0 += side) {
+        for (int x0 = 0; x0 < width; x0 += side) {
+            int tileWidth = std::min(side, width - x0);
+            int tileHeight = std::min(side, height - y0);
+            Volume column(tileWidth, tileHeight, endZ - startZ, channels);
+            volume.readRegion(x0, y0, startZ, tileWidth, tileHeight, endZ - startZ, column.getVolumeData());
+
+            Result tile = computeProjections(column, types);
+            Image* tiles[] = {&tile.maximum, &tile.minimum, &tile.average, &tile.median, &tile.standardDeviation};
+            for (int i = 0; i < 5; ++i) {
+                if (!(types & flags[i])) {
+                    continue;
+                }
+                for (int y = 0; y < tileHeight; ++y) {
+                    std::memcpy(outputs[i]->getData() + static_cast<size_t>(y0 + y) * width + x0,
+                                tiles[i]->getData() + static_cast<size_t>(y) * tileWidth, tileWidth);
+                }
+            }
         }
     }
+    return result;
+}
 
-    return mipImage;
+// Function to generate Maximum Intensity Projection (MIP) from a 3D volume
+Image Projection::maximumIntensityProjection(const Volume& volume, int z_start, int z_end){
+    return computeProjections(volume, Maximum, z_start, z_end).maximum;
+}
+
+Image Projection::maximumIntensityProjection(const BrickedVolume& volume, int z_start, int z_end){
+    return computeProjections(volume, Maximum, z_start, z_end).maximum;
+}
+
+// Function to generate Minimum Intensity Projection (mIP) from a 3D volume
+Image Projection::minimumIntensityProjection(const Volume& volume, int z_start, int z_end){
+    return computeProjections(volume, Minimum, z_start, z_end).minimum;
+}
+
+Image Projection::minimumIntensityProjection(const BrickedVolume& volume, int z_start, int z_end){
+    return computeProjections(volume, Minimum, z_start, z_end).minimum;
+}
+
+// Function to generate Average Intensity Projection (AIP) from a 3D volume
+Image Projection::averageIntensityProjection(const Volume& volume, int z_start, int z_end){
+    return computeProjections(volume, Average, z_start, z_end).average;
+}
+
+Image Projection::averageIntensityProjection(const BrickedVolume& volume, int z_start, int z_end){
+    return computeProjections(volume, Average, z_start, z_end).average;
 }
 
 // Function to swap two elements
@@ -159,17 +595,13 @@ void Projection::quickSort(unsigned char* arr, int low, int high) {
     }
 }
 
-// Function to check depth of the volume and choose the correct median intensity projection function
+// Function to generate Median Intensity Projection (MeIP) from a 3D volume
 Image Projection::medianIntensityProjection(const Volume& volume, int z_start, int z_end) {
-    // Get the depth of the volume
-    int depth = volume.getDepth();
+    return computeProjections(volume, Median, z_start, z_end).median;
+}
 
-    // Check if the depth is less than 100
-    if (depth < 500) {
-        return medianIntensityProjection_quickSort(volume, z_start, z_end);
-    } else {
-        return medianIntensityProjection_histogram(volume, z_start, z_end);
-    }
+Image Projection::medianIntensityProjection(const BrickedVolume& volume, int z_start, int z_end) {
+    return computeProjections(volume, Median, z_start, z_end).median;
 }
 
 // Function to calculate median intensity projection
@@ -185,15 +617,20 @@ Image Projection::medianIntensityProjection_quickSort(const Volume& volume, int
     int startZ = (z_start == -1) ? 0 : z_start - 1;
     int endZ = (z_end == -1) ? volume.getDepth() : z_end;
 
+    VolumeView<const unsigned char> voxels = volume.view();
+
+    // One intensity buffer, reused for every pixel
+    int bufferSize = endZ - startZ; // Number of elements in the buffer
+    std::vector<unsigned char> buffer(bufferSize);
+    unsigned char* intensityBuffer = buffer.data();
+
     // Iterate through each pixel in the output image
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
-            int bufferSize = endZ - startZ; // Number of elements in the buffer
-            auto* intensityBuffer = new unsigned char[bufferSize]; // Allocate memory for the intensity buffer
 
             // Fill the intensity buffer with intensity values from the volume
             for (int z = startZ; z < endZ; ++z) {
-                intensityBuffer[z - startZ] = volume.getVoxel(x, y, z, 0);
+                intensityBuffer[z - startZ] = voxels(x, y, z);
             }
 
             // Sort the intensity buffer using QuickSort
@@ -210,9 +647,6 @@ Image Projection::medianIntensityProjection_quickSort(const Volume& volume, int
 
             // Set the median intensity value at (x, y) in the output image
             mipImage.setPixel(x, y, 0, medianIntensity);
-
-            // Deallocate memory for the intensity buffer
-            delete[] intensityBuffer;
         }
     }
 
@@ -228,13 +662,15 @@ Image Projection::medianIntensityProjection_histogram(const Volume& volume, int
     int startZ = (z_start == -1) ? 0 : z_start - 1;
     int endZ = (z_end == -1) ? volume.getDepth() : z_end;
 
+    VolumeView<const unsigned char> voxels = volume.view();
+    std::vector<int> histogram(256); // Histogram for intensity values, cleared for every pixel
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
-            std::vector<int> histogram(256, 0); // Histogram for intensity values
+            std::fill(histogram.begin(), histogram.end(), 0);
 
             // Fill the histogram with intensity values for the current pixel
             for (int z = startZ; z < endZ; ++z) {
-                unsigned char intensity = volume.getVoxel(x, y, z, 0);
+                unsigned char intensity = voxels(x, y, z);
                 histogram[intensity]++;
             }
 
@@ -0,0 +1,229 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "Reslice.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Output pixels per side of an oblique sampling tile. A 32 x 32 tile covers a compact patch of the
+// volume, so its trilinear neighbourhoods are mostly shared and stay in cache.
+constexpr int obliqueTileSide = 32;
+
+// Interpolation cell along one axis: lower voxel index and weight of the upper voxel.
+// Returns false more than half a voxel outside [0, size - 1].
+bool locateCell(double position, int size, int& lower, float& weight) {
+    if (position < -0.5 || position >= size - 0.5) {
+        return false;
+    }
+    double clamped = std::min(std::max(position, 0.0), static_cast<double>(size - 1));
+    lower = std::min(static_cast<int>(clamped), std::max(size - 2, 0));
+    weight = static_cast<float>(clamped - lower);
+    return true;
+}
+
+// Trilinear sample of every channel at one position; writes zeros outside the volume
+void sampleVoxel(const Volume& volume, double x, double y, double z, float* values) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+
+    int x0, y0, z0;
+    float fx, fy, fz;
+    if (!locateCell(x, width, x0, fx) || !locateCell(y, height, y0, fy) || !locateCell(z, depth, z0, fz)) {
+        std::fill(values, values + channels, 0.0f);
+        return;
+    }
+
+    // Offsets of the upper neighbours; 0 on an axis of size 1
+    size_t dx = width > 1 ? channels : 0;
+    size_t dy = height > 1 ? static_cast<size_t>(width) * channels : 0;
+    size_t dz = depth > 1 ? static_cast<size_t>(width) * height * channels : 0;
+    const unsigned char* base = volume.getVolumeData()
+                                + ((static_cast<size_t>(z0) * height + y0) * width + x0) * channels;
+
+    for (int c = 0; c < channels; ++c) {
+        const unsigned char* p = base + c;
+        // The a + f * (b - a) form returns a exactly when f is 0, so voxel centres are reproduced exactly
+        float c00 = p[0] + fx * (p[dx] - p[0]);
+        float c10 = p[dy] + fx * (p[dy + dx] - p[dy]);
+        float c01 = p[dz] + fx * (p[dz + dx] - p[dz]);
+        float c11 = p[dz + dy] + fx * (p[dz + dy + dx] - p[dz + dy]);
+        float c0 = c00 + fy * (c10 - c00);
+        float c1 = c01 + fy * (c11 - c01);
+        values[c] = c0 + fz * (c1 - c0);
+    }
+}
+
+} // namespace
+
+Reslice::Plane Reslice::planeThrough(const std::array<double, 3>& centre, const std::array<double, 3>& normal,
+                                     int width, int height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Plane size must be positive.");
+    }
+    double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length == 0.0) {
+        throw std::invalid_argument("Plane normal must not be zero.");
+    }
+    std::array<double, 3> n = {normal[0] / length, normal[1] / length, normal[2] / length};
+
+    // u = z x n is horizontal; for a vertical normal fall back to the x axis
+    std::array<double, 3> u = {-n[1], n[0], 0.0};
+    double uLength = std::sqrt(u[0] * u[0] + u[1] * u[1]);
+    if (uLength < 1e-12) {
+        u = {1.0, 0.0, 0.0};
+    } else {
+        u = {u[0] / uLength, u[1] / uLength, 0.0};
+    }
+    // v = n x u completes the right-handed in-plane basis
+    std::array<double, 3> v = {n[1] * u[2] - n[2] * u[1], n[2] * u[0] - n[0] * u[2], n[0] * u[1] - n[1] * u[0]};
+
+    Plane plane{};
+    for (int axis = 0; axis < 3; ++axis) {
+        plane.origin[axis] = centre[axis] - u[axis] * (width - 1) / 2.0 - v[axis] * (height - 1) / 2.0;
+    }
+    plane.u = u;
+    plane.v = v;
+    plane.width = width;
+    plane.height = height;
+    return plane;
+}
+
+std::vector<Image> Reslice::extractXZ(const Volume& volume, const std::vector<int>& ys) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+    for (int y : ys) {
+        if (y < 0 || y >= height) {
+            throw std::out_of_range("Y coordinate out of range.");
+        }
+    }
+
+    std::vector<Image> slices;
+    slices.reserve(ys.size());
+    for (size_t i = 0; i < ys.size(); ++i) {
+        slices.emplace_back(width, depth, channels);
+    }
+
+    // Row z of an XZ slice is volume row (y, z), already contiguous
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    const unsigned char* data = volume.getVolumeData();
+    Parallel::forRange(0, depth, [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            for (size_t i = 0; i < ys.size(); ++i) {
+                std::memcpy(slices[i].getData() + z * rowBytes,
+                            data + (static_cast<size_t>(z) * height + ys[i]) * rowBytes, rowBytes);
+            }
+        }
+    });
+    return slices;
+}
+
+std::vector<Image> Reslice::extractYZ(const Volume& volume, const std::vector<int>& xs) {
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+    for (int x : xs) {
+        if (x < 0 || x >= width) {
+            throw std::out_of_range("X coordinate out of range.");
+        }
+    }
+
+    std::vector<Image> slices;
+    slices.reserve(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        slices.emplace_back(height, depth, channels);
+    }
+
+    // Visit the volume in storage order and scatter each row's requested voxels, so every
+    // cache line of the volume is loaded at most once however many slices are extracted
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    size_t sliceRowBytes = static_cast<size_t>(height) * channels;
+    const unsigned char* data = volume.getVolumeData();
+    Parallel::forRange(0, depth, [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            for (int y = 0; y < height; ++y) {
+                const unsigned char* row = data + (static_cast<size_t>(z) * height + y) * rowBytes;
+                for (size_t i = 0; i < xs.size(); ++i) {
+                    unsigned char* out = slices[i].getData() + z * sliceRowBytes + static_cast<size_t>(y) * channels;
+                    std::memcpy(out, row + static_cast<size_t>(xs[i]) * channels, channels);
+                }
+            }
+        }
+    });
+    return slices;
+}
+
+std::vector<Image> Reslice::extractOblique(const Volume& volume, const std::vector<Plane>& planes) {
+    int channels = volume.getChannels();
+
+    // Number the tiles of all planes consecutively so one parallel loop covers the whole batch
+    std::vector<Image> images;
+    images.reserve(planes.size());
+    std::vector<int> firstTile(planes.size() + 1, 0);
+    for (size_t p = 0; p < planes.size(); ++p) {
+        if (planes[p].width <= 0 || planes[p].height <= 0) {
+            throw std::invalid_argument("Plane size must be positive.");
+        }
+        images.emplace_back(planes[p].width, planes[p].height, channels);
+        int tilesX = (planes[p].width + obliqueTileSide - 1) / obliqueTileSide;
+        int tilesY = (planes[p].height + obliqueTileSide - 1) / obliqueTileSide;
+        firstTile[p + 1] = firstTile[p] + tilesX * tilesY;
+    }
+
+    Parallel::forRange(0, firstTile.back(), [&](int begin, int end) {
+        std::vector<float> values(channels);
+        for (int tile = begin; tile < end; ++tile) {
+            size_t p = std::upper_bound(firstTile.begin(), firstTile.end(), tile) - firstTile.begin() - 1;
+            const Plane& plane = planes[p];
+            int tilesX = (plane.width + obliqueTileSide - 1) / obliqueTileSide;
+            int tileIndex = tile - firstTile[p];
+            int i0 = (tileIndex % tilesX) * obliqueTileSide;
+            int j0 = (tileIndex / tilesX) * obliqueTileSide;
+            int i1 = std::min(i0 + obliqueTileSide, plane.width);
+            int j1 = std::min(j0 + obliqueTileSide, plane.height);
+
+            unsigned char* out = images[p].getData();
+            for (int j = j0; j < j1; ++j) {
+                for (int i = i0; i < i1; ++i) {
+                    double x = plane.origin[0] + i * plane.u[0] + j * plane.v[0];
+                    double y = plane.origin[1] + i * plane.u[1] + j * plane.v[1];
+                    double z = plane.origin[2] + i * plane.u[2] + j * plane.v[2];
+                    sampleVoxel(volume, x, y, z, values.data());
+                    unsigned char* pixel = out + (static_cast<size_t>(j) * plane.width + i) * channels;
+                    for (int c = 0; c < channels; ++c) {
+                        pixel[c] = static_cast<unsigned char>(std::min(values[c] + 0.5f, 255.0f));
+                    }
+                }
+            }
+        }
+    });
+    return images;
+}
+
+float Reslice::sampleTrilinear(const Volume& volume, double x, double y, double z, int channel) {
+    if (channel < 0 || channel >= volume.getChannels()) {
+        throw std::out_of_range("Channel out of range.");
+    }
+    std::vector<float> values(volume.getChannels());
+    sampleVoxel(volume, x, y, z, values.data());
+    return values[channel];
+}
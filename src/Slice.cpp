@@ -20,8 +20,8 @@ Slice::Slice(int width, int height, int channels, std::unique_ptr<unsigned char[
 
 Slice::Slice(const Slice& other)
         : width(other.width), height(other.height), channels(other.channels),
-          data(std::make_unique<unsigned char[]>(width * height * channels)) {
-    std::copy(&other.data[0], &other.data[width * height * channels], &data[0]);
+          data(std::make_unique<unsigned char[]>(static_cast<size_t>(width) * height * channels)) {
+    std::copy(other.data.get(), other.data.get() + static_cast<size_t>(width) * height * channels, data.get());
 }
 
 Slice::Slice(Slice&& other) noexcept
@@ -54,12 +54,3 @@ int Slice::getChannels() const {
     return channels;
 }
 
-//get the intensity value of a pixel at the specified location and channel
-unsigned char Slice::getPixel(int x, int y, int channel) const {
-    return data[(y * width + x) * channels + channel];
-}
-
-//set the intensity value of a pixel at the specified location and channel
-void Slice::setPixel(int x, int y, int channel, unsigned char value) {
-    data[(y * width + x) * channels + channel] = value;
-}
@@ -0,0 +1,224 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "TypedFilter.h"
+#include "Filter.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Separable blur in the same order as Filter::gaussianBlur, so 8-bit results match it exactly
+template <typename T>
+void TypedFilter::gaussianBlur(const TypedImage<T>& image, TypedImage<T>& output, int kernelSize, float sigma) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd");
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    int channels = image.getChannels();
+    int radius = kernelSize / 2;
+    const std::vector<float>& kernel = Filter::gaussianKernel1D(kernelSize, sigma);
+
+    const T* src = image.getData();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+
+    // Horizontal pass into a float buffer so no precision is lost between the passes
+    std::vector<float> horizontal(rowStride * height);
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const T* srcRow = src + y * rowStride;
+            float* outRow = horizontal.data() + y * rowStride;
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    float blurredPixel = 0.0f;
+                    for (int kx = -radius; kx <= radius; ++kx) {
+                        int pixelPosX = std::clamp(x + kx, 0, width - 1);
+                        blurredPixel += static_cast<float>(srcRow[pixelPosX * channels + c]) * kernel[kx + radius];
+                    }
+                    outRow[x * channels + c] = blurredPixel;
+                }
+            }
+        }
+    });
+
+    // The source is fully consumed, so the output may now reuse its buffer even when applied in place
+    output.resize(width, height, channels);
+    T* dst = output.getData();
+
+    // Vertical pass, accumulating whole rows at a time
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        std::vector<float> accumulator(rowStride);
+        for (int y = yBegin; y < yEnd; ++y) {
+            std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+            for (int ky = -radius; ky <= radius; ++ky) {
+                int pixelPosY = std::clamp(y + ky, 0, height - 1);
+                const float* inRow = horizontal.data() + pixelPosY * rowStride;
+                float weight = kernel[ky + radius];
+                for (size_t i = 0; i < rowStride; ++i) {
+                    accumulator[i] += inRow[i] * weight;
+                }
+            }
+
+            T* dstRow = dst + y * rowStride;
+            for (size_t i = 0; i < rowStride; ++i) {
+                dstRow[i] = PixelTraits<T>::fromFloat(accumulator[i]);
+            }
+        }
+    });
+}
+
+template <typename T>
+void TypedFilter::sobel(const TypedImage<T>& image, TypedImage<T>& output) {
+    if (&image == &output) {
+        TypedImage<T> result;
+        sobel(image, result);
+        output = std::move(result);
+        return;
+    }
+
+    int width = image.getWidth();
+    int height = image.getHeight();
+    output.resize(width, height, 1);
+
+    PlaneView<const T> in = image.view();
+    PlaneView<T> out = output.view();
+    size_t step = in.getPixelStride();
+    Parallel::forRange(0, height, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            T* dst = out.row(y);
+            // Border pixels have no full neighbourhood and stay 0
+            if (y == 0 || y == height - 1) {
+                std::fill(dst, dst + width, T(0));
+                continue;
+            }
+            const T* above = in.row(y - 1);
+            const T* centre = in.row(y);
+            const T* below = in.row(y + 1);
+            dst[0] = T(0);
+            for (int x = 1; x < width - 1; ++x) {
+                size_t left = (x - 1) * step, middle = x * step, right = (x + 1) * step;
+                float sumX = (static_cast<float>(above[right]) - static_cast<float>(above[left]))
+                             + 2.0f * (static_cast<float>(centre[right]) - static_cast<float>(centre[left]))
+                             + (static_cast<float>(below[right]) - static_cast<float>(below[left]));
+                float sumY = (static_cast<float>(below[left]) - static_cast<float>(above[left]))
+                             + 2.0f * (static_cast<float>(below[middle]) - static_cast<float>(above[middle]))
+                             + (static_cast<float>(below[right]) - static_cast<float>(above[right]));
+                dst[x] = PixelTraits<T>::fromFloat(std::sqrt(sumX * sumX + sumY * sumY));
+            }
+            if (width > 1) {
+                dst[width - 1] = T(0);
+            }
+        }
+    });
+}
+
+// Same pass order as Filter::apply3DGaussianBlur (z, then y, then x), so 8-bit results match it exactly
+template <typename T>
+void TypedFilter::apply3DGaussianBlur(TypedVolume<T>& volume, int kernelSize, float sigma) {
+    if (kernelSize % 2 == 0) {
+        throw std::invalid_argument("Kernel size must be odd.");
+    }
+
+    const std::vector<float>& kernel = Filter::gaussianKernel1D(kernelSize, sigma);
+    int radius = kernelSize / 2;
+    int width = volume.getWidth();
+    int height = volume.getHeight();
+    int depth = volume.getDepth();
+    int channels = volume.getChannels();
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t sliceSize = rowStride * height;
+
+    const T* src = volume.getData();
+    TypedVolume<T> blurredVolume(width, height, depth, channels);
+    T* dst = blurredVolume.getData();
+
+    // The z pass reads the source samples in place, so each thread only keeps the kernelSize z-blurred
+    // float rows the y pass needs instead of a float copy of the whole volume
+    Parallel::forRange(0, depth, [&](int zBegin, int zEnd) {
+        // Ring of z-blurred rows; row y lives in slot y % kernelSize, which is unique inside the window
+        std::vector<float> ring(static_cast<size_t>(kernelSize) * rowStride);
+        std::vector<int> ringRow(kernelSize);
+        std::vector<float> columnBlurred(rowStride);
+        std::vector<const T*> window(kernelSize);
+        std::vector<const float*> rows(kernelSize);
+
+        for (int z = zBegin; z < zEnd; ++z) {
+            for (int kz = -radius; kz <= radius; ++kz) {
+                window[kz + radius] = src + std::clamp(z + kz, 0, depth - 1) * sliceSize;
+            }
+            std::fill(ringRow.begin(), ringRow.end(), -1);
+
+            // Blurs row y of slice z along z into its ring slot
+            auto blurRow = [&](int y) -> const float* {
+                int slot = y % kernelSize;
+                float* out = ring.data() + slot * rowStride;
+                if (ringRow[slot] == y) {
+                    return out;
+                }
+                std::fill(out, out + rowStride, 0.0f);
+                for (int k = 0; k < kernelSize; ++k) {
+                    const T* inRow = window[k] + y * rowStride;
+                    float weight = kernel[k];
+                    for (size_t i = 0; i < rowStride; ++i) {
+                        out[i] += static_cast<float>(inRow[i]) * weight;
+                    }
+                }
+                ringRow[slot] = y;
+                return out;
+            };
+
+            T* dstSlice = dst + z * sliceSize;
+            for (int y = 0; y < height; ++y) {
+                // y pass over the ring, then x pass into the output row
+                for (int ky = -radius; ky <= radius; ++ky) {
+                    rows[ky + radius] = blurRow(std::clamp(y + ky, 0, height - 1));
+                }
+                std::fill(columnBlurred.begin(), columnBlurred.end(), 0.0f);
+                for (int k = 0; k < kernelSize; ++k) {
+                    const float* inRow = rows[k];
+                    float weight = kernel[k];
+                    for (size_t i = 0; i < rowStride; ++i) {
+                        columnBlurred[i] += inRow[i] * weight;
+                    }
+                }
+
+                T* dstRow = dstSlice + y * rowStride;
+                for (int x = 0; x < width; ++x) {
+                    for (int c = 0; c < channels; ++c) {
+                        float sum = 0.0f;
+                        for (int kx = -radius; kx <= radius; ++kx) {
+                            sum += columnBlurred[std::clamp(x + kx, 0, width - 1) * channels + c] * kernel[kx + radius];
+                        }
+                        dstRow[x * channels + c] = PixelTraits<T>::fromFloat(sum);
+                    }
+                }
+            }
+        }
+    });
+
+    volume = std::move(blurredVolume);
+}
+
+template void TypedFilter::gaussianBlur<uint8_t>(const TypedImage<uint8_t>&, TypedImage<uint8_t>&, int, float);
+template void TypedFilter::gaussianBlur<uint16_t>(const TypedImage<uint16_t>&, TypedImage<uint16_t>&, int, float);
+template void TypedFilter::gaussianBlur<float>(const TypedImage<float>&, TypedImage<float>&, int, float);
+template void TypedFilter::sobel<uint8_t>(const TypedImage<uint8_t>&, TypedImage<uint8_t>&);
+template void TypedFilter::sobel<uint16_t>(const TypedImage<uint16_t>&, TypedImage<uint16_t>&);
+template void TypedFilter::sobel<float>(const TypedImage<float>&, TypedImage<float>&);
+template void TypedFilter::apply3DGaussianBlur<uint8_t>(TypedVolume<uint8_t>&, int, float);
+template void TypedFilter::apply3DGaussianBlur<uint16_t>(TypedVolume<uint16_t>&, int, float);
+template void TypedFilter::apply3DGaussianBlur<float>(TypedVolume<float>&, int, float);
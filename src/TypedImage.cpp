@@ -0,0 +1,96 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "TypedImage.h"
+#include "stb_image.h"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// Reads a file's samples into T without rescaling; 16-bit files go through stbi_load_16
+template <typename T>
+std::vector<T> loadSamples(const std::string& filename, int& width, int& height, int& channels) {
+    std::vector<T> samples;
+    if (stbi_is_16_bit(filename.c_str()) && sizeof(T) > 1) {
+        std::unique_ptr<stbi_us, decltype(&stbi_image_free)> pixels(
+                stbi_load_16(filename.c_str(), &width, &height, &channels, STBI_default), &stbi_image_free);
+        if (!pixels) {
+            throw std::runtime_error("Failed to load image: " + filename);
+        }
+        samples.assign(pixels.get(), pixels.get() + static_cast<size_t>(width) * height * channels);
+    } else {
+        std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels(
+                stbi_load(filename.c_str(), &width, &height, &channels, STBI_default), &stbi_image_free);
+        if (!pixels) {
+            throw std::runtime_error("Failed to load image: " + filename);
+        }
+        samples.assign(pixels.get(), pixels.get() + static_cast<size_t>(width) * height * channels);
+    }
+    return samples;
+}
+
+} // namespace
+
+template <typename T>
+TypedImage<T>::TypedImage(int width, int height, int channels)
+        : width(width), height(height), channels(channels) {
+    if (width < 0 || height < 0 || channels < 0) {
+        throw std::invalid_argument("Image dimensions must not be negative.");
+    }
+    data.assign(getSize(), T(0));
+}
+
+template <typename T>
+TypedImage<T> TypedImage<T>::load(const std::string& filename) {
+    TypedImage image;
+    image.data = loadSamples<T>(filename, image.width, image.height, image.channels);
+    return image;
+}
+
+template <typename T>
+TypedImage<T> TypedImage<T>::fromImage(const Image& image) {
+    TypedImage result(image.getWidth(), image.getHeight(), image.getChannels());
+    std::copy(image.getData(), image.getData() + image.getSize(), result.data.begin());
+    return result;
+}
+
+template <typename T>
+Image TypedImage<T>::toImage() const {
+    Image result(width, height, channels);
+    unsigned char* out = result.getData();
+    for (size_t i = 0; i < data.size(); ++i) {
+        out[i] = PixelTraits<uint8_t>::fromFloat(static_cast<float>(data[i]));
+    }
+    return result;
+}
+
+template <typename T>
+Image TypedImage<T>::toImage(float low, float high) const {
+    if (!(high > low)) {
+        throw std::invalid_argument("The display window must have high > low.");
+    }
+    Image result(width, height, channels);
+    unsigned char* out = result.getData();
+    float scale = 255.0f / (high - low);
+    for (size_t i = 0; i < data.size(); ++i) {
+        float value = (static_cast<float>(data[i]) - low) * scale;
+        out[i] = static_cast<unsigned char>(std::lround(std::min(std::max(value, 0.0f), 255.0f)));
+    }
+    return result;
+}
+
+template class TypedImage<uint8_t>;
+template class TypedImage<uint16_t>;
+template class TypedImage<float>;
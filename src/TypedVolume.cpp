@@ -0,0 +1,99 @@
+/*
+ * Group: Ziggurat
+ *
+ * Members:
+ * - Xiaoye Zhang (GitHub: acse-xz4019)
+ * - Melissa Sim (GitHub: acse-mys20)
+ * - Wenhao Hong (GitHub: acse-wh623)
+ * - Javonne Porter (GitHub: acse-jp2923)
+ * - Tianju (Tim) Du (GitHub: edsml-td323)
+ * - Wenxin Li (GitHub: edsml-wl123)
+ */
+
+#include "TypedVolume.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+template <typename T>
+TypedVolume<T>::TypedVolume(int width, int height, int depth, int channels)
+        : width(width), height(height), depth(depth), channels(channels) {
+    if (width < 0 || height < 0 || depth < 0 || channels < 0) {
+        throw std::invalid_argument("Volume dimensions must not be negative.");
+    }
+    data.assign(getSize(), T(0));
+}
+
+// Decode the slices in parallel, each straight into its place in the volume
+template <typename T>
+TypedVolume<T> TypedVolume<T>::loadSlices(const std::string& folderPath) {
+    std::vector<std::string> filenames = Volume::listSliceFiles(folderPath);
+    if (filenames.empty()) {
+        throw std::runtime_error("Volume is empty, no slices to generate 3D data from.");
+    }
+    Volume::sortSliceFilenames(filenames);
+
+    // The first slice fixes the layout; the others must match it
+    TypedImage<T> first = TypedImage<T>::load(filenames[0]);
+    TypedVolume volume(first.getWidth(), first.getHeight(), static_cast<int>(filenames.size()), first.getChannels());
+    size_t sliceSize = first.getSize();
+    std::copy(first.getData(), first.getData() + sliceSize, volume.data.begin());
+
+    Parallel::forRange(1, volume.depth, [&](int zBegin, int zEnd) {
+        for (int z = zBegin; z < zEnd; ++z) {
+            TypedImage<T> slice = TypedImage<T>::load(filenames[z]);
+            if (slice.getWidth() != volume.width || slice.getHeight() != volume.height
+                || slice.getChannels() != volume.channels) {
+                throw std::runtime_error("Slice " + filenames[z] + " does not match the size and channels of "
+                                         + filenames[0]);
+            }
+            std::copy(slice.getData(), slice.getData() + sliceSize, volume.data.begin() + z * sliceSize);
+        }
+    }, 1);
+    return volume;
+}
+
+template <typename T>
+TypedVolume<T> TypedVolume<T>::fromVolume(const Volume& volume) {
+    TypedVolume result(volume.getWidth(), volume.getHeight(), volume.getDepth(), volume.getChannels());
+    std::copy(volume.getVolumeData(), volume.getVolumeData() + result.getSize(), result.data.begin());
+    return result;
+}
+
+template <typename T>
+Volume TypedVolume<T>::toVolume() const {
+    Volume result(width, height, depth, channels);
+    unsigned char* out = result.getVolumeData();
+    for (size_t i = 0; i < data.size(); ++i) {
+        out[i] = PixelTraits<uint8_t>::fromFloat(static_cast<float>(data[i]));
+    }
+    return result;
+}
+
+// Window every slice through TypedImage so volumes and images display the same way
+template <typename T>
+Volume TypedVolume<T>::toVolume(float low, float high) const {
+    Volume result(width, height, depth, channels);
+    size_t sliceSize = static_cast<size_t>(width) * height * channels;
+    for (int z = 0; z < depth; ++z) {
+        Image slice = getSlice(z).toImage(low, high);
+        std::copy(slice.getData(), slice.getData() + sliceSize, result.getVolumeData() + z * sliceSize);
+    }
+    return result;
+}
+
+template <typename T>
+TypedImage<T> TypedVolume<T>::getSlice(int z) const {
+    if (z < 0 || z >= depth) {
+        throw std::out_of_range("Slice index is out of range.");
+    }
+    TypedImage<T> slice(width, height, channels);
+    size_t sliceSize = slice.getSize();
+    std::copy(data.begin() + z * sliceSize, data.begin() + (z + 1) * sliceSize, slice.getData());
+    return slice;
+}
+
+template class TypedVolume<uint8_t>;
+template class TypedVolume<uint16_t>;
+template class TypedVolume<float>;
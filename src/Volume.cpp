@@ -14,75 +14,208 @@
 #include "stb_image.h"
 #include "stb_image_write.h"
 #include "Slice.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <new>
 #include <iostream>
 
-// custom comparison function for natural sorting
-bool naturalSort(const std::string& a, const std::string& b) {
-    std::regex re("(\\d+)");
-    std::sregex_iterator it_a(a.begin(), a.end(), re), it_b(b.begin(), b.end(), re);
-    std::sregex_iterator end;
-
-    // compare each matched number
-    while (it_a != end && it_b != end) {
-        int num_a = std::stoi(it_a->str());
-        int num_b = std::stoi(it_b->str());
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Fixed-size header at the start of a raw volume file, stored in native byte order
+struct RawVolumeHeader {
+    char magic[8];          // "ZIGVOL\0\0"
+    uint32_t byteOrder;     // rawByteOrderMark as written by this machine
+    uint32_t version;
+    uint64_t payloadOffset; // Volume::rawPayloadOffset
+    uint64_t payloadBytes;  // width * height * depth * channels
+    int32_t width;
+    int32_t height;
+    int32_t depth;
+    int32_t channels;
+};
+
+const char rawMagic[8] = {'Z', 'I', 'G', 'V', 'O', 'L', '\0', '\0'};
+const uint32_t rawByteOrderMark = 0x01020304;
+const uint32_t rawVersion = 1;
+
+static_assert(sizeof(RawVolumeHeader) <= Volume::rawPayloadOffset, "Raw volume header must fit before the payload");
+
+// Largest payload a volume can index: voxel offsets are size_t and are added to pointers
+const uint64_t maxRawPayloadBytes = std::min<uint64_t>(SIZE_MAX, PTRDIFF_MAX);
+
+// Checks a header read from `path` against the file size, throwing if it is not a usable raw volume
+void validateRawHeader(const RawVolumeHeader& header, uint64_t fileSize, const std::string& path) {
+    if (std::memcmp(header.magic, rawMagic, sizeof(rawMagic)) != 0) {
+        throw std::runtime_error("Not a raw volume file: " + path);
+    }
+    if (header.byteOrder != rawByteOrderMark || header.version != rawVersion) {
+        throw std::runtime_error("Unsupported raw volume version or byte order: " + path);
+    }
+    if (header.width <= 0 || header.height <= 0 || header.depth <= 0 || header.channels <= 0) {
+        throw std::runtime_error("Corrupt or truncated raw volume file: " + path);
+    }
 
-        if (num_a != num_b) {
-            return num_a < num_b;
+    // Multiply one dimension at a time so a crafted header cannot wrap the product round to a small size
+    uint64_t voxelBytes = 1;
+    for (int32_t dimension : {header.width, header.height, header.depth, header.channels}) {
+        if (voxelBytes > maxRawPayloadBytes / static_cast<uint64_t>(dimension)) {
+            throw std::runtime_error("Raw volume is too large to address: " + path);
         }
-        ++it_a;
-        ++it_b;
+        voxelBytes *= static_cast<uint64_t>(dimension);
+    }
+    if (header.payloadBytes != voxelBytes || header.payloadOffset < sizeof(RawVolumeHeader)
+        || header.payloadBytes > fileSize || header.payloadOffset > fileSize - header.payloadBytes) {
+        throw std::runtime_error("Corrupt or truncated raw volume file: " + path);
     }
+}
 
-    // if all numbers are equal, sort based on original string
-    return a < b;
+// Writes the header and padding up to the payload offset
+void writeRawHeader(std::ofstream& file, int width, int height, int depth, int channels) {
+    RawVolumeHeader header{};
+    std::memcpy(header.magic, rawMagic, sizeof(rawMagic));
+    header.byteOrder = rawByteOrderMark;
+    header.version = rawVersion;
+    header.payloadOffset = Volume::rawPayloadOffset;
+    header.payloadBytes = static_cast<uint64_t>(width) * height * depth * channels;
+    header.width = width;
+    header.height = height;
+    header.depth = depth;
+    header.channels = channels;
+
+    std::vector<char> block(Volume::rawPayloadOffset, 0);
+    std::memcpy(block.data(), &header, sizeof(header));
+    file.write(block.data(), static_cast<std::streamsize>(block.size()));
 }
 
-// custom sorting function for natural sorting
-void customSort(std::vector<std::string>& files) {
-    for (size_t i = 1; i < files.size(); ++i) {
-        std::string key = files[i];
-        int j = i - 1;
+// Natural-order sort key of a filename: the digit runs it contains, tokenised once
+struct NaturalKey {
+    std::string* name;
+    std::vector<std::pair<size_t, size_t>> numbers; ///< Start and length of each digit run, leading zeros skipped
+};
+
+NaturalKey makeNaturalKey(std::string& name) {
+    NaturalKey key{&name, {}};
+    size_t i = 0;
+    while (i < name.size()) {
+        if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+            ++i;
+            continue;
+        }
+        size_t end = i;
+        while (end < name.size() && std::isdigit(static_cast<unsigned char>(name[end]))) {
+            ++end;
+        }
+        // Skip leading zeros but keep the last digit, so "000" reads as "0"
+        while (i + 1 < end && name[i] == '0') {
+            ++i;
+        }
+        key.numbers.emplace_back(i, end - i);
+        i = end;
+    }
+    return key;
+}
 
-        // 将files[i]移动到它在前面子数组中的正确位置
-        while (j >= 0 && naturalSort(key, files[j])) {
-            files[j + 1] = files[j];
-            j = j - 1;
+// Numbers compare by value: a shorter run (without leading zeros) is smaller, equal lengths compare digit-wise.
+// Comparing digit strings rather than parsed integers also orders numbers too long for any integer type.
+bool naturalLess(const NaturalKey& a, const NaturalKey& b) {
+    size_t shared = std::min(a.numbers.size(), b.numbers.size());
+    for (size_t n = 0; n < shared; ++n) {
+        auto [aStart, aLength] = a.numbers[n];
+        auto [bStart, bLength] = b.numbers[n];
+        if (aLength != bLength) {
+            return aLength < bLength;
         }
-        files[j + 1] = key;
+        int order = a.name->compare(aStart, aLength, *b.name, bStart, bLength);
+        if (order != 0) {
+            return order < 0;
+        }
+    }
+    if (a.numbers.size() != b.numbers.size()) {
+        return a.numbers.size() < b.numbers.size();
     }
+    return *a.name < *b.name;
+}
+
+} // namespace
+
+// Sort slice filenames by precomputed natural-order keys
+void Volume::sortSliceFilenames(std::vector<std::string>& filenames) {
+    std::vector<NaturalKey> keys;
+    keys.reserve(filenames.size());
+    for (std::string& name : filenames) {
+        keys.push_back(makeNaturalKey(name));
+    }
+    std::sort(keys.begin(), keys.end(), naturalLess);
+
+    std::vector<std::string> sorted;
+    sorted.reserve(filenames.size());
+    for (const NaturalKey& key : keys) {
+        sorted.push_back(std::move(*key.name));
+    }
+    filenames = std::move(sorted);
 }
 
 // Volume constructor that loads images from a folder
 Volume::Volume(const std::string& folderPath) : data(nullptr), width(0), height(0), depth(0), channels(0) {
-    loadImagesFromFolder(folderPath);
-    generate3DVolumeFromSlices();
+    loadSlices(listSliceFiles(folderPath));
 }
 
 // Volume constructor that loads images from a list of filenames
 Volume::Volume(const std::vector<std::string>& filenames) : data(nullptr), width(0), height(0), depth(0), channels(0) {
-    loadImagesFromFilenames(filenames);
-    generate3DVolumeFromSlices();
+    loadSlices(filenames);
 }
 
 // Volume constructor that Constructs an Volume object with given shape and use 0 to hold the position.
 Volume::Volume(int width, int height, int depth, int channels) : data(nullptr), width(width), height(height), depth(depth), channels(channels) {
     size_t totalSize = static_cast<size_t>(width) * height * depth * channels;
-    data = new unsigned char[totalSize];
-    std::memset(data, 0, totalSize);
+    // Volume buffers use the C allocator throughout, like Image, so they are always released with std::free
+    data = static_cast<unsigned char*>(std::calloc(totalSize == 0 ? 1 : totalSize, 1));
+    if (!data) {
+        throw std::bad_alloc();
+    }
 }
 
+// Empty volume, filled in by openRaw
+Volume::Volume() : data(nullptr), width(0), height(0), depth(0), channels(0) {}
+
 // Volume destructor
 Volume::~Volume() {
-    if (data) {
-        stbi_image_free(data);
+    release();
+}
+
+// Free or unmap the voxel buffer
+void Volume::release() noexcept {
+    if (mappedBase) {
+#ifndef _WIN32
+        munmap(mappedBase, mappedLength);
+#endif
+        mappedBase = nullptr;
+        mappedLength = 0;
+    } else {
+        std::free(data);
     }
+    data = nullptr;
 }
 
 // Move constructor for Volume class
-Volume::Volume(Volume&& other) noexcept : slices(std::move(other.slices)), data(other.data), width(other.width), height(other.height), depth(other.depth), channels(other.channels) {
+Volume::Volume(Volume&& other) noexcept : data(other.data), width(other.width), height(other.height), depth(other.depth), channels(other.channels),
+                                           mappedBase(other.mappedBase), mappedLength(other.mappedLength) {
     other.data = nullptr;
+    other.mappedBase = nullptr;
+    other.mappedLength = 0;
     other.width = 0;
     other.height = 0;
     other.depth = 0;
@@ -92,14 +225,17 @@ Volume::Volume(Volume&& other) noexcept : slices(std::move(other.slices)), data(
 // Move assignment operator for Volume class
 Volume& Volume::operator=(Volume&& other) noexcept {
     if (this != &other) {
-        slices = std::move(other.slices);
-        stbi_image_free(data); // Free existing data
+        release(); // Free existing data
         data = other.data;
         width = other.width;
         height = other.height;
         depth = other.depth;
         channels = other.channels;
+        mappedBase = other.mappedBase;
+        mappedLength = other.mappedLength;
         other.data = nullptr;
+        other.mappedBase = nullptr;
+        other.mappedLength = 0;
         other.width = 0;
         other.height = 0;
         other.depth = 0;
@@ -108,22 +244,22 @@ Volume& Volume::operator=(Volume&& other) noexcept {
     return *this;
 }
 
+// Copies of a mapped volume get their own heap buffer
 Volume::Volume(const Volume& other)
         : width(other.width), height(other.height), depth(other.depth), channels(other.channels) {
-    // Copy the slices. Assuming Image has a copy constructor.
-    slices.reserve(other.slices.size());
-    for (const auto& slice : other.slices) {
-        slices.push_back(std::make_shared<Image>(*slice));
-    }
-
     // Deep copy of the raw volume data.
     size_t totalSize = static_cast<size_t>(width) * height * depth * channels;
-    data = new unsigned char[totalSize];
-    std::memcpy(data, other.data, totalSize);
+    data = static_cast<unsigned char*>(std::malloc(totalSize == 0 ? 1 : totalSize));
+    if (!data) {
+        throw std::bad_alloc();
+    }
+    if (other.data) {
+        std::memcpy(data, other.data, totalSize);
+    }
 }
 
-// Load images from a folder path
-void Volume::loadImagesFromFolder(const std::string& folderPath) {
+// List the .png slices in a folder
+std::vector<std::string> Volume::listSliceFiles(const std::string& folderPath) {
     std::vector<std::string> imagePaths;
     for (const auto& entry : fs::directory_iterator(folderPath)) {
         // check if the entry is ending with .png
@@ -131,39 +267,194 @@ void Volume::loadImagesFromFolder(const std::string& folderPath) {
             imagePaths.push_back(entry.path().string());
         }
     }
-    loadImagesFromFilenames(imagePaths);
+    return imagePaths;
+}
+
+// Decode slices [first, first + count) in parallel, each straight into its place in destination
+void Volume::decodeSlices(const std::vector<std::string>& sortedFilenames, int first, int count, int sliceWidth,
+                          int sliceHeight, int sliceChannels, unsigned char* destination) {
+    size_t singleImageSize = static_cast<size_t>(sliceWidth) * sliceHeight * sliceChannels;
+
+    // One slice per band; each decoded slice is freed as soon as it has been copied into place
+    Parallel::forRange(0, count, [&](int zBegin, int zEnd) {
+        for (int z = zBegin; z < zEnd; ++z) {
+            const std::string& filename = sortedFilenames[first + z];
+            int w = 0, h = 0, fileChannels = 0;
+            std::unique_ptr<unsigned char, decltype(&stbi_image_free)> pixels(
+                    stbi_load(filename.c_str(), &w, &h, &fileChannels, sliceChannels), &stbi_image_free);
+            if (!pixels) {
+                throw std::runtime_error("Failed to load image: " + filename);
+            }
+            if (w != sliceWidth || h != sliceHeight) {
+                throw std::runtime_error("Slice " + filename + " is " + std::to_string(w) + "x" + std::to_string(h)
+                                         + " but the volume is " + std::to_string(sliceWidth) + "x"
+                                         + std::to_string(sliceHeight));
+            }
+            std::memcpy(destination + z * singleImageSize, pixels.get(), singleImageSize);
+        }
+    }, 1);
 }
 
-// Load images from a list of filenames
-void Volume::loadImagesFromFilenames(const std::vector<std::string>& filenames) {
+// Decode the slices in parallel, each straight into its place in the volume buffer
+void Volume::loadSlices(const std::vector<std::string>& filenames) {
+    if (filenames.empty()) {
+        throw std::runtime_error("Volume is empty, no slices to generate 3D data from.");
+    }
+
     std::vector<std::string> sortedFilenames = filenames;
-    customSort(sortedFilenames);
+    sortSliceFilenames(sortedFilenames);
+
+    // The first slice's header fixes the layout, so the buffer can be allocated before anything is decoded
+    int sliceWidth = 0, sliceHeight = 0, sliceChannels = 0;
+    if (!stbi_info(sortedFilenames[0].c_str(), &sliceWidth, &sliceHeight, &sliceChannels)) {
+        throw std::runtime_error("Failed to load image: " + sortedFilenames[0]);
+    }
+    int sliceCount = static_cast<int>(sortedFilenames.size());
+    size_t singleImageSize = static_cast<size_t>(sliceWidth) * sliceHeight * sliceChannels;
+
+    // Owned locally until every slice is in place, so a failed load does not leak the buffer
+    std::unique_ptr<unsigned char, decltype(&std::free)> buffer(
+            static_cast<unsigned char*>(std::malloc(singleImageSize * sliceCount)), &std::free);
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+
+    decodeSlices(sortedFilenames, 0, sliceCount, sliceWidth, sliceHeight, sliceChannels, buffer.get());
+
+    release();
+    data = buffer.release();
+    width = sliceWidth;
+    height = sliceHeight;
+    channels = sliceChannels;
+    depth = sliceCount;
+    std::cout << "Loaded " << depth << " slices of " << width << "x" << height << "x" << channels << ".\n";
+}
+
+// Open a raw volume file, mapping it where the platform allows
+Volume Volume::openRaw(const std::string& path) {
+    Volume volume;
+    RawVolumeHeader header{};
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open raw volume: " + path);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(RawVolumeHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Corrupt or truncated raw volume file: " + path);
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    // Private and writable: pages are loaded on first touch and any changes stay in this process
+    void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Failed to map raw volume: " + path);
+    }
+    volume.mappedBase = base;
+    volume.mappedLength = length;
+
+    std::memcpy(&header, base, sizeof(header));
+    validateRawHeader(header, length, path);
+    volume.data = static_cast<unsigned char*>(base) + header.payloadOffset;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open raw volume: " + path);
+    }
+    auto fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    if (fileSize < sizeof(RawVolumeHeader) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Corrupt or truncated raw volume file: " + path);
+    }
+    validateRawHeader(header, fileSize, path);
+    volume.data = static_cast<unsigned char*>(std::malloc(header.payloadBytes));
+    if (!volume.data) {
+        throw std::bad_alloc();
+    }
+    file.seekg(static_cast<std::streamoff>(header.payloadOffset));
+    if (!file.read(reinterpret_cast<char*>(volume.data), static_cast<std::streamsize>(header.payloadBytes))) {
+        throw std::runtime_error("Corrupt or truncated raw volume file: " + path);
+    }
+#endif
+    volume.width = header.width;
+    volume.height = header.height;
+    volume.depth = header.depth;
+    volume.channels = header.channels;
+    return volume;
+}
+
+// Write the volume as a raw volume file
+void Volume::saveRaw(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to create raw volume: " + path);
+    }
+    writeRawHeader(file, width, height, depth, channels);
+    file.write(reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>(static_cast<size_t>(width) * height * depth * channels));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write raw volume: " + path);
+    }
+}
 
-    for (const auto& filename : sortedFilenames) {
-        // print what file is being loaded
-        std::cout << "Loading file:" << filename << std::endl;
-        auto image = std::make_shared<Image>(filename);
-        slices.push_back(image);
+// Create a zero-filled raw volume file; seeking past the end leaves the payload as a hole
+void Volume::createRaw(const std::string& path, int width, int height, int depth, int channels) {
+    if (width <= 0 || height <= 0 || depth <= 0 || channels <= 0) {
+        throw std::invalid_argument("Raw volume dimensions must be positive.");
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to create raw volume: " + path);
+    }
+    writeRawHeader(file, width, height, depth, channels);
+    uint64_t payloadBytes = static_cast<uint64_t>(width) * height * depth * channels;
+    file.seekp(static_cast<std::streamoff>(rawPayloadOffset + payloadBytes - 1));
+    file.put('\0');
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write raw volume: " + path);
     }
 }
 
-// Generate 3D volume data from slices
-void Volume::generate3DVolumeFromSlices() {
-    if (slices.empty()) {
+// Convert a folder of .png slices to a raw volume file, a few slices at a time
+void Volume::convertSlicesToRaw(const std::string& folderPath, const std::string& rawPath) {
+    std::vector<std::string> sortedFilenames = listSliceFiles(folderPath);
+    if (sortedFilenames.empty()) {
         throw std::runtime_error("Volume is empty, no slices to generate 3D data from.");
     }
+    sortSliceFilenames(sortedFilenames);
 
-    width = slices[0]->getWidth();
-    height = slices[0]->getHeight();
-    channels = slices[0]->getChannels();
-    depth = static_cast<int>(slices.size());
+    int sliceWidth = 0, sliceHeight = 0, sliceChannels = 0;
+    if (!stbi_info(sortedFilenames[0].c_str(), &sliceWidth, &sliceHeight, &sliceChannels)) {
+        throw std::runtime_error("Failed to load image: " + sortedFilenames[0]);
+    }
+    int sliceCount = static_cast<int>(sortedFilenames.size());
+    size_t singleImageSize = static_cast<size_t>(sliceWidth) * sliceHeight * sliceChannels;
 
-    size_t singleImageSize = width * height * channels;
-    size_t totalSize = singleImageSize * depth;
-    data = new unsigned char[totalSize];
-    for (size_t i = 0; i < slices.size(); ++i) {
-        std::memcpy(data + i * singleImageSize, slices[i]->getData(), singleImageSize);
+    std::ofstream file(rawPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to create raw volume: " + rawPath);
     }
+    writeRawHeader(file, sliceWidth, sliceHeight, sliceCount, sliceChannels);
+
+    // Two slices per thread keeps every thread busy while bounding memory to a small batch
+    int batch = std::max(1, 2 * Parallel::getThreadCount());
+    std::vector<unsigned char> buffer(singleImageSize * std::min(batch, sliceCount));
+    for (int first = 0; first < sliceCount; first += batch) {
+        int count = std::min(batch, sliceCount - first);
+        decodeSlices(sortedFilenames, first, count, sliceWidth, sliceHeight, sliceChannels, buffer.data());
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(singleImageSize * count));
+    }
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write raw volume: " + rawPath);
+    }
+}
+
+bool Volume::isMapped() const {
+    return mappedBase != nullptr;
 }
 
 // Get a slice of the volume at the specified index
@@ -191,15 +482,11 @@ std::unique_ptr<Slice> Volume::getSliceXZ(int y) const {
         throw std::out_of_range("Y coordinate out of range.");
     }
 
-    auto sliceData = std::make_unique<unsigned char[]>(width * depth * channels);
+    // Row z of the slice is volume row (y, z), so it is copied whole
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    auto sliceData = std::make_unique<unsigned char[]>(rowBytes * depth);
     for (int z = 0; z < depth; ++z) {
-        for (int x = 0; x < width; ++x) {
-            for (int c = 0; c < channels; ++c) {
-                int volIndex = ((z * height + y) * width + x) * channels + c;
-                int sliceIndex = (z * width + x) * channels + c;
-                sliceData[sliceIndex] = data[volIndex];
-            }
-        }
+        std::memcpy(sliceData.get() + z * rowBytes, data + (static_cast<size_t>(z) * height + y) * rowBytes, rowBytes);
     }
     return std::make_unique<Slice>(width, depth, channels, std::move(sliceData));
 }
@@ -209,12 +496,12 @@ std::unique_ptr<Slice> Volume::getSliceYZ(int x) const {
         throw std::out_of_range("X coordinate out of range.");
     }
 
-    auto sliceData = std::make_unique<unsigned char[]>(height * depth * channels);
+    auto sliceData = std::make_unique<unsigned char[]>(static_cast<size_t>(height) * depth * channels);
     for (int z = 0; z < depth; ++z) {
         for (int y = 0; y < height; ++y) {
             for (int c = 0; c < channels; ++c) {
-                int volIndex = ((z * height + y) * width + x) * channels + c;
-                int sliceIndex = (z * height + y) * channels + c;
+                size_t volIndex = ((static_cast<size_t>(z) * height + y) * width + x) * channels + c;
+                size_t sliceIndex = (static_cast<size_t>(z) * height + y) * channels + c;
                 sliceData[sliceIndex] = data[volIndex];
             }
         }
@@ -227,8 +514,7 @@ void Volume::setVoxel(int x, int y, int z, int channel, unsigned char value) {
         throw std::out_of_range("Voxel coordinates or channel out of range.");
     }
 
-    int index = ((z * height + y) * width + x) * channels + channel;
-    data[index] = value;
+    view()(x, y, z, channel) = value;
 }
 
 unsigned char Volume::getVoxel(int x, int y, int z, int channel) const {
@@ -236,8 +522,7 @@ unsigned char Volume::getVoxel(int x, int y, int z, int channel) const {
         throw std::out_of_range("Voxel coordinates or channel out of range.");
     }
 
-    int index = ((z * height + y) * width + x) * channels + channel;
-    return data[index];
+    return view()(x, y, z, channel);
 }
 
 
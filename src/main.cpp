@@ -14,10 +14,13 @@ Members:
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <utility>
 #include "Image.h"
 #include "Volume.h"
 #include "Filter.h"
 #include "Projection.h"
+#include "Pipeline.h"
+#include "Parallel.h"
 
 // Forward declarations for all menu display and processing functions
 void displayMainMenu();
@@ -38,11 +41,20 @@ void processEdgeDetection(std::shared_ptr<Image>& imgPtr);
 void process3DFilters(std::shared_ptr<Volume>& volumePtr);
 void processProjections(std::shared_ptr<Volume>& volumePtr);
 
+// Forward declarations for the non-interactive batch mode
+int runBatchCommand(int argc, char* argv[]);
+void printBatchUsage();
+
 namespace fs = std::filesystem;
 
 
 //Part 1: Main and Menu Display Functions
-int main() {
+int main(int argc, char* argv[]) {
+    // Any command-line arguments select the non-interactive batch mode instead of the menus
+    if (argc > 1) {
+        return runBatchCommand(argc, argv);
+    }
+
     // imgPtr is a smart pointer to Image
     std::shared_ptr<Image> imgPtr;
     // volumePtr is a smart pointer to Volume
@@ -86,10 +98,22 @@ int main() {
                 imgPtr.reset();
                 volumePtr.reset();
                 std::vector<std::string> filenames;
-                std::cout << "Enter directory path for 3D volume: ";
+                std::cout << "Enter directory path (or " << Volume::rawExtension << " file) for 3D volume: ";
                 std::cin >> inputPath;
                 std::cin.clear();
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                // Raw volume files are mapped directly instead of decoding slices
+                if (fs::is_regular_file(inputPath)) {
+                    try {
+                        volumePtr = std::make_shared<Volume>(Volume::openRaw(inputPath));
+                        std::cout << "Volume opened successfully.\n";
+                    } catch (const std::exception& e) {
+                        std::cout << "Failed to open volume: " << e.what() << std::endl;
+                        break;
+                    }
+                    process3DVolumeProcessing(volumePtr);
+                    break;
+                }
                 try {
                     for (const auto& entry : fs::directory_iterator(inputPath)) {
                         if (entry.path().extension() == ".png") {
@@ -136,6 +160,113 @@ void displayMainMenu() {
     std::cout << "Enter choice: ";
 }
 
+void printBatchUsage() {
+    std::cout << "Usage: advanced_programming_group_ziggurat run --in <image|directory> --out <directory>\n"
+              << "           --pipeline \"<step>,<step>,...\" [--jobs <threads>]\n"
+              << "       advanced_programming_group_ziggurat convert --in <slice directory> --out <volume"
+              << Volume::rawExtension << "> [--jobs <threads>]\n"
+              << "Steps: grayscale, brightness:<value|auto>, gamma:<g>, equalize[:hsv|hsl],\n"
+              << "       clahe[:<clip>[:<tiles>]], threshold:<value>[:hsv|hsl], saltpepper:<proportion>,\n"
+              << "       median:<k>, box:<k>, gaussian:<k>:<sigma>, sobel, prewitt, scharr, roberts,\n"
+              << "       canny:<low>:<high>\n"
+              << "Consecutive grayscale, brightness, gamma and threshold steps run as one fused pass.\n"
+              << "Example: run --in slices/ --out out/ --pipeline \"grayscale,gaussian:5:1.2,sobel\"\n";
+}
+
+// Part 1b: Non-interactive batch mode
+int runBatchCommand(int argc, char* argv[]) {
+    std::string command = argv[1];
+    if (command == "--help" || command == "-h" || command == "help") {
+        printBatchUsage();
+        return 0;
+    }
+    if (command != "run" && command != "convert") {
+        std::cerr << "Unknown command '" << command << "'.\n";
+        printBatchUsage();
+        return 2;
+    }
+
+    std::string inputPath, outputPath, specification;
+    int jobs = 0;
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for option '" << option << "'.\n";
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (option == "--in") {
+            inputPath = value;
+        } else if (option == "--out") {
+            outputPath = value;
+        } else if (option == "--pipeline") {
+            specification = value;
+        } else if (option == "--jobs") {
+            try {
+                jobs = std::stoi(value);
+            } catch (const std::exception&) {
+                jobs = -1;
+            }
+            if (jobs < 1) {
+                std::cerr << "--jobs must be a positive integer.\n";
+                return 2;
+            }
+        } else {
+            std::cerr << "Unknown option '" << option << "'.\n";
+            printBatchUsage();
+            return 2;
+        }
+    }
+    if (inputPath.empty() || outputPath.empty() || (command == "run" && specification.empty())) {
+        std::cerr << "--in and --out are required, and run also needs --pipeline.\n";
+        printBatchUsage();
+        return 2;
+    }
+
+    // Convert a slice folder to a raw volume file that later runs can map instantly
+    if (command == "convert") {
+        if (jobs > 0) {
+            Parallel::setThreadCount(jobs);
+        }
+        try {
+            Volume::convertSlicesToRaw(inputPath, outputPath);
+        } catch (const std::exception& e) {
+            std::cerr << "Conversion failed: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << outputPath << std::endl;
+        return 0;
+    }
+
+    // Parse the chain and list the inputs once, before any work starts
+    Pipeline pipeline;
+    std::vector<std::string> inputs;
+    try {
+        pipeline = Pipeline::parse(specification);
+        inputs = Pipeline::collectInputs(inputPath);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+    if (jobs > 0) {
+        Parallel::setThreadCount(jobs);
+    }
+
+    Pipeline::BatchResult result;
+    try {
+        result = pipeline.runBatch(inputs, outputPath);
+    } catch (const std::exception& e) {
+        std::cerr << "Batch failed: " << e.what() << std::endl;
+        return 1;
+    }
+    for (const auto& failure : result.failures) {
+        std::cerr << "Failed: " << failure.first << ": " << failure.second << std::endl;
+    }
+    std::cout << "Processed " << result.processed << " of " << inputs.size() << " images into " << outputPath
+              << " using " << Parallel::getThreadCount() << " threads." << std::endl;
+    return result.failures.empty() ? 0 : 1;
+}
+
 // Part 2: 2D Image Processing Functions
 void display2DProcessingMenu() {
     std::cout << "\n2D Image Processing Options:\n";
@@ -289,7 +420,7 @@ void processColorCorrection(std::shared_ptr<Image>& imgPtr) {
                 std::cout << "Invalid noise ratio. Please try again.\n";
                 return;
             }
-            *imgPtr = Filter::salt_and_pepper(*imgPtr, noiseRatio, true); // Implement Salt and Pepper Noise.
+            *imgPtr = Filter::salt_and_pepper(std::move(*imgPtr), noiseRatio, true); // Implement Salt and Pepper Noise.
             break;
         }
         default:
@@ -322,13 +453,13 @@ void processImageBlur(std::shared_ptr<Image>& imgPtr) {
     std::string outputPath;
 
     // Validate user choice before proceeding
-    if (choice < 1 || choice > 4) {
+    if (choice < 1 || choice > 5) {
         std::cout << "Invalid choice. Please try again.\n";
         return; // Exit the function if the choice is not valid
     }
 
     // If the choice is to return to the previous menu, just return from the function
-    if (choice == 4) {
+    if (choice == 5) {
         return;
     }
 
@@ -343,9 +474,10 @@ void processImageBlur(std::shared_ptr<Image>& imgPtr) {
         std::cout << "Kernel size must be an odd number. Please try again.\n";
         return; // Exit if the kernel size is not odd
     }
-    // Ensure the kernel size is within the valid range
-    if (kernelSize < 3 || kernelSize > 15) {
-        std::cout << "Kernel size must be between 3 and 15. Please try again.\n";
+    // Ensure the kernel size is within the valid range; the constant-time median also handles large kernels
+    int maxKernelSize = (choice == 4) ? 255 : 15;
+    if (kernelSize < 3 || kernelSize > maxKernelSize) {
+        std::cout << "Kernel size must be between 3 and " << maxKernelSize << ". Please try again.\n";
         return;
     }
 
@@ -370,6 +502,9 @@ void processImageBlur(std::shared_ptr<Image>& imgPtr) {
             }
             *imgPtr = Filter::gaussianBlur(*imgPtr, kernelSize, sigma);
             break;
+        case 4: // Constant-time Median Blur
+            *imgPtr = Filter::constantTimeMedianBlur(*imgPtr, kernelSize);
+            break;
         default:
             std::cout << "Unexpected error occurred.\n";
             return;
@@ -489,7 +624,8 @@ void displayImageBlurMenu() {
     std::cout << "1. Apply Median Blur\n";
     std::cout << "2. Apply Box Blur\n";
     std::cout << "3. Apply Gaussian Blur\n";
-    std::cout << "4. Return to Previous Menu\n";
+    std::cout << "4. Apply Constant-Time Median Blur (large kernels)\n";
+    std::cout << "5. Return to Previous Menu\n";
     std::cout << "Enter choice: ";
 }
 
@@ -652,6 +788,10 @@ void process3DFilters(std::shared_ptr<Volume>& volumePtr) {
                 std::cout << "Kernel size must be between 3 and 15. Please try again.\n";
                 return;
             }
+            if (kernelSize % 2 == 0) {
+                std::cout << "Kernel size must be an odd number. Please try again.\n";
+                return;
+            }
             std::cout << "Enter sigma for the Gaussian filter: ";
             std::cin >> sigma;
             std::cin.clear();
@@ -715,9 +855,13 @@ void process3DFilters(std::shared_ptr<Volume>& volumePtr) {
                 std::cout << "Kernel size must be between 3 and 15. Please try again.\n";
                 return;
             }
+            if (kernelSize % 2 == 0) {
+                std::cout << "Kernel size must be an odd number. Please try again.\n";
+                return;
+            }
 
+            // Picks the sorting or sliding-histogram engine from the kernel size
             Filter::apply3DMedianFilter(*volumePtr, kernelSize);
-//            Filter::apply3DMedianHistFilter(*volumePtr, kernelSize); // faster version
 
             std::cout << "Do you want to save the filtered volume? (y/n): ";
             char saveChoice;
@@ -0,0 +1,135 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "BrickedVolumeTests.h"
+#include "ProjectionTests.h"
+#include "TestHelpers.h"
+#include "BrickedVolume.h"
+#include "Filter.h"
+#include "Projection.h"
+
+namespace {
+
+bool sameVoxels(const Volume& a, const Volume& b) {
+    size_t size = static_cast<size_t>(a.getWidth()) * a.getHeight() * a.getDepth() * a.getChannels();
+    return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() && a.getDepth() == b.getDepth()
+           && a.getChannels() == b.getChannels() && std::memcmp(a.getVolumeData(), b.getVolumeData(), size) == 0;
+}
+
+// Small bricks and a cache of four bricks, so every test spills to disk
+constexpr int testBrickSide = 8;
+constexpr size_t testCacheBytes = 4 * testBrickSide * testBrickSide * testBrickSide * 2;
+
+} // namespace
+
+void BrickedVolumeTests::testRegionRoundTrip() {
+    std::cout << "Testing BrickedVolume region round trip..." << std::endl;
+
+    Volume volume = randomVolume(37, 29, 21, 2);
+    BrickedVolume bricked = BrickedVolume::fromVolume(volume, testCacheBytes, testBrickSide);
+    assert(sameVoxels(bricked.toVolume(), volume));
+
+    BrickedVolume::CacheStatistics statistics = bricked.getCacheStatistics();
+    assert(statistics.evictions > 0);
+    assert(statistics.spills > 0);
+    assert(statistics.residentBricks == 4);
+
+    // An unaligned region that crosses brick borders in every direction
+    std::vector<unsigned char> region(11 * 10 * 9 * 2);
+    bricked.readRegion(5, 6, 7, 11, 10, 9, region.data());
+    int mismatched = 0;
+    for (int z = 0; z < 9; ++z) {
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 11; ++x) {
+                for (int c = 0; c < 2; ++c) {
+                    size_t dense = (((z + 7) * 29 + (y + 6)) * 37 + (x + 5)) * 2 + c;
+                    mismatched += region[((z * 10 + y) * 11 + x) * 2 + c] != volume.getVolumeData()[dense];
+                }
+            }
+        }
+    }
+    assert(mismatched == 0);
+
+    // Writes land in the right voxels and survive eviction
+    std::fill(region.begin(), region.end(), 7);
+    bricked.writeRegion(5, 6, 7, 11, 10, 9, region.data());
+    Image slice = bricked.getSlice(10);
+    assert(slice.getData()[(7 * 37 + 6) * 2] == 7);
+    assert(slice.getData()[0] == volume.getVolumeData()[static_cast<size_t>(10) * 29 * 37 * 2]);
+
+    bool threw = false;
+    try {
+        bricked.readRegion(30, 0, 0, 8, 1, 1, region.data());
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "BrickedVolume region round trip test passed." << std::endl;
+}
+
+void BrickedVolumeTests::testStreamingFilters() {
+    std::cout << "Testing streaming 3D filters on a bricked volume..." << std::endl;
+
+    Volume volume = randomVolume(29, 23, 19, 2);
+
+    // Each filter streamed over bricks must give the dense result voxel for voxel
+    int differing = 0;
+    Volume expected = volume;
+    Filter::apply3DGaussianBlur(expected, 5, 1.5f);
+    BrickedVolume bricked = BrickedVolume::fromVolume(volume, testCacheBytes, testBrickSide);
+    Filter::apply3DGaussianBlur(bricked, 5, 1.5f);
+    differing += !sameVoxels(bricked.toVolume(), expected);
+
+    expected = Volume(volume);
+    Filter::apply3DMedianFilter(expected, 3);
+    bricked = BrickedVolume::fromVolume(volume, testCacheBytes, testBrickSide);
+    Filter::apply3DMedianFilter(bricked, 3);
+    differing += !sameVoxels(bricked.toVolume(), expected);
+
+    expected = Volume(volume);
+    Filter::apply3DMedianHistFilter(expected, 5);
+    bricked = BrickedVolume::fromVolume(volume, testCacheBytes, testBrickSide);
+    Filter::apply3DMedianHistFilter(bricked, 5);
+    differing += !sameVoxels(bricked.toVolume(), expected);
+    assert(differing == 0);
+
+    std::cout << "Streaming 3D filters test passed." << std::endl;
+}
+
+void BrickedVolumeTests::testStreamingProjections() {
+    std::cout << "Testing streaming projections on a bricked volume..." << std::endl;
+
+    Volume volume = randomVolume(27, 20, 18, 1);
+    BrickedVolume bricked = BrickedVolume::fromVolume(volume, testCacheBytes, testBrickSide);
+
+    unsigned int all = Projection::Maximum | Projection::Minimum | Projection::Average | Projection::Median
+                       | Projection::StandardDeviation;
+    Projection::Result expected = Projection::computeProjections(volume, all, 3, 15);
+    Projection::Result streamed = Projection::computeProjections(bricked, all, 3, 15);
+    assert(ProjectionTests::compareImages(streamed.maximum, expected.maximum, 0));
+    assert(ProjectionTests::compareImages(streamed.minimum, expected.minimum, 0));
+    assert(ProjectionTests::compareImages(streamed.average, expected.average, 0));
+    assert(ProjectionTests::compareImages(streamed.median, expected.median, 0));
+    assert(ProjectionTests::compareImages(streamed.standardDeviation, expected.standardDeviation, 0));
+
+    assert(ProjectionTests::compareImages(Projection::maximumIntensityProjection(bricked),
+                                          Projection::maximumIntensityProjection(volume), 0));
+
+    // Streaming reads bricks back through the cache but never writes them, so the voxels are untouched
+    assert(sameVoxels(bricked.toVolume(), volume));
+
+    std::cout << "Streaming projections test passed." << std::endl;
+}
@@ -0,0 +1,306 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "ClaheTests.h"
+#include "ProjectionTests.h"
+#include "TestHelpers.h"
+#include "Clahe.h"
+#include "Filter.h"
+#include "Histogram.h"
+#include "Parallel.h"
+
+namespace {
+
+// Tile t of `tiles` covers [t * size / tiles, (t + 1) * size / tiles)
+int referenceTileStart(int t, int size, int tiles) {
+    return static_cast<int>(static_cast<long long>(t) * size / tiles);
+}
+
+// Tile below position i and the weight of the tile above it, with clamping beyond the outermost tile centres
+void referenceBlend(int i, int size, int tiles, int& tile, double& weight) {
+    double centre = (i + 0.5) * tiles / size - 0.5;
+    tile = static_cast<int>(std::floor(centre));
+    weight = centre - tile;
+    if (tile < 0) {
+        tile = 0;
+        weight = 0.0;
+    } else if (tile >= tiles - 1) {
+        tile = tiles - 1;
+        weight = 0.0;
+    }
+}
+
+// Straightforward CLAHE of one channel of an image, interpolated in floating point
+Image referenceClahe(const Image& image, int channel, double clipLimit, int tilesX, int tilesY) {
+    int width = image.getWidth(), height = image.getHeight();
+    tilesX = std::min(tilesX, width);
+    tilesY = std::min(tilesY, height);
+    std::vector<Histogram::Table> tables;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            Histogram::Counts counts{};
+            for (int y = referenceTileStart(ty, height, tilesY); y < referenceTileStart(ty + 1, height, tilesY); ++y) {
+                for (int x = referenceTileStart(tx, width, tilesX); x < referenceTileStart(tx + 1, width, tilesX); ++x) {
+                    counts[image.getPixel(x, y, channel)]++;
+                }
+            }
+            tables.push_back(Histogram::clippedEqualisationTable(counts, clipLimit));
+        }
+    }
+
+    Image result = image;
+    for (int y = 0; y < height; ++y) {
+        int ty;
+        double wy;
+        referenceBlend(y, height, tilesY, ty, wy);
+        int ty1 = std::min(ty + 1, tilesY - 1);
+        for (int x = 0; x < width; ++x) {
+            int tx;
+            double wx;
+            referenceBlend(x, width, tilesX, tx, wx);
+            int tx1 = std::min(tx + 1, tilesX - 1);
+            unsigned char v = image.getPixel(x, y, channel);
+            double top = (1 - wx) * tables[ty * tilesX + tx][v] + wx * tables[ty * tilesX + tx1][v];
+            double bottom = (1 - wx) * tables[ty1 * tilesX + tx][v] + wx * tables[ty1 * tilesX + tx1][v];
+            result.setPixel(x, y, channel, static_cast<unsigned char>(std::lround((1 - wy) * top + wy * bottom)));
+        }
+    }
+    return result;
+}
+
+// Image with a smooth left-to-right ramp, a dark lower half and noise, so neighbouring tiles differ
+Image unevenImage(int width, int height, int channels) {
+    Image image = ProjectionTests::generateRandomImage(width, height, channels);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                int base = 200 * x / width + (y < height / 2 ? 40 : 0);
+                image.setPixel(x, y, c, static_cast<unsigned char>(std::min(255, base + image.getPixel(x, y, c) / 16)));
+            }
+        }
+    }
+    return image;
+}
+
+Volume unevenVolume(int width, int height, int depth, int channels) {
+    Volume volume(width, height, depth, channels);
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> noise(0, 15);
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    int base = 150 * x / width + 60 * z / depth + (c == 0 ? 20 : 0) + noise(generator);
+                    volume.setVoxel(x, y, z, c, static_cast<unsigned char>(std::min(255, base)));
+                }
+            }
+        }
+    }
+    return volume;
+}
+
+} // namespace
+
+void ClaheTests::testClippedTable() {
+    std::cout << "Testing clipped equalisation table..." << std::endl;
+
+    // With a limit no bin reaches, the table is the rounded cumulative distribution
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> distribution(0, 40);
+    Histogram::Counts counts{};
+    size_t total = 0;
+    for (size_t& count : counts) {
+        count = distribution(generator);
+        total += count;
+    }
+    Histogram::Table table = Histogram::clippedEqualisationTable(counts, 1000.0);
+    size_t cdf = 0;
+    for (int v = 0; v < 256; ++v) {
+        cdf += counts[v];
+        assert(table[v] == static_cast<unsigned char>(std::lround(255.0 * cdf / total)));
+    }
+
+    // A single spike clipped to the mean bin count is spread almost evenly, giving close to the identity
+    Histogram::Counts spike{};
+    spike[128] = 2560;
+    table = Histogram::clippedEqualisationTable(spike, 1.0);
+    for (int v = 0; v < 256; ++v) {
+        assert(std::abs(table[v] - v) <= 2);
+        assert(v == 0 || table[v] >= table[v - 1]);
+    }
+    assert(table[255] == 255);
+
+    // A moderate limit bounds how steep the mapping can be around the spike
+    table = Histogram::clippedEqualisationTable(spike, 4.0);
+    for (int v = 1; v < 256; ++v) {
+        assert(table[v] >= table[v - 1] && table[v] - table[v - 1] <= 5);
+    }
+
+    // An empty histogram maps to 0; a clip limit must be positive
+    table = Histogram::clippedEqualisationTable(Histogram::Counts{}, 2.0);
+    assert(std::all_of(table.begin(), table.end(), [](unsigned char v) { return v == 0; }));
+    assert(throwsInvalidArgument([&] { Histogram::clippedEqualisationTable(spike, 0.0); }));
+
+    std::cout << "Clipped equalisation table test passed." << std::endl;
+}
+
+void ClaheTests::testImageMatchesReference() {
+    std::cout << "Testing CLAHE of images..." << std::endl;
+
+    int previousThreads = Parallel::getThreadCount();
+    struct Grid {
+        int tilesX, tilesY;
+    };
+    // Count comparisons outside the tolerance so every case runs before the single assert
+    int mismatched = 0;
+    for (int threads : {1, 4}) {
+        Parallel::setThreadCount(threads);
+        for (Grid grid : {Grid{8, 8}, Grid{3, 5}, Grid{1, 1}, Grid{100, 2}}) {
+            for (double clipLimit : {1.5, 4.0}) {
+                // Grey: the fixed-point remap stays within one level of the floating-point reference
+                Image grey = unevenImage(61, 47, 1);
+                Image expected = referenceClahe(grey, 0, clipLimit, grid.tilesX, grid.tilesY);
+                Image result = Filter::adaptiveHistogramEqualization(grey, clipLimit, grid.tilesX, grid.tilesY);
+                mismatched += !ProjectionTests::compareImages(result, expected, 1);
+                Filter::adaptiveHistogramEqualization(grey, grey, clipLimit, grid.tilesX, grid.tilesY);
+                mismatched += !ProjectionTests::compareImages(grey, result, 0);
+
+                // Colour: the fused rows equal equalising V or L of the converted image and converting back
+                for (int channels : {3, 4}) {
+                    Image colour = unevenImage(61, 47, channels);
+                    for (bool isHSV : {true, false}) {
+                        Image converted = isHSV ? Filter::rgb_to_hsv(colour) : Filter::RGBtoHSL(colour);
+                        Image brightness(61, 47, 1);
+                        for (int y = 0; y < 47; ++y) {
+                            for (int x = 0; x < 61; ++x) {
+                                brightness.setPixel(x, y, 0, converted.getPixel(x, y, 2));
+                            }
+                        }
+                        Image equalised = Filter::adaptiveHistogramEqualization(brightness, clipLimit, grid.tilesX,
+                                                                                grid.tilesY);
+                        Image remapped = converted;
+                        for (int y = 0; y < 47; ++y) {
+                            for (int x = 0; x < 61; ++x) {
+                                remapped.setPixel(x, y, 2, equalised.getPixel(x, y, 0));
+                            }
+                        }
+                        Image expectedColour = isHSV ? Filter::hsv_to_rgb(remapped) : Filter::HSLtoRGB(remapped);
+                        Image fused = Filter::adaptiveHistogramEqualization(colour, clipLimit, grid.tilesX,
+                                                                            grid.tilesY, isHSV);
+                        assert(fused.getChannels() == 3);
+                        mismatched += !ProjectionTests::compareImages(fused, expectedColour, 0);
+                    }
+                }
+            }
+        }
+    }
+    Parallel::setThreadCount(previousThreads);
+    assert(mismatched == 0);
+
+    // A uniform image split into equal tiles stays uniform
+    Image flat(32, 32, 1);
+    std::fill(flat.getData(), flat.getData() + 1024, static_cast<unsigned char>(90));
+    Image flatResult = Filter::adaptiveHistogramEqualization(flat);
+    assert(std::all_of(flatResult.getData(), flatResult.getData() + 1024,
+                       [&](unsigned char v) { return v == flatResult.getData()[0]; }));
+
+    Image twoChannels(4, 4, 2);
+    assert(throwsInvalidArgument([&] { Filter::adaptiveHistogramEqualization(twoChannels); }));
+    assert(throwsInvalidArgument([&] { Filter::adaptiveHistogramEqualization(flat, 2.0, 0, 8); }));
+    assert(throwsInvalidArgument([&] { Filter::adaptiveHistogramEqualization(flat, -1.0); }));
+
+    std::cout << "CLAHE image test passed." << std::endl;
+}
+
+void ClaheTests::testVolumeMatchesReference() {
+    std::cout << "Testing CLAHE of volumes..." << std::endl;
+
+    int width = 29, height = 23, depth = 17, channels = 2;
+    int tilesX = 4, tilesY = 3, tilesZ = 3;
+    double clipLimit = 2.5;
+    Volume volume = unevenVolume(width, height, depth, channels);
+
+    // Reference: per-brick tables for each channel, trilinear interpolation in floating point
+    Volume expected = volume;
+    for (int c = 0; c < channels; ++c) {
+        std::vector<Histogram::Table> tables;
+        for (int tz = 0; tz < tilesZ; ++tz) {
+            for (int ty = 0; ty < tilesY; ++ty) {
+                for (int tx = 0; tx < tilesX; ++tx) {
+                    Histogram::Counts counts{};
+                    for (int z = referenceTileStart(tz, depth, tilesZ); z < referenceTileStart(tz + 1, depth, tilesZ); ++z) {
+                        for (int y = referenceTileStart(ty, height, tilesY); y < referenceTileStart(ty + 1, height, tilesY); ++y) {
+                            for (int x = referenceTileStart(tx, width, tilesX); x < referenceTileStart(tx + 1, width, tilesX); ++x) {
+                                counts[volume.getVoxel(x, y, z, c)]++;
+                            }
+                        }
+                    }
+                    tables.push_back(Histogram::clippedEqualisationTable(counts, clipLimit));
+                }
+            }
+        }
+        for (int z = 0; z < depth; ++z) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    int t[3];
+                    double w[3];
+                    referenceBlend(x, width, tilesX, t[0], w[0]);
+                    referenceBlend(y, height, tilesY, t[1], w[1]);
+                    referenceBlend(z, depth, tilesZ, t[2], w[2]);
+                    unsigned char v = volume.getVoxel(x, y, z, c);
+                    double sum = 0.0;
+                    for (int corner = 0; corner < 8; ++corner) {
+                        int bx = std::min(t[0] + (corner & 1), tilesX - 1);
+                        int by = std::min(t[1] + ((corner >> 1) & 1), tilesY - 1);
+                        int bz = std::min(t[2] + ((corner >> 2) & 1), tilesZ - 1);
+                        double weight = ((corner & 1) ? w[0] : 1 - w[0]) * (((corner >> 1) & 1) ? w[1] : 1 - w[1])
+                                        * (((corner >> 2) & 1) ? w[2] : 1 - w[2]);
+                        sum += weight * tables[(bz * tilesY + by) * tilesX + bx][v];
+                    }
+                    expected.setVoxel(x, y, z, c, static_cast<unsigned char>(std::lround(sum)));
+                }
+            }
+        }
+    }
+
+    int previousThreads = Parallel::getThreadCount();
+    for (int threads : {1, 3}) {
+        Parallel::setThreadCount(threads);
+        Volume result = volume;
+        Filter::apply3DAdaptiveHistogramEqualization(result, clipLimit, tilesX, tilesY, tilesZ);
+        size_t size = static_cast<size_t>(width) * height * depth * channels;
+        for (size_t i = 0; i < size; ++i) {
+            assert(std::abs(result.getVolumeData()[i] - expected.getVolumeData()[i]) <= 1);
+        }
+    }
+    Parallel::setThreadCount(previousThreads);
+
+    // A single-slice, single-channel volume gives exactly the 2D result
+    Image grey = unevenImage(31, 19, 1);
+    Volume slab(31, 19, 1, 1);
+    std::memcpy(slab.getVolumeData(), grey.getData(), 31 * 19);
+    Filter::apply3DAdaptiveHistogramEqualization(slab, 3.0, 5, 4, 8);
+    Image flat = Filter::adaptiveHistogramEqualization(grey, 3.0, 5, 4);
+    assert(std::memcmp(slab.getVolumeData(), flat.getData(), 31 * 19) == 0);
+
+    assert(throwsInvalidArgument([&] { Filter::apply3DAdaptiveHistogramEqualization(slab, 2.0, 8, 8, 0); }));
+    assert(throwsInvalidArgument([&] { Filter::apply3DAdaptiveHistogramEqualization(slab, 0.0); }));
+
+    std::cout << "CLAHE volume test passed." << std::endl;
+}
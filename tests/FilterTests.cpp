@@ -11,6 +11,8 @@ Members:
 */
 
 #include <set>
+#include <algorithm>
+#include <cmath>
 #include "FilterTests.h"
 #include "ProjectionTests.h"
 
@@ -51,6 +53,43 @@ void FilterTests::testMedianBlur() {
     std::cout << "MedianBlur test passed." << std::endl;
 }
 
+void FilterTests::testConstantTimeMedianBlur() {
+    std::cout << "Testing ConstantTimeMedianBlur..." << std::endl;
+
+    Image testImage = ProjectionTests::generateRandomImage(43, 27, 3);
+
+    // Must agree exactly with the sorting median, including clamped borders and even kernel sizes
+    for (int kernel_size : {1, 3, 4, 7, 15, 31}) {
+        Image expected = Filter::medianBlur(testImage, kernel_size);
+        Image result = Filter::constantTimeMedianBlur(testImage, kernel_size);
+        assert(ProjectionTests::compareImages(expected, result, 0));
+    }
+
+    // A single bright pixel is removed entirely
+    Image spikeImage(9, 9, 1);
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) {
+            spikeImage.setPixel(x, y, 0, 10);
+        }
+    }
+    spikeImage.setPixel(4, 4, 0, 255);
+    Image spikeResult = Filter::constantTimeMedianBlur(spikeImage, 3);
+    assert(spikeResult.getPixel(4, 4, 0) == 10);
+
+    // The largest kernel the 16-bit column histograms can count is still exact; larger ones are refused
+    Image small = ProjectionTests::generateRandomImage(6, 5, 1);
+    assert(ProjectionTests::compareImages(Filter::constantTimeMedianBlur(small, 255), Filter::medianBlur(small, 255), 0));
+    bool thrown = false;
+    try {
+        Filter::constantTimeMedianBlur(small, 256);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "ConstantTimeMedianBlur test passed." << std::endl;
+}
+
 void FilterTests::testBoxBlur() {
     std::cout << "Testing BoxBlur..." << std::endl;
 
@@ -96,6 +135,52 @@ void FilterTests::testBoxBlur() {
     std::cout << "BoxBlur test passed." << std::endl;
 }
 
+void FilterTests::testBoxBlurRunningSum() {
+    std::cout << "Testing BoxBlurRunningSum..." << std::endl;
+
+    int width = 37, height = 23, channels = 3;
+    Image testImage = ProjectionTests::generateRandomImage(width, height, channels);
+
+    // Odd, even, and kernels larger than the image
+    for (int kernel_size : {3, 4, 7, 12, 31, 101}) {
+        Image resultImage = Filter::boxBlurRunningSum(testImage, kernel_size);
+
+        // Reference: two direct passes with clamped edges
+        int radius = kernel_size / 2;
+        int extra = kernel_size % 2 == 0 ? 1 : 0;
+        Image tempImage(width, height, channels);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int k = 0; k < channels; ++k) {
+                    unsigned int sum = 0, count = 0;
+                    for (int ix = -radius; ix <= radius + extra; ++ix) {
+                        sum += testImage.getPixel(std::clamp(x + ix, 0, width - 1), y, k);
+                        count++;
+                    }
+                    tempImage.setPixel(x, y, k, sum / count);
+                }
+            }
+        }
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int k = 0; k < channels; ++k) {
+                    unsigned int sum = 0, count = 0;
+                    for (int iy = -radius; iy <= radius + extra; ++iy) {
+                        sum += tempImage.getPixel(x, std::clamp(y + iy, 0, height - 1), k);
+                        count++;
+                    }
+                    assert(resultImage.getPixel(x, y, k) == sum / count);
+                }
+            }
+        }
+
+        // boxBlur must give the same answer whichever path it takes
+        assert(ProjectionTests::compareImages(resultImage, Filter::boxBlur(testImage, kernel_size), 0));
+    }
+
+    std::cout << "BoxBlurRunningSum test passed." << std::endl;
+}
+
 void FilterTests::testGaussianBlur() {
     std::cout << "Testing GaussianBlur..." << std::endl;
 
@@ -140,6 +225,130 @@ void FilterTests::testGaussianBlur() {
     std::cout << "GaussianBlur test passed." << std::endl;
 }
 
+void FilterTests::testGaussianKernel1D() {
+    std::cout << "Testing GaussianKernel1D..." << std::endl;
+
+    const std::vector<float>& kernel = Filter::gaussianKernel1D(7, 1.5f);
+    assert(kernel.size() == 7);
+
+    // Normalised, symmetric and peaked at the centre
+    float sum = 0.0f;
+    for (float value : kernel) {
+        sum += value;
+    }
+    assert(std::abs(sum - 1.0f) < 1e-5f);
+    for (int i = 0; i < 3; ++i) {
+        assert(kernel[i] == kernel[6 - i]);
+        assert(kernel[i] < kernel[i + 1]);
+    }
+
+    // A second request is served from the cache
+    assert(&Filter::gaussianKernel1D(7, 1.5f) == &kernel);
+    assert(&Filter::gaussianKernel1D(7, 2.0f) != &kernel);
+
+    std::cout << "GaussianKernel1D test passed." << std::endl;
+}
+
+void FilterTests::testSeparableGaussianBlur() {
+    std::cout << "Testing separable GaussianBlur..." << std::endl;
+
+    int width = 41, height = 29, channels = 3;
+    Image testImage = ProjectionTests::generateRandomImage(width, height, channels);
+
+    for (int kernelSize : {3, 7, 15}) {
+        float sigma = kernelSize / 4.0f;
+        Image resultImage = Filter::gaussianBlur(testImage, kernelSize, sigma);
+
+        // Reference: direct convolution with the full 2D kernel
+        int radius = kernelSize / 2;
+        std::vector<double> kernel(kernelSize * kernelSize);
+        double kernelSum = 0.0;
+        for (int i = 0; i < kernelSize; ++i) {
+            for (int j = 0; j < kernelSize; ++j) {
+                int x = i - radius, y = j - radius;
+                kernel[i * kernelSize + j] = std::exp(-(x * x + y * y) / (2.0 * sigma * sigma));
+                kernelSum += kernel[i * kernelSize + j];
+            }
+        }
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    double expected = 0.0;
+                    for (int ky = -radius; ky <= radius; ++ky) {
+                        for (int kx = -radius; kx <= radius; ++kx) {
+                            int px = std::clamp(x + kx, 0, width - 1);
+                            int py = std::clamp(y + ky, 0, height - 1);
+                            expected += testImage.getPixel(px, py, c) * kernel[(ky + radius) * kernelSize + (kx + radius)] / kernelSum;
+                        }
+                    }
+                    // Allow for float rounding around the truncation point
+                    assert(std::abs(resultImage.getPixel(x, y, c) - static_cast<int>(expected)) <= 1);
+                }
+            }
+        }
+    }
+
+    std::cout << "Separable GaussianBlur test passed." << std::endl;
+}
+
+void FilterTests::testRecursiveGaussianBlur() {
+    std::cout << "Testing recursive GaussianBlur..." << std::endl;
+
+    // A flat image must stay flat, including at the borders
+    Image flatImage(64, 48, 1);
+    for (int y = 0; y < 48; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            flatImage.setPixel(x, y, 0, 200);
+        }
+    }
+    Image flatResult = Filter::gaussianBlurRecursive(flatImage, 12.0f);
+    assert(ProjectionTests::compareImages(flatImage, flatResult, 1));
+
+    // Compare against the exact separable blur on a smooth pattern
+    int width = 160, height = 120;
+    Image testImage(width, height, 3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            testImage.setPixel(x, y, 0, (x * 255) / (width - 1));
+            testImage.setPixel(x, y, 1, (y * 255) / (height - 1));
+            testImage.setPixel(x, y, 2, ((x / 20 + y / 20) % 2) * 255);
+        }
+    }
+    float sigma = 10.0f;
+    Image recursiveResult = Filter::gaussianBlurRecursive(testImage, sigma);
+    Image exactResult = Filter::gaussianBlur(testImage, 61, sigma);
+    assert(ProjectionTests::compareImages(recursiveResult, exactResult, 6));
+
+    // Large sigma with a wide kernel is routed to the recursive filter only on request
+    assert(ProjectionTests::compareImages(Filter::gaussianBlur(testImage, 61, sigma, true), recursiveResult, 0));
+    assert(!ProjectionTests::compareImages(exactResult, recursiveResult, 0));
+    assert(ProjectionTests::compareImages(Filter::gaussianBlur(testImage, 59, sigma, true), exactResult, 6));
+
+    // The documented bound: hard 0/255 checkerboards at the smallest sigma the approximation is used for
+    float smallest = Filter::recursiveGaussianSigmaThreshold;
+    for (int tile : {8, 32, 48}) {
+        Image board(150, 110, 1);
+        for (int y = 0; y < 110; ++y) {
+            for (int x = 0; x < 150; ++x) {
+                board.setPixel(x, y, 0, ((x / tile + y / tile) % 2) * 255);
+            }
+        }
+        assert(ProjectionTests::compareImages(Filter::gaussianBlur(board, 49, smallest, true),
+                                              Filter::gaussianBlur(board, 49, smallest), 9));
+    }
+
+    bool thrown = false;
+    try {
+        Filter::gaussianBlurRecursive(testImage, 0.1f);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Recursive GaussianBlur test passed." << std::endl;
+}
+
 void FilterTests::testGrayScale() {
     std::cout << "Testing GrayScale..." << std::endl;
 
@@ -1012,6 +1221,81 @@ void FilterTests::testApplyRobertsCrossOperator() {
     }
 }
 
+void FilterTests::testOutputOverloads() {
+    std::cout << "Testing filter output overloads..." << std::endl;
+
+    Image rgb = ProjectionTests::generateRandomImage(37, 29, 3);
+    Image gray = Filter::grayScale(rgb);
+
+    // Writing into an output image gives the same result as the returning version, whatever the output held
+    Image output(5, 5, 4);
+    Filter::medianBlur(rgb, output, 3);
+    assert(ProjectionTests::compareImages(output, Filter::medianBlur(rgb, 3), 0));
+    Filter::histomedianBlur(rgb, output, 3);
+    assert(ProjectionTests::compareImages(output, Filter::histomedianBlur(rgb, 3), 0));
+    Filter::constantTimeMedianBlur(rgb, output, 5);
+    assert(ProjectionTests::compareImages(output, Filter::constantTimeMedianBlur(rgb, 5), 0));
+    Filter::boxBlur(rgb, output, 9);
+    assert(ProjectionTests::compareImages(output, Filter::boxBlur(rgb, 9), 0));
+    Filter::gaussianBlur(rgb, output, 5, 1.2f);
+    assert(ProjectionTests::compareImages(output, Filter::gaussianBlur(rgb, 5, 1.2f), 0));
+    Filter::gaussianBlurRecursive(rgb, output, 3.0f);
+    assert(ProjectionTests::compareImages(output, Filter::gaussianBlurRecursive(rgb, 3.0f), 0));
+    Filter::histogramEqualization(rgb, output, false);
+    assert(ProjectionTests::compareImages(output, Filter::histogramEqualization(rgb, false), 0));
+    Filter::applySobelOperator(gray, output);
+    assert(ProjectionTests::compareImages(output, Filter::applySobelOperator(gray), 0));
+    Filter::applyRobertsCrossOperator(gray, output);
+    assert(ProjectionTests::compareImages(output, Filter::applyRobertsCrossOperator(gray), 0));
+
+    // Applying a filter in place matches the out-of-place result
+    Image inPlace = rgb;
+    Filter::gaussianBlur(inPlace, inPlace, 5, 1.2f);
+    assert(ProjectionTests::compareImages(inPlace, Filter::gaussianBlur(rgb, 5, 1.2f), 0));
+    inPlace = rgb;
+    Filter::constantTimeMedianBlur(inPlace, inPlace, 5);
+    assert(ProjectionTests::compareImages(inPlace, Filter::constantTimeMedianBlur(rgb, 5), 0));
+    inPlace = rgb;
+    Filter::threshold(inPlace, inPlace, 100, true, true);
+    assert(ProjectionTests::compareImages(inPlace, Filter::threshold(rgb, 100, true, true), 0));
+    inPlace = rgb;
+    Filter::grayScale(inPlace, inPlace);
+    assert(ProjectionTests::compareImages(inPlace, gray, 0));
+
+    // Point operations rewrite the buffer directly
+    inPlace = rgb;
+    const unsigned char* buffer = inPlace.getData();
+    Filter::setBrightness(inPlace, inPlace, 40);
+    assert(inPlace.getData() == buffer);
+    assert(ProjectionTests::compareImages(inPlace, Filter::setBrightness(rgb, 40), 0));
+    inPlace = gray;
+    buffer = inPlace.getData();
+    Filter::threshold(inPlace, inPlace, 90, false, false);
+    assert(inPlace.getData() == buffer);
+    assert(ProjectionTests::compareImages(inPlace, Filter::threshold(gray, 90, false, false), 0));
+
+    // A chain ping-pongs between two buffers without allocating new frames
+    Image current = rgb;
+    Image scratch(rgb.getWidth(), rgb.getHeight(), rgb.getChannels());
+    const unsigned char* first = current.getData();
+    const unsigned char* second = scratch.getData();
+    Filter::boxBlur(current, scratch, 3);
+    current.swap(scratch);
+    Filter::gaussianBlur(current, scratch, 5, 1.0f);
+    current.swap(scratch);
+    Filter::constantTimeMedianBlur(current, scratch, 3);
+    current.swap(scratch);
+    Filter::setBrightness(current, current, -20);
+    assert((current.getData() == first && scratch.getData() == second)
+           || (current.getData() == second && scratch.getData() == first));
+
+    Image expected = Filter::setBrightness(
+            Filter::constantTimeMedianBlur(Filter::gaussianBlur(Filter::boxBlur(rgb, 3), 5, 1.0f), 3), -20);
+    assert(ProjectionTests::compareImages(current, expected, 0));
+
+    std::cout << "Filter output overloads test passed." << std::endl;
+}
+
 double FilterTests::calculateSliceVariance(const std::shared_ptr<Image>& slice) {
     double sum = 0.0, sumSquared = 0.0;
     int pixels = slice->getWidth() * slice->getHeight();
@@ -1132,6 +1416,61 @@ void FilterTests::testCreate3DKernel(int kernelSize, float sigma) {
     std::cout << "create3DKernel test passed." << std::endl;
 }
 
+void FilterTests::test3DGaussianBlurSeparable() {
+    std::cout << "Testing separable 3D Gaussian Blur..." << std::endl;
+
+    int width = 13, height = 11, depth = 9, channels = 2;
+    Volume testVolume(width, height, depth, channels);
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    testVolume.setVoxel(x, y, z, c, rand() % 256);
+                }
+            }
+        }
+    }
+    Volume blurredVolume(testVolume);
+
+    int kernelSize = 5;
+    float sigma = 1.2f;
+    Filter::apply3DGaussianBlur(blurredVolume, kernelSize, sigma);
+
+    // Reference: direct convolution with the full 3D kernel
+    auto kernel = Filter::create3DKernel(kernelSize, sigma);
+    int r = kernelSize / 2;
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    double expected = 0.0;
+                    for (int kz = -r; kz <= r; ++kz) {
+                        for (int ky = -r; ky <= r; ++ky) {
+                            for (int kx = -r; kx <= r; ++kx) {
+                                unsigned char value = testVolume.getVoxel(std::clamp(x + kx, 0, width - 1),
+                                                                          std::clamp(y + ky, 0, height - 1),
+                                                                          std::clamp(z + kz, 0, depth - 1), c);
+                                expected += value * kernel[kz + r][ky + r][kx + r];
+                            }
+                        }
+                    }
+                    assert(std::abs(blurredVolume.getVoxel(x, y, z, c) - static_cast<int>(expected)) <= 1);
+                }
+            }
+        }
+    }
+
+    bool thrown = false;
+    try {
+        Filter::apply3DGaussianBlur(blurredVolume, 4, sigma);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Separable 3D Gaussian Blur test passed." << std::endl;
+}
+
 void FilterTests::test3DMedianFilter() {
     std::cout << "Testing 3D Median Filter..." << std::endl;
 
@@ -1162,4 +1501,74 @@ void FilterTests::test3DMedianFilter() {
     }
 
     std::cout << "3D Median Filter test passed." << std::endl;
-}
\ No newline at end of file
+}
+
+void FilterTests::test3DMedianEngines() {
+    std::cout << "Testing 3D Median engines..." << std::endl;
+
+    int width = 11, height = 9, depth = 7, channels = 2;
+    Volume testVolume(width, height, depth, channels);
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    testVolume.setVoxel(x, y, z, c, rand() % 256);
+                }
+            }
+        }
+    }
+
+    // Kernel 3 takes the sorting path, 5 and 7 the sliding histogram; all must match a direct median
+    for (int kernelSize : {3, 5, 7}) {
+        Volume autoVolume(testVolume);
+        Volume histVolume(testVolume);
+        Filter::apply3DMedianFilter(autoVolume, kernelSize);
+        Filter::apply3DMedianHistFilter(histVolume, kernelSize);
+
+        int r = kernelSize / 2;
+        std::vector<unsigned char> window;
+        for (int z = 0; z < depth; ++z) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    for (int c = 0; c < channels; ++c) {
+                        window.clear();
+                        for (int kz = -r; kz <= r; ++kz) {
+                            for (int ky = -r; ky <= r; ++ky) {
+                                for (int kx = -r; kx <= r; ++kx) {
+                                    window.push_back(testVolume.getVoxel(std::clamp(x + kx, 0, width - 1),
+                                                                         std::clamp(y + ky, 0, height - 1),
+                                                                         std::clamp(z + kz, 0, depth - 1), c));
+                                }
+                            }
+                        }
+                        std::sort(window.begin(), window.end());
+                        unsigned char expected = window[window.size() / 2];
+                        assert(autoVolume.getVoxel(x, y, z, c) == expected);
+                        assert(histVolume.getVoxel(x, y, z, c) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    // Kernels above 255 would overflow the 16-bit column histograms, so every entry point rejects them
+    for (int kernelSize : {257, 301}) {
+        Volume tooLarge(testVolume);
+        bool thrown = false;
+        try {
+            Filter::apply3DMedianFilter(tooLarge, kernelSize);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try {
+            Filter::apply3DMedianHistFilter(tooLarge, kernelSize);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "3D Median engines test passed." << std::endl;
+}
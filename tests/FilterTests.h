@@ -20,8 +20,13 @@ Members:
 class FilterTests {
 public:
     static void testMedianBlur();
+    static void testConstantTimeMedianBlur();
     static void testBoxBlur();
+    static void testBoxBlurRunningSum();
     static void testGaussianBlur();
+    static void testGaussianKernel1D();
+    static void testSeparableGaussianBlur();
+    static void testRecursiveGaussianBlur();
     static void testGrayScale();
     static void testSetBrightness();
     static void test_setBrightness_manual();
@@ -42,9 +47,12 @@ public:
     static void testApplyPrewittOperator();
     static void testApplyScharrOperator();
     static void testApplyRobertsCrossOperator();
+    static void testOutputOverloads();
     static void test3DGaussianBlur(Volume& volume);
+    static void test3DGaussianBlurSeparable();
     static void testCreate3DKernel(int kernelSize, float sigma);
     static void test3DMedianFilter();
+    static void test3DMedianEngines();
     // Additional method tests can be added here following the same pattern
 private:
     static double calculateSliceVariance(const std::shared_ptr<Slice>& slice);
@@ -0,0 +1,370 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "GradientTests.h"
+#include "ProjectionTests.h"
+#include "Gradient.h"
+#include "Filter.h"
+#include "Parallel.h"
+
+namespace {
+
+// Direct 3x3 convolution of channel 0 with runtime kernels, zero on the border
+void referenceDerivatives(const Image& image, const int kernelX[3][3], const int kernelY[3][3],
+                          std::vector<int>& gx, std::vector<int>& gy) {
+    int width = image.getWidth(), height = image.getHeight();
+    gx.assign(static_cast<size_t>(width) * height, 0);
+    gy.assign(gx.size(), 0);
+    for (int y = 1; y < height - 1; ++y) {
+        for (int x = 1; x < width - 1; ++x) {
+            int sumX = 0, sumY = 0;
+            for (int ky = -1; ky <= 1; ++ky) {
+                for (int kx = -1; kx <= 1; ++kx) {
+                    sumX += image.getPixel(x + kx, y + ky, 0) * kernelX[ky + 1][kx + 1];
+                    sumY += image.getPixel(x + kx, y + ky, 0) * kernelY[ky + 1][kx + 1];
+                }
+            }
+            gx[static_cast<size_t>(y) * width + x] = sumX;
+            gy[static_cast<size_t>(y) * width + x] = sumY;
+        }
+    }
+}
+
+// Roberts Cross anchored at the top-left pixel, zero on the last row and column
+void referenceRoberts(const Image& image, std::vector<int>& gx, std::vector<int>& gy) {
+    int width = image.getWidth(), height = image.getHeight();
+    gx.assign(static_cast<size_t>(width) * height, 0);
+    gy.assign(gx.size(), 0);
+    for (int y = 0; y < height - 1; ++y) {
+        for (int x = 0; x < width - 1; ++x) {
+            gx[static_cast<size_t>(y) * width + x] = image.getPixel(x, y, 0) - image.getPixel(x + 1, y + 1, 0);
+            gy[static_cast<size_t>(y) * width + x] = image.getPixel(x, y + 1, 0) - image.getPixel(x + 1, y, 0);
+        }
+    }
+}
+
+void referenceGradient(const Image& image, Gradient::Operator op, std::vector<int>& gx, std::vector<int>& gy) {
+    static const int sobelX[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    static const int sobelY[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+    static const int prewittX[3][3] = {{-1, 0, 1}, {-1, 0, 1}, {-1, 0, 1}};
+    static const int prewittY[3][3] = {{-1, -1, -1}, {0, 0, 0}, {1, 1, 1}};
+    static const int scharrX[3][3] = {{-3, 0, 3}, {-10, 0, 10}, {-3, 0, 3}};
+    static const int scharrY[3][3] = {{-3, -10, -3}, {0, 0, 0}, {3, 10, 3}};
+    switch (op) {
+        case Gradient::Operator::Sobel:
+            referenceDerivatives(image, sobelX, sobelY, gx, gy);
+            break;
+        case Gradient::Operator::Prewitt:
+            referenceDerivatives(image, prewittX, prewittY, gx, gy);
+            break;
+        case Gradient::Operator::Scharr:
+            referenceDerivatives(image, scharrX, scharrY, gx, gy);
+            break;
+        case Gradient::Operator::Roberts:
+            referenceRoberts(image, gx, gy);
+            break;
+    }
+}
+
+// Whole-image Canny written the textbook way: blur, Sobel, suppression, then a flood fill from strong pixels
+Image referenceCanny(const Image& image, float low, float high, int kernelSize, float sigma, bool luminance) {
+    int width = image.getWidth(), height = image.getHeight(), channels = image.getChannels();
+    int radius = kernelSize / 2;
+    const std::vector<float>& kernel = Filter::gaussianKernel1D(kernelSize, sigma);
+    auto at = [width](int x, int y) { return static_cast<size_t>(y) * width + x; };
+
+    std::vector<float> intensity(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            intensity[at(x, y)] = luminance && channels >= 3
+                    ? 0.2126f * image.getPixel(x, y, 0) + 0.7152f * image.getPixel(x, y, 1) + 0.0722f * image.getPixel(x, y, 2)
+                    : image.getPixel(x, y, 0);
+        }
+    }
+    std::vector<float> horizontal(intensity.size()), smoothed(intensity.size(), 0.0f);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            float sum = 0.0f;
+            for (int k = -radius; k <= radius; ++k) {
+                sum += intensity[at(std::clamp(x + k, 0, width - 1), y)] * kernel[k + radius];
+            }
+            horizontal[at(x, y)] = sum;
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int k = -radius; k <= radius; ++k) {
+            for (int x = 0; x < width; ++x) {
+                smoothed[at(x, y)] += horizontal[at(x, std::clamp(y + k, 0, height - 1))] * kernel[k + radius];
+            }
+        }
+    }
+
+    std::vector<float> magnitude(intensity.size(), 0.0f), gx(intensity.size(), 0.0f), gy(intensity.size(), 0.0f);
+    for (int y = 1; y < height - 1; ++y) {
+        for (int x = 1; x < width - 1; ++x) {
+            auto s = [&](int dx, int dy) { return smoothed[at(x + dx, y + dy)]; };
+            float dx = 1 * (s(1, -1) - s(-1, -1)) + 2 * (s(1, 0) - s(-1, 0)) + 1 * (s(1, 1) - s(-1, 1));
+            float dy = 1 * (s(-1, 1) - s(-1, -1)) + 2 * (s(0, 1) - s(0, -1)) + 1 * (s(1, 1) - s(1, -1));
+            gx[at(x, y)] = dx;
+            gy[at(x, y)] = dy;
+            magnitude[at(x, y)] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    // 0 none, 1 weak, 2 strong
+    std::vector<int> state(intensity.size(), 0);
+    std::queue<std::pair<int, int>> strong;
+    for (int y = 1; y < height - 1; ++y) {
+        for (int x = 1; x < width - 1; ++x) {
+            float m = magnitude[at(x, y)];
+            if (m == 0.0f || m < low) {
+                continue;
+            }
+            float angle = std::atan2(gy[at(x, y)], gx[at(x, y)]) * 180.0f / static_cast<float>(M_PI);
+            float ax = std::fabs(gx[at(x, y)]), ay = std::fabs(gy[at(x, y)]);
+            int dx1, dy1;
+            if (ay <= ax * 0.41421356f) {
+                dx1 = -1; dy1 = 0;
+            } else if (ay >= ax * 2.41421356f) {
+                dx1 = 0; dy1 = -1;
+            } else if ((angle > 0 && angle < 90) || (angle < -90)) {
+                dx1 = -1; dy1 = -1;
+            } else {
+                dx1 = 1; dy1 = -1;
+            }
+            if (m > magnitude[at(x + dx1, y + dy1)] && m >= magnitude[at(x - dx1, y - dy1)]) {
+                state[at(x, y)] = m >= high ? 2 : 1;
+                if (m >= high) {
+                    strong.emplace(x, y);
+                }
+            }
+        }
+    }
+
+    Image edges(width, height, 1);
+    std::fill(edges.getData(), edges.getData() + edges.getSize(), 0);
+    while (!strong.empty()) {
+        auto [x, y] = strong.front();
+        strong.pop();
+        if (edges.getPixel(x, y, 0) == 255) {
+            continue;
+        }
+        edges.setPixel(x, y, 0, 255);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nx = x + dx, ny = y + dy;
+                if (nx >= 0 && ny >= 0 && nx < width && ny < height && state[at(nx, ny)] != 0
+                    && edges.getPixel(nx, ny, 0) != 255) {
+                    strong.emplace(nx, ny);
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+// Distance around the circle between the encoded orientation and exact atan2 rounded to a step
+int stepsFromExact(int gx, int gy) {
+    double exact = std::atan2(gy, gx) * 128.0 / M_PI;
+    int step = static_cast<int>(std::lround(exact < 0 ? exact + 256.0 : exact)) & 255;
+    int difference = std::abs(Gradient::encodeOrientation(gx, gy) - step);
+    return std::min(difference, 256 - difference);
+}
+
+const Gradient::Operator allOperators[] = {Gradient::Operator::Sobel, Gradient::Operator::Prewitt,
+                                           Gradient::Operator::Scharr, Gradient::Operator::Roberts};
+
+} // namespace
+
+void GradientTests::testMatchesReference() {
+    std::cout << "Testing gradient engine against direct convolution..." << std::endl;
+
+    const std::pair<int, int> sizes[] = {{1, 1}, {2, 5}, {3, 3}, {37, 29}, {64, 2}};
+    for (const auto& size : sizes) {
+        for (int channels : {1, 3}) {
+            Image image = ProjectionTests::generateRandomImage(size.first, size.second, channels);
+            for (Gradient::Operator op : allOperators) {
+                std::vector<int> gx, gy;
+                referenceGradient(image, op, gx, gy);
+
+                Gradient::Result result = Gradient::compute(image, op, Gradient::AllOutputs);
+                assert(result.magnitude.getWidth() == size.first && result.magnitude.getChannels() == 1);
+                for (int y = 0; y < size.second; ++y) {
+                    for (int x = 0; x < size.first; ++x) {
+                        size_t i = static_cast<size_t>(y) * size.first + x;
+                        assert(result.magnitude.getPixel(x, y, 0) ==
+                               std::min(255, static_cast<int>(std::sqrt(gx[i] * gx[i] + gy[i] * gy[i]))));
+                        assert(result.orientation.getPixel(x, y, 0) == Gradient::encodeOrientation(gx[i], gy[i]));
+                    }
+                }
+
+                // Magnitude only, in place, matches the combined pass
+                Image inPlace(image);
+                Gradient::magnitude(inPlace, op, inPlace);
+                assert(ProjectionTests::compareImages(inPlace, result.magnitude, 0));
+            }
+
+            // The Filter edge operators are the engine's magnitude
+            Image sobel;
+            Filter::applySobelOperator(image, sobel);
+            assert(ProjectionTests::compareImages(sobel, Gradient::compute(image, Gradient::Operator::Sobel,
+                                                                           Gradient::Magnitude).magnitude, 0));
+        }
+    }
+
+    std::cout << "Gradient engine reference test passed." << std::endl;
+}
+
+void GradientTests::testOrientation() {
+    std::cout << "Testing gradient orientation..." << std::endl;
+
+    assert(Gradient::encodeOrientation(0, 0) == 0);
+    assert(Gradient::encodeOrientation(5, 0) == 0);
+    assert(Gradient::encodeOrientation(0, 5) == 64);
+    assert(Gradient::encodeOrientation(-5, 0) == 128);
+    assert(Gradient::encodeOrientation(0, -5) == 192);
+    assert(Gradient::encodeOrientation(3, 3) == 32);
+
+    // The polynomial never strays more than one step from exact atan2 over the full range of gradients
+    for (int gy = -1020; gy <= 1020; gy += 17) {
+        for (int gx = -1020; gx <= 1020; gx += 13) {
+            assert(stepsFromExact(gx, gy) <= 1);
+        }
+    }
+
+    // Brightness increasing to the right points along +x; increasing downwards along +y
+    Image horizontalRamp(8, 8, 1), verticalRamp(8, 8, 1);
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            horizontalRamp.setPixel(x, y, 0, static_cast<unsigned char>(20 * x));
+            verticalRamp.setPixel(x, y, 0, static_cast<unsigned char>(20 * y));
+        }
+    }
+    Gradient::Result right = Gradient::compute(horizontalRamp, Gradient::Operator::Sobel, Gradient::Orientation);
+    Gradient::Result down = Gradient::compute(verticalRamp, Gradient::Operator::Sobel, Gradient::Orientation);
+    assert(right.magnitude.getSize() == 0); // Not requested
+    assert(right.orientation.getPixel(4, 4, 0) == 0 && down.orientation.getPixel(4, 4, 0) == 64);
+    assert(right.orientation.getPixel(0, 4, 0) == 0 && down.orientation.getPixel(4, 7, 0) == 0);
+
+    std::cout << "Gradient orientation test passed." << std::endl;
+}
+
+void GradientTests::testLuminanceSource() {
+    std::cout << "Testing fused luminance gradients..." << std::endl;
+
+    for (int channels : {1, 3, 4}) {
+        Image image = ProjectionTests::generateRandomImage(41, 23, channels);
+        Image grey = channels >= 3 ? Filter::grayScale(image) : image;
+        for (Gradient::Operator op : allOperators) {
+            Gradient::Result fused = Gradient::compute(image, op, Gradient::AllOutputs, Gradient::Source::Luminance);
+            Gradient::Result separate = Gradient::compute(grey, op, Gradient::AllOutputs);
+            assert(ProjectionTests::compareImages(fused.magnitude, separate.magnitude, 0));
+            assert(ProjectionTests::compareImages(fused.orientation, separate.orientation, 0));
+        }
+    }
+
+    std::cout << "Fused luminance gradients test passed." << std::endl;
+}
+
+void GradientTests::testCannyMatchesReference() {
+    std::cout << "Testing Canny edges against a whole-image reference..." << std::endl;
+
+    // Tall enough to span several tiles, and noisy enough to give long, branching weak chains
+    Image noisy = ProjectionTests::generateRandomImage(83, 211, 3);
+    Image smooth = Filter::boxBlur(noisy, 5);
+    const std::pair<int, int> sizes[] = {{1, 1}, {2, 7}, {5, 3}};
+
+    for (bool luminance : {false, true}) {
+        Gradient::Source source = luminance ? Gradient::Source::Luminance : Gradient::Source::FirstChannel;
+        for (const Image* image : {&noisy, &smooth}) {
+            Image expected = referenceCanny(*image, 20.0f, 60.0f, 5, 1.4f, luminance);
+            Image edges = Gradient::canny(*image, 20.0f, 60.0f, 5, 1.4f, source);
+            assert(edges.getChannels() == 1);
+            assert(ProjectionTests::compareImages(edges, expected, 0));
+        }
+        Image unsmoothed = Gradient::canny(smooth, 10.0f, 10.0f, 1, 1.0f, source);
+        assert(ProjectionTests::compareImages(unsmoothed, referenceCanny(smooth, 10.0f, 10.0f, 1, 1.0f, luminance), 0));
+        for (const auto& size : sizes) {
+            Image tiny = ProjectionTests::generateRandomImage(size.first, size.second, 3);
+            assert(ProjectionTests::compareImages(Gradient::canny(tiny, 5.0f, 10.0f, 3, 1.0f, source),
+                                                  referenceCanny(tiny, 5.0f, 10.0f, 3, 1.0f, luminance), 0));
+        }
+    }
+
+    // In place through Filter, and invalid parameters
+    Image inPlace = smooth;
+    Filter::applyCannyEdgeDetector(inPlace, inPlace, 20.0f, 60.0f);
+    assert(ProjectionTests::compareImages(inPlace, referenceCanny(smooth, 20.0f, 60.0f, 5, 1.4f, false), 0));
+    for (auto parameters : {std::make_pair(4, 10.0f), std::make_pair(5, -1.0f), std::make_pair(5, 80.0f)}) {
+        bool thrown = false;
+        try {
+            Gradient::canny(smooth, parameters.second, 60.0f, parameters.first, 1.4f);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "Canny reference test passed." << std::endl;
+}
+
+void GradientTests::testCannyHysteresis() {
+    std::cout << "Testing Canny hysteresis across tiles..." << std::endl;
+
+    // Two vertical step edges running the full height of several tiles. The contrast of the left one grows
+    // smoothly down the image, so only its bottom end is strong and the rest has to be reached through the tile
+    // seams; the right one stays below the low threshold
+    int width = 40, height = 300;
+    Image image(width, height, 1);
+    for (int y = 0; y < height; ++y) {
+        int leftStep = 40 + 160 * y / (height - 1);
+        for (int x = 0; x < width; ++x) {
+            int value = 20;
+            if (x >= 10) value += leftStep;
+            if (x >= 30) value += 10;
+            image.setPixel(x, y, 0, static_cast<unsigned char>(value));
+        }
+    }
+
+    int previousThreads = Parallel::getThreadCount();
+    Image reference;
+    for (int threads : {1, 3, 8}) {
+        Parallel::setThreadCount(threads);
+        Image edges = Filter::applyCannyEdgeDetector(image, 60.0f, 550.0f, 3, 0.8f);
+        if (threads == 1) {
+            reference = edges;
+            // The left edge is one pixel wide in every interior row
+            for (int y = 1; y < height - 1; ++y) {
+                int count = 0;
+                for (int x = 0; x < width; ++x) {
+                    count += edges.getPixel(x, y, 0) == 255 && x < 20;
+                    assert(x < 20 || edges.getPixel(x, y, 0) == 0);
+                }
+                assert(count == 1);
+            }
+        }
+        assert(ProjectionTests::compareImages(edges, reference, 0));
+    }
+    Parallel::setThreadCount(previousThreads);
+
+    // With nothing strong, the weak chain is dropped entirely
+    Image none = Filter::applyCannyEdgeDetector(image, 60.0f, 5000.0f, 3, 0.8f);
+    assert(std::all_of(none.getData(), none.getData() + none.getSize(), [](unsigned char v) { return v == 0; }));
+
+    std::cout << "Canny hysteresis test passed." << std::endl;
+}
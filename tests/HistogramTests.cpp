@@ -0,0 +1,159 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "HistogramTests.h"
+#include "PixelKernelsTests.h"
+#include "ProjectionTests.h"
+#include "Histogram.h"
+#include "Filter.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+void HistogramTests::testCounts() {
+    std::cout << "Testing Histogram counts..." << std::endl;
+
+    int previousThreads = Parallel::getThreadCount();
+    for (int threads : {1, 4}) {
+        Parallel::setThreadCount(threads);
+        for (int channels : {1, 3, 4}) {
+            Image image = ProjectionTests::generateRandomImage(53, 41, channels);
+            // A long run of one value exercises the interleaved sub-histograms
+            for (int x = 0; x < 53; ++x) {
+                image.setPixel(x, 7, 0, 200);
+            }
+
+            for (int c = 0; c < channels; ++c) {
+                Histogram::Counts expected{};
+                for (int y = 0; y < 41; ++y) {
+                    for (int x = 0; x < 53; ++x) {
+                        expected[image.getPixel(x, y, c)]++;
+                    }
+                }
+                assert(Histogram::compute(image, c) == expected);
+            }
+
+            if (channels >= 3) {
+                for (bool isHSV : {true, false}) {
+                    // V and L as the HSV and HSL conversions produce them
+                    Image converted = isHSV ? Filter::rgb_to_hsv(image) : Filter::RGBtoHSL(image);
+                    assert(Histogram::computeBrightness(image, isHSV) == Histogram::compute(converted, 2));
+                }
+            }
+        }
+    }
+    Parallel::setThreadCount(previousThreads);
+
+    // Counting a strided tile in one call equals counting its rows one by one, for short and long tiles
+    Image tiled = ProjectionTests::generateRandomImage(300, 40, 3);
+    for (int tileWidth : {5, 120}) {
+        Histogram::Counts rows{}, expected{};
+        const unsigned char* corner = tiled.getData() + 3 * 300 * 2 + 3 * 7 + 1;
+        Histogram::accumulate(corner, 3, tileWidth, 30, 3 * 300, rows);
+        for (int y = 0; y < 30; ++y) {
+            Histogram::accumulate(corner + y * 3 * 300, 3, tileWidth, expected);
+        }
+        assert(rows == expected);
+    }
+
+    // Out-of-range channels and single-channel brightness are rejected
+    Image grey = ProjectionTests::generateRandomImage(4, 4, 1);
+    bool thrown = false;
+    try {
+        Histogram::compute(grey, 1);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        Histogram::computeBrightness(grey, true);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Histogram counts test passed." << std::endl;
+}
+
+void HistogramTests::testEqualisationTable() {
+    std::cout << "Testing Histogram equalisation table..." << std::endl;
+
+    // Four equally common values spread over the full range
+    Histogram::Counts counts{};
+    counts[0] = counts[10] = counts[20] = counts[30] = 5;
+    Histogram::Table table = Histogram::equalisationTable(counts);
+    assert(table[0] == 0 && table[10] == 85 && table[20] == 170 && table[30] == 255);
+    assert(table[15] == 85 && table[255] == 255);
+
+    // Values below the lowest occupied one map to 0
+    Histogram::Counts shifted{};
+    shifted[100] = 1;
+    shifted[101] = 3;
+    table = Histogram::equalisationTable(shifted);
+    assert(table[50] == 0 && table[100] == 0 && table[101] == 255);
+
+    // A single value, or nothing at all, maps everything to 0
+    Histogram::Counts single{};
+    single[42] = 9;
+    table = Histogram::equalisationTable(single);
+    assert(std::all_of(table.begin(), table.end(), [](unsigned char v) { return v == 0; }));
+    table = Histogram::equalisationTable(Histogram::Counts{});
+    assert(std::all_of(table.begin(), table.end(), [](unsigned char v) { return v == 0; }));
+
+    std::cout << "Histogram equalisation table test passed." << std::endl;
+}
+
+void HistogramTests::testFusedEqualisation() {
+    std::cout << "Testing fused histogram equalisation..." << std::endl;
+
+    std::vector<PixelKernels::Isa> isas = PixelKernelsTests::vectorIsas();
+    isas.push_back(PixelKernels::Isa::Scalar);
+    for (PixelKernels::Isa isa : isas) {
+        PixelKernels::setIsa(isa);
+        for (int channels : {3, 4}) {
+            Image image = ProjectionTests::generateRandomImage(67, 23, channels);
+            for (bool isHSV : {true, false}) {
+                // The fused rows give exactly what converting the whole image, equalising and converting back does
+                Image expected = isHSV
+                        ? Filter::hsv_to_rgb(Filter::calculateHistogramEqualization(Filter::rgb_to_hsv(image), 2))
+                        : Filter::HSLtoRGB(Filter::calculateHistogramEqualization(Filter::RGBtoHSL(image), 2));
+                Image fused = Filter::histogramEqualization(image, isHSV);
+                assert(fused.getChannels() == 3);
+                assert(ProjectionTests::compareImages(fused, expected, 0));
+
+                Image inPlace = image;
+                Filter::histogramEqualization(inPlace, inPlace, isHSV);
+                assert(ProjectionTests::compareImages(inPlace, expected, 0));
+            }
+        }
+
+        // Single channel, against a direct remap through the table
+        Image grey = ProjectionTests::generateRandomImage(67, 23, 1);
+        Image equalised = Filter::histogramEqualization(grey, false);
+        Image remapped(67, 23, 1);
+        Histogram::Table table = Histogram::equalisationTable(Histogram::compute(grey, 0));
+        for (int y = 0; y < 23; ++y) {
+            for (int x = 0; x < 67; ++x) {
+                remapped.setPixel(x, y, 0, table[grey.getPixel(x, y, 0)]);
+            }
+        }
+        assert(ProjectionTests::compareImages(equalised, remapped, 0));
+        Filter::histogramEqualization(grey, grey, false);
+        assert(ProjectionTests::compareImages(grey, equalised, 0));
+    }
+    PixelKernels::setIsa(PixelKernels::detectIsa());
+
+    std::cout << "Fused histogram equalisation test passed." << std::endl;
+}
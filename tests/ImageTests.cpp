@@ -4,8 +4,10 @@
 
 #include "ImageTests.h"
 #include "Image.h"
+#include "Volume.h"
 #include <cassert>
 #include <iostream>
+#include <utility>
 
 void ImageTests::testImageCreationFromDimensions() {
     Image img(10, 10, 3);
@@ -38,4 +40,94 @@ void ImageTests::testImageSave() {
     }
 }
 
+void ImageTests::testImageMove() {
+    Image original(10, 10, 3);
+    original.setPixel(3, 4, 2, 77);
+    const unsigned char* buffer = original.getData();
+
+    // Moving hands over the buffer without copying and leaves the source empty
+    Image moved = std::move(original);
+    assert(moved.getData() == buffer && moved.getPixel(3, 4, 2) == 77);
+    assert(original.getData() == nullptr && original.getWidth() == 0 && original.getSize() == 0);
+
+    Image assigned(2, 2, 1);
+    assigned = std::move(moved);
+    assert(assigned.getData() == buffer && assigned.getWidth() == 10 && assigned.getChannels() == 3);
+    assert(moved.getData() == nullptr);
+
+    // A moved-from image can be reused
+    moved = assigned;
+    assert(moved.getData() != buffer && moved.getPixel(3, 4, 2) == 77);
+    std::cout << "testImageMove passed." << std::endl;
+}
 
+void ImageTests::testImageBufferReuse() {
+    Image img(8, 6, 3);
+    const unsigned char* buffer = img.getData();
+    assert(img.getSize() == 8 * 6 * 3);
+
+    // Same byte count keeps the buffer, a different one reallocates
+    img.resize(6, 8, 3);
+    assert(img.getData() == buffer && img.getWidth() == 6 && img.getHeight() == 8);
+    img.resize(8, 6, 1);
+    assert(img.getSize() == 8 * 6 && img.getChannels() == 1);
+
+    // Copy assignment between equally sized images reuses the destination buffer
+    Image source(8, 6, 1);
+    source.setPixel(1, 1, 0, 9);
+    const unsigned char* target = img.getData();
+    img = source;
+    assert(img.getData() == target && img.getPixel(1, 1, 0) == 9);
+
+    // Swapping exchanges buffers and dimensions
+    Image other(2, 3, 4);
+    const unsigned char* otherBuffer = other.getData();
+    img.swap(other);
+    assert(img.getData() == otherBuffer && img.getWidth() == 2 && img.getChannels() == 4);
+    assert(other.getData() == target && other.getWidth() == 8 && other.getPixel(1, 1, 0) == 9);
+    std::cout << "testImageBufferReuse passed." << std::endl;
+}
+
+void ImageTests::testViews() {
+    Image image(5, 4, 3);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 5; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                image.setPixel(x, y, c, static_cast<unsigned char>(y * 100 + x * 10 + c));
+            }
+        }
+    }
+
+    // Packed view: rows are width * channels apart and writes go through to the image
+    PlaneView<unsigned char> view = image.view();
+    assert(view.isContiguous() && view.getRowStride() == 15 && view.getPixelStride() == 3);
+    assert(view.row(2)[4 * 3 + 1] == 241);
+    view(1, 3, 2) = 7;
+    assert(image.getPixel(1, 3, 2) == 7);
+
+    // A region shares the strides and starts at its corner
+    PlaneView<const unsigned char> region = image.constView().region(2, 1, 3, 2);
+    assert(region.getWidth() == 3 && region.getHeight() == 2 && !region.isContiguous());
+    assert(region(0, 0, 0) == 120 && region(2, 1, 1) == 241);
+
+    // Planes cut through a volume without copying
+    Volume volume(4, 3, 2, 2);
+    VolumeView<unsigned char> voxels = volume.view();
+    for (int z = 0; z < 2; ++z) {
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                voxels(x, y, z, 0) = static_cast<unsigned char>(z * 100 + y * 10 + x);
+                voxels(x, y, z, 1) = 255;
+            }
+        }
+    }
+    assert(voxels.row(2, 1)[3 * 2] == 123);
+    PlaneView<const unsigned char> yz = static_cast<const Volume&>(volume).view().planeYZ(3);
+    assert(yz.getWidth() == 3 && yz.getHeight() == 2);
+    assert(yz(2, 1) == 123 && yz(0, 0) == 3 && yz(1, 0, 1) == 255);
+    PlaneView<unsigned char> xz = voxels.planeXZ(1);
+    assert(xz(2, 1) == 112);
+    assert(voxels.planeXY(1)(3, 2) == volume.getVoxel(3, 2, 1, 0));
+
+    std::cout << "testViews passed." << std::endl;
+}
@@ -10,5 +10,8 @@ public:
     static void testImageCopy();
     static void testPixelManipulation();
     static void testImageSave();
+    static void testImageMove();
+    static void testImageBufferReuse();
+    static void testViews();
 };
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_IMAGETESTS_H
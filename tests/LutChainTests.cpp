@@ -0,0 +1,119 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <stdexcept>
+#include <vector>
+#include "LutChainTests.h"
+#include "PixelKernelsTests.h"
+#include "ProjectionTests.h"
+#include "TestHelpers.h"
+#include "LutChain.h"
+#include "Filter.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+void LutChainTests::testCompile() {
+    std::cout << "Testing LutChain compilation..." << std::endl;
+
+    // An empty chain is the identity
+    LutChain empty;
+    assert(empty.getReduction() == LutChain::Reduction::None);
+    for (int v = 0; v < 256; ++v) {
+        assert(empty.getBefore()[v] == v && empty.getAfter()[v] == v);
+    }
+
+    // Offsets compose with saturation between them, not as one summed offset
+    LutChain offsets;
+    offsets.brightness(10).brightness(-20);
+    assert(offsets.getBefore()[250] == 235 && offsets.getBefore()[5] == 0 && offsets.getBefore()[100] == 90);
+
+    // Gamma keeps the end points and brightens mid-tones above 1
+    LutChain gamma;
+    gamma.gamma(2.0);
+    assert(gamma.getBefore()[0] == 0 && gamma.getBefore()[255] == 255 && gamma.getBefore()[64] == 128);
+
+    // Operations after a reduction go into the second table, and a second reduction changes nothing
+    LutChain reduced;
+    reduced.brightness(5).grayscale().threshold(100).grayscale();
+    assert(reduced.getReduction() == LutChain::Reduction::Grayscale);
+    assert(reduced.getBefore()[0] == 5 && reduced.getAfter()[99] == 0 && reduced.getAfter()[100] == 255);
+    LutChain thresholded;
+    thresholded.threshold(7.5).grayscale();
+    assert(thresholded.getReduction() == LutChain::Reduction::FirstChannel);
+    assert(thresholded.getAfter()[7] == 0 && thresholded.getAfter()[8] == 255);
+
+    assert(throwsInvalidArgument([] { LutChain().brightness(256); }));
+    assert(throwsInvalidArgument([] { LutChain().gamma(0.0); }));
+    Image twoChannels = ProjectionTests::generateRandomImage(5, 4, 2);
+    assert(throwsInvalidArgument([&] { LutChain().grayscale().apply(twoChannels); }));
+
+    std::cout << "LutChain compilation test passed." << std::endl;
+}
+
+void LutChainTests::testMatchesFilters() {
+    std::cout << "Testing LutChain against the filters..." << std::endl;
+
+    std::vector<PixelKernels::Isa> isas = PixelKernelsTests::vectorIsas();
+    isas.push_back(PixelKernels::Isa::Scalar);
+    int previousThreads = Parallel::getThreadCount();
+    for (PixelKernels::Isa isa : isas) {
+        PixelKernels::setIsa(isa);
+        for (int threads : {1, 4}) {
+            Parallel::setThreadCount(threads);
+            for (int channels : {1, 2, 3, 4}) {
+                Image image = ProjectionTests::generateRandomImage(71, 29, channels);
+
+                // Point operations only
+                Image expected = Filter::adjustGamma(Filter::setBrightness(image, 40), 0.6);
+                expected = Filter::setBrightness(expected, -25);
+                LutChain points;
+                points.brightness(40).gamma(0.6).brightness(-25);
+                assert(ProjectionTests::compareImages(points.apply(image), expected, 0));
+                Image inPlace = image;
+                points.apply(inPlace, inPlace);
+                assert(ProjectionTests::compareImages(inPlace, expected, 0));
+
+                // Threshold of channel 0 after and before other point operations
+                expected = Filter::threshold(Filter::setBrightness(image, -30), 90.5, false, false);
+                expected = Filter::adjustGamma(expected, 1.7);
+                LutChain threshold;
+                threshold.brightness(-30).threshold(90.5).gamma(1.7);
+                assert(ProjectionTests::compareImages(threshold.apply(image), expected, 0));
+                inPlace = image;
+                threshold.apply(inPlace, inPlace);
+                assert(ProjectionTests::compareImages(inPlace, expected, 0));
+
+                if (channels == 2) {
+                    continue;
+                }
+
+                // Grayscale between point operations, with and without tables on either side
+                expected = Filter::grayScale(Filter::setBrightness(image, 15));
+                expected = Filter::threshold(Filter::adjustGamma(expected, 2.2), 128, false, false);
+                LutChain grey;
+                grey.brightness(15).grayscale().gamma(2.2).threshold(128);
+                assert(ProjectionTests::compareImages(grey.apply(image), expected, 0));
+                inPlace = image;
+                grey.apply(inPlace, inPlace);
+                assert(ProjectionTests::compareImages(inPlace, expected, 0));
+
+                assert(ProjectionTests::compareImages(LutChain().grayscale().apply(image), Filter::grayScale(image), 0));
+                expected = Filter::grayScale(Filter::adjustGamma(image, 0.8));
+                assert(ProjectionTests::compareImages(LutChain().gamma(0.8).grayscale().apply(image), expected, 0));
+            }
+        }
+    }
+    Parallel::setThreadCount(previousThreads);
+    PixelKernels::setIsa(PixelKernels::detectIsa());
+
+    std::cout << "LutChain filter comparison test passed." << std::endl;
+}
@@ -0,0 +1,174 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include "ParallelTests.h"
+#include "ProjectionTests.h"
+#include "Parallel.h"
+#include "Filter.h"
+
+bool ParallelTests::imagesEqual(const Image& img1, const Image& img2) {
+    if (img1.getWidth() != img2.getWidth() || img1.getHeight() != img2.getHeight() ||
+        img1.getChannels() != img2.getChannels()) {
+        return false;
+    }
+    for (int y = 0; y < img1.getHeight(); ++y) {
+        for (int x = 0; x < img1.getWidth(); ++x) {
+            for (int c = 0; c < img1.getChannels(); ++c) {
+                if (img1.getPixel(x, y, c) != img2.getPixel(x, y, c)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void ParallelTests::testForRangeCoverage() {
+    std::cout << "Testing Parallel::forRange coverage..." << std::endl;
+
+    Parallel::setThreadCount(4);
+    assert(Parallel::getThreadCount() == 4);
+
+    // Every index must be visited exactly once, whatever the grain
+    for (int grain : {0, 1, 7, 1000}) {
+        std::vector<std::atomic<int>> visits(997);
+        for (auto& v : visits) {
+            v = 0;
+        }
+        Parallel::forRange(0, 997, [&](int begin, int end) {
+            assert(begin < end);
+            for (int i = begin; i < end; ++i) {
+                visits[i]++;
+            }
+        }, grain);
+        assert(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+    }
+
+    // An empty range never calls the body
+    bool called = false;
+    Parallel::forRange(5, 5, [&](int, int) { called = true; });
+    assert(!called);
+
+    // Ranges ending at INT_MAX, or spanning the whole int range, are split without wrapping
+    std::atomic<long long> covered(0);
+    Parallel::forRange(INT_MAX - 1000, INT_MAX, [&](int begin, int end) {
+        assert(begin < end);
+        covered += end - begin;
+    }, 7);
+    assert(covered == 1000);
+    covered = 0;
+    Parallel::forRange(INT_MIN, INT_MAX, [&](int begin, int end) {
+        assert(begin < end);
+        covered += static_cast<long long>(end) - begin;
+    }, INT_MAX / 2);
+    assert(covered == static_cast<long long>(INT_MAX) - INT_MIN);
+
+    Parallel::setThreadCount(0);
+    std::cout << "Parallel::forRange coverage test passed." << std::endl;
+}
+
+void ParallelTests::testNestedForRange() {
+    std::cout << "Testing nested Parallel::forRange..." << std::endl;
+
+    Parallel::setThreadCount(4);
+    std::atomic<int> total(0);
+    Parallel::forRange(0, 16, [&](int begin, int end) {
+        assert(Parallel::inParallelRegion());
+        for (int i = begin; i < end; ++i) {
+            // Inner loops run serially on the calling band
+            Parallel::forRange(0, 10, [&](int innerBegin, int innerEnd) {
+                total += innerEnd - innerBegin;
+            });
+        }
+    }, 1);
+    assert(total == 160);
+    assert(!Parallel::inParallelRegion());
+
+    // Resizing from a band would wait for its own loop, so it is refused on workers and the caller alike
+    std::atomic<int> refused(0);
+    Parallel::forRange(0, 8, [&](int, int) {
+        try {
+            Parallel::setThreadCount(2);
+        } catch (const std::logic_error&) {
+            refused++;
+        }
+    }, 1);
+    assert(refused == 8 && Parallel::getThreadCount() == 4);
+
+    Parallel::setThreadCount(0);
+    std::cout << "Nested Parallel::forRange test passed." << std::endl;
+}
+
+void ParallelTests::testExceptionPropagation() {
+    std::cout << "Testing Parallel::forRange exception propagation..." << std::endl;
+
+    Parallel::setThreadCount(4);
+    bool caught = false;
+    try {
+        Parallel::forRange(0, 100, [](int begin, int end) {
+            if (begin <= 50 && 50 < end) {
+                throw std::runtime_error("band failure");
+            }
+        }, 1);
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+
+    // The pool must still be usable afterwards
+    std::atomic<int> count(0);
+    Parallel::forRange(0, 100, [&](int begin, int end) { count += end - begin; });
+    assert(count == 100);
+
+    Parallel::setThreadCount(0);
+    std::cout << "Parallel::forRange exception propagation test passed." << std::endl;
+}
+
+void ParallelTests::testFiltersMatchSerial() {
+    std::cout << "Testing filters give identical results for any thread count..." << std::endl;
+
+    Image rgb = ProjectionTests::generateRandomImage(157, 93, 3);
+    Image gray = ProjectionTests::generateRandomImage(157, 93, 1);
+
+    std::vector<std::function<Image()>> operations = {
+            [&]() { return Filter::medianBlur(rgb, 5); },
+            [&]() { return Filter::histomedianBlur(gray, 5); },
+            [&]() { return Filter::boxBlur(rgb, 4); },
+            [&]() { return Filter::gaussianBlur(rgb, 5, 1.5f); },
+            [&]() { return Filter::grayScale(rgb); },
+            [&]() { return Filter::setBrightness(rgb, 40, false); },
+            [&]() { return Filter::setBrightness(rgb, 0, true); },
+            [&]() { return Filter::histogramEqualization(rgb, true); },
+            [&]() { return Filter::histogramEqualization(rgb, false); },
+            [&]() { return Filter::threshold(rgb, 100, true, true); },
+            [&]() { return Filter::applySobelOperator(gray); },
+            [&]() { return Filter::applyRobertsCrossOperator(gray); },
+    };
+
+    for (const auto& operation : operations) {
+        Parallel::setThreadCount(1);
+        Image serial = operation();
+        for (int threads : {2, 3, 8}) {
+            Parallel::setThreadCount(threads);
+            assert(imagesEqual(serial, operation()));
+        }
+    }
+
+    Parallel::setThreadCount(0);
+    std::cout << "Filter thread-count invariance test passed." << std::endl;
+}
@@ -0,0 +1,29 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLELTESTS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLELTESTS_H
+#include "Image.h"
+#include <iostream>
+#include <cassert>
+
+class ParallelTests {
+public:
+    static void testForRangeCoverage();
+    static void testNestedForRange();
+    static void testExceptionPropagation();
+    static void testFiltersMatchSerial();
+
+private:
+    static bool imagesEqual(const Image& img1, const Image& img2);
+};
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PARALLELTESTS_H
@@ -0,0 +1,192 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PipelineTests.h"
+#include "ProjectionTests.h"
+#include "Pipeline.h"
+#include "Parallel.h"
+#include "Filter.h"
+
+namespace fs = std::filesystem;
+
+void PipelineTests::testParse() {
+    std::cout << "Testing Pipeline::parse..." << std::endl;
+
+    Pipeline pipeline = Pipeline::parse("grayscale, gaussian:5:1.2 ,sobel,threshold:128:hsv,brightness:auto,Median:7");
+    const auto& steps = pipeline.getSteps();
+    assert(steps.size() == 6);
+    assert(steps[0].operation == Pipeline::Operation::Grayscale);
+    assert(steps[1].operation == Pipeline::Operation::GaussianBlur);
+    assert(steps[1].kernelSize == 5 && steps[1].value == 1.2);
+    assert(steps[2].operation == Pipeline::Operation::Sobel);
+    assert(steps[3].operation == Pipeline::Operation::Threshold);
+    assert(steps[3].value == 128 && steps[3].rgb && steps[3].isHSV);
+    assert(steps[4].operation == Pipeline::Operation::AutoBrightness);
+    assert(steps[5].operation == Pipeline::Operation::MedianBlur && steps[5].kernelSize == 7);
+
+    // Threshold without a colour space works on channel 0
+    Pipeline grey = Pipeline::parse("threshold:90");
+    assert(grey.getSteps()[0].value == 90 && !grey.getSteps()[0].rgb);
+
+    Pipeline canny = Pipeline::parse("canny:20:60");
+    assert(canny.getSteps()[0].operation == Pipeline::Operation::Canny);
+    assert(canny.getSteps()[0].value == 20 && canny.getSteps()[0].upperValue == 60);
+
+    Pipeline gamma = Pipeline::parse("gamma:2.2");
+    assert(gamma.getSteps()[0].operation == Pipeline::Operation::Gamma && gamma.getSteps()[0].value == 2.2);
+
+    // CLAHE defaults to a clip limit of 2 and 8x8 tiles
+    Pipeline clahe = Pipeline::parse("clahe,clahe:3.5:4");
+    assert(clahe.getSteps()[0].operation == Pipeline::Operation::AdaptiveEqualize);
+    assert(clahe.getSteps()[0].value == 2.0 && clahe.getSteps()[0].tiles == 8);
+    assert(clahe.getSteps()[1].value == 3.5 && clahe.getSteps()[1].tiles == 4);
+
+    std::cout << "Pipeline::parse test passed." << std::endl;
+}
+
+void PipelineTests::testParseErrors() {
+    std::cout << "Testing Pipeline::parse errors..." << std::endl;
+
+    const std::vector<std::string> invalid = {
+            "", "grayscale,,sobel", "blur:3", "gaussian:4:1.0", "gaussian:5", "gaussian:5:0",
+            "median:abc", "box:3x", "brightness:300", "threshold:300", "threshold:10:lab",
+            "saltpepper:2", "sobel:1", "canny:20", "canny:60:20", "canny:-1:5",
+            "clahe:0", "clahe:2:0", "clahe:2:2.5", "clahe:2:8:8", "gamma", "gamma:0", "gamma:-1"
+    };
+    for (const std::string& specification : invalid) {
+        bool thrown = false;
+        try {
+            Pipeline::parse(specification);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "Pipeline::parse errors test passed." << std::endl;
+}
+
+void PipelineTests::testApplyMatchesFilters() {
+    std::cout << "Testing Pipeline::apply..." << std::endl;
+
+    Image input = ProjectionTests::generateRandomImage(45, 33, 3);
+    Image image = input;
+    Pipeline::parse("brightness:-10,box:3,grayscale,gaussian:5:1.2,median:3,sobel,threshold:40").apply(image);
+
+    Image expected = Filter::setBrightness(input, -10);
+    expected = Filter::boxBlur(expected, 3);
+    expected = Filter::grayScale(expected);
+    expected = Filter::gaussianBlur(expected, 5, 1.2f);
+    expected = Filter::medianBlur(expected, 3);
+    expected = Filter::applySobelOperator(expected);
+    expected = Filter::threshold(expected, 40, false, false);
+    assert(ProjectionTests::compareImages(image, expected, 0));
+
+    image = input;
+    Pipeline::parse("equalize:hsv,roberts").apply(image);
+    assert(ProjectionTests::compareImages(
+            image, Filter::applyRobertsCrossOperator(Filter::histogramEqualization(input, true)), 0));
+
+    image = input;
+    Pipeline::parse("grayscale,canny:30:90").apply(image);
+    assert(ProjectionTests::compareImages(
+            image, Filter::applyCannyEdgeDetector(Filter::grayScale(input), 30, 90), 0));
+
+    image = input;
+    Pipeline::parse("clahe:3:4").apply(image);
+    assert(ProjectionTests::compareImages(image, Filter::adaptiveHistogramEqualization(input, 3.0, 4, 4), 0));
+
+    // Runs of pointwise steps are fused, around a step that is not pointwise and an RGB threshold that is not
+    image = input;
+    Pipeline::parse("brightness:25,gamma:0.7,grayscale,threshold:100,box:3,gamma:1.4,brightness:-5").apply(image);
+    expected = Filter::grayScale(Filter::adjustGamma(Filter::setBrightness(input, 25), 0.7));
+    expected = Filter::boxBlur(Filter::threshold(expected, 100, false, false), 3);
+    expected = Filter::setBrightness(Filter::adjustGamma(expected, 1.4), -5);
+    assert(ProjectionTests::compareImages(image, expected, 0));
+
+    image = input;
+    Pipeline::parse("gamma:1.2,threshold:90:hsv,brightness:3,gamma:2").apply(image);
+    expected = Filter::threshold(Filter::adjustGamma(input, 1.2), 90, true, true);
+    expected = Filter::adjustGamma(Filter::setBrightness(expected, 3), 2.0);
+    assert(ProjectionTests::compareImages(image, expected, 0));
+
+    std::cout << "Pipeline::apply test passed." << std::endl;
+}
+
+void PipelineTests::testRunBatch() {
+    std::cout << "Testing Pipeline::runBatch..." << std::endl;
+
+    fs::path root = fs::temp_directory_path() / "ziggurat_pipeline_test";
+    fs::remove_all(root);
+    fs::create_directories(root / "in");
+
+    std::vector<Image> inputs;
+    for (int i = 0; i < 5; ++i) {
+        inputs.push_back(ProjectionTests::generateRandomImage(20 + i, 16, 3));
+        inputs.back().save((root / "in" / ("frame" + std::to_string(i) + ".png")).string());
+    }
+    // Not an image; it is listed as an input but must fail on its own without stopping the batch
+    fs::create_directories(root / "in" / "broken.png");
+
+    std::vector<std::string> paths = Pipeline::collectInputs((root / "in").string());
+    assert(paths.size() == 5);
+    paths.push_back((root / "in" / "broken.png").string());
+
+    Pipeline pipeline = Pipeline::parse("grayscale,gaussian:3:1.0,sobel");
+    int originalThreads = Parallel::getThreadCount();
+    for (int threads : {1, 4}) {
+        Parallel::setThreadCount(threads);
+        fs::path output = root / ("out" + std::to_string(threads));
+        Pipeline::BatchResult result = pipeline.runBatch(paths, output.string());
+        assert(result.processed == 5);
+        assert(result.failures.size() == 1 && result.failures[0].first == paths.back());
+
+        for (int i = 0; i < 5; ++i) {
+            Image expected = inputs[i];
+            pipeline.apply(expected);
+            Image written((output / ("frame" + std::to_string(i) + ".png")).string());
+            assert(ProjectionTests::compareImages(written, expected, 0));
+        }
+    }
+    Parallel::setThreadCount(originalThreads);
+
+    // frame0.png and frame0.jpg would both be written as frame0.png, so neither is processed
+    fs::create_directories(root / "other");
+    std::string clash = (root / "other" / "frame0.jpg").string();
+    inputs[0].save(clash);
+    Pipeline::BatchResult clashing = pipeline.runBatch({paths[0], clash, paths[1]}, (root / "clash").string());
+    assert(clashing.processed == 1 && clashing.failures.size() == 2);
+    assert(clashing.failures[0].first == paths[0] && clashing.failures[1].first == clash);
+    assert(!fs::exists(root / "clash" / "frame0.png") && fs::exists(root / "clash" / "frame1.png"));
+
+    // Noise comes from a per-call engine, so the same seed repeats it
+    Pipeline noise = Pipeline::parse("saltpepper:0.3");
+    Image first = inputs[2], second = inputs[2];
+    noise.apply(first, 42);
+    noise.apply(second, 42);
+    assert(ProjectionTests::compareImages(first, second, 0) && !ProjectionTests::compareImages(first, inputs[2], 0));
+
+    bool thrown = false;
+    try {
+        Pipeline::collectInputs((root / "missing").string());
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    fs::remove_all(root);
+    std::cout << "Pipeline::runBatch test passed." << std::endl;
+}
@@ -0,0 +1,25 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINETESTS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINETESTS_H
+#include <iostream>
+#include <cassert>
+
+class PipelineTests {
+public:
+    static void testParse();
+    static void testParseErrors();
+    static void testApplyMatchesFilters();
+    static void testRunBatch();
+};
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIPELINETESTS_H
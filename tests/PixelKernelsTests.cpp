@@ -0,0 +1,178 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include "PixelKernelsTests.h"
+
+int PixelKernelsTests::maxDifference(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b,
+                                     int channels, int hueChannel) {
+    int worst = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int diff = std::abs(a[i] - b[i]);
+        if (static_cast<int>(i % channels) == hueChannel) {
+            // Hue 255 (just under 360 degrees) and hue 0 are neighbours
+            diff = std::min(diff, 255 - diff);
+        }
+        worst = std::max(worst, diff);
+    }
+    return worst;
+}
+
+// Every vector instruction set this machine and build can run
+std::vector<PixelKernels::Isa> PixelKernelsTests::vectorIsas() {
+    std::vector<PixelKernels::Isa> isas;
+    PixelKernels::Isa best = PixelKernels::detectIsa();
+    if (best >= PixelKernels::Isa::SSE41) {
+        isas.push_back(PixelKernels::Isa::SSE41);
+    }
+    if (best >= PixelKernels::Isa::AVX2) {
+        isas.push_back(PixelKernels::Isa::AVX2);
+    }
+    return isas;
+}
+
+void PixelKernelsTests::testIsaSelection() {
+    std::cout << "Testing PixelKernels instruction set selection..." << std::endl;
+
+    PixelKernels::Isa best = PixelKernels::detectIsa();
+    assert(PixelKernels::getIsa() == best);
+
+    PixelKernels::setIsa(PixelKernels::Isa::Scalar);
+    assert(PixelKernels::getIsa() == PixelKernels::Isa::Scalar);
+
+    // Unavailable instruction sets fall back to the best available one
+    PixelKernels::setIsa(PixelKernels::Isa::AVX2);
+    assert(PixelKernels::getIsa() == best);
+
+    std::cout << "Instruction set in use: " << PixelKernels::isaName(best) << std::endl;
+    std::cout << "PixelKernels instruction set selection test passed." << std::endl;
+}
+
+void PixelKernelsTests::testIntegerKernelsMatchScalar() {
+    std::cout << "Testing PixelKernels brightness, threshold and lookup against scalar..." << std::endl;
+
+    // An odd length exercises the scalar tail after the vector blocks
+    std::vector<unsigned char> src(1000 * 3 + 7);
+    for (auto& v : src) {
+        v = rand() % 256;
+    }
+    src[0] = 0;
+    src[1] = 255;
+
+    for (PixelKernels::Isa isa : vectorIsas()) {
+        for (int value : {-255, -100, -1, 0, 1, 37, 255}) {
+            std::vector<unsigned char> expected(src.size()), actual(src.size());
+            PixelKernels::setIsa(PixelKernels::Isa::Scalar);
+            PixelKernels::addBrightness(src.data(), expected.data(), src.size(), value);
+            PixelKernels::setIsa(isa);
+            PixelKernels::addBrightness(src.data(), actual.data(), src.size(), value);
+            assert(actual == expected);
+        }
+
+        for (double thresholdValue : {-1.0, 0.0, 0.5, 100.0, 127.3, 255.0, 255.5, 300.0}) {
+            for (int stride : {1, 3}) {
+                size_t count = src.size() / stride;
+                std::vector<unsigned char> expected(count), actual(count);
+                PixelKernels::setIsa(PixelKernels::Isa::Scalar);
+                PixelKernels::threshold(src.data(), stride, expected.data(), count, thresholdValue);
+                PixelKernels::setIsa(isa);
+                PixelKernels::threshold(src.data(), stride, actual.data(), count, thresholdValue);
+                assert(actual == expected);
+            }
+        }
+    }
+    // Table lookup, contiguous and strided, in place and not
+    unsigned char table[256];
+    for (int v = 0; v < 256; ++v) {
+        table[v] = static_cast<unsigned char>((v * 37 + 11) % 256);
+    }
+    for (PixelKernels::Isa isa : vectorIsas()) {
+        PixelKernels::setIsa(isa);
+        for (int stride : {1, 3}) {
+            size_t count = src.size() / stride;
+            std::vector<unsigned char> actual(src.size(), 0), inPlace(src);
+            PixelKernels::lookup(src.data(), actual.data(), stride, count, table);
+            PixelKernels::lookup(inPlace.data(), inPlace.data(), stride, count, table);
+            for (size_t i = 0; i < count; ++i) {
+                assert(actual[i * stride] == table[src[i * stride]]);
+                assert(inPlace[i * stride] == table[src[i * stride]]);
+            }
+        }
+    }
+    PixelKernels::setIsa(PixelKernels::detectIsa());
+
+    std::cout << "PixelKernels brightness, threshold and lookup tests passed." << std::endl;
+}
+
+void PixelKernelsTests::testColourKernelsMatchScalar() {
+    std::cout << "Testing PixelKernels colour conversions against scalar..." << std::endl;
+
+    // Documented tolerances: grayscale, value, lightness and channel 0 exact, colour conversions within 1 (hue circularly)
+
+    using Conversion = std::function<void(const unsigned char*, int, unsigned char*, size_t)>;
+    struct Case {
+        Conversion kernel;
+        int outChannels;
+        int hueChannel; // Hue channel of the output, -1 if none
+        int tolerance;
+    };
+    std::vector<Case> cases = {
+            {PixelKernels::grayscale, 1, -1, 0},
+            {PixelKernels::rgbToHsv, 3, 0, 1},
+            {PixelKernels::rgbToHsl, 3, 0, 1},
+            {PixelKernels::hsvToRgb, 3, -1, 1},
+            {PixelKernels::hslToRgb, 3, -1, 1},
+            {PixelKernels::rgbToValue, 1, -1, 0},
+            {PixelKernels::rgbToLightness, 1, -1, 0},
+            {PixelKernels::firstChannel, 1, -1, 0},
+    };
+
+    for (int channels : {3, 4}) {
+        // A coarse grid over the RGB cube plus greys, then an odd tail of random colours
+        std::vector<unsigned char> src;
+        for (int r = 0; r < 256; r += 5) {
+            for (int g = 0; g < 256; g += 5) {
+                for (int b = 0; b < 256; b += 5) {
+                    unsigned char pixel[4] = {static_cast<unsigned char>(r), static_cast<unsigned char>(g),
+                                              static_cast<unsigned char>(b), 200};
+                    src.insert(src.end(), pixel, pixel + channels);
+                }
+            }
+        }
+        for (int v = 0; v < 256; ++v) {
+            for (int c = 0; c < channels; ++c) {
+                src.push_back(static_cast<unsigned char>(v));
+            }
+        }
+        for (int i = 0; i < 13 * channels; ++i) {
+            src.push_back(rand() % 256);
+        }
+        size_t count = src.size() / channels;
+
+        for (const Case& test : cases) {
+            std::vector<unsigned char> expected(count * test.outChannels);
+            std::vector<unsigned char> actual(expected.size());
+            for (PixelKernels::Isa isa : vectorIsas()) {
+                PixelKernels::setIsa(PixelKernels::Isa::Scalar);
+                test.kernel(src.data(), channels, expected.data(), count);
+                PixelKernels::setIsa(isa);
+                test.kernel(src.data(), channels, actual.data(), count);
+                assert(maxDifference(expected, actual, test.outChannels, test.hueChannel) <= test.tolerance);
+            }
+        }
+    }
+    PixelKernels::setIsa(PixelKernels::detectIsa());
+
+    std::cout << "PixelKernels colour conversion tests passed." << std::endl;
+}
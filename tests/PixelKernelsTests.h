@@ -0,0 +1,35 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSTESTS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSTESTS_H
+#include "PixelKernels.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+class PixelKernelsTests {
+public:
+    static void testIsaSelection();
+    static void testIntegerKernelsMatchScalar();
+    static void testColourKernelsMatchScalar();
+
+    // Every vector instruction set this machine and build can run
+    static std::vector<PixelKernels::Isa> vectorIsas();
+
+private:
+    // Largest difference between two byte buffers; channel `hueChannel` (if >= 0) of each
+    // `channels`-byte pixel is compared circularly
+    static int maxDifference(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b,
+                             int channels, int hueChannel);
+};
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_PIXELKERNELSTESTS_H
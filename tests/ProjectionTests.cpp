@@ -21,6 +21,9 @@ Members:
 #include <cstdlib>
 #include <string>
 #include <dirent.h>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
 
 // Function to generate Image object with random pixel values
 Image ProjectionTests::generateRandomImage(int width, int height, int channels) {
@@ -432,3 +435,167 @@ void ProjectionTests::test_medianIntensityProjection(const Volume& volume){
     std::cout << "medianIntensityProjection tests passed successfully!" << std::endl;
 
 }
+
+void ProjectionTests::test_computeProjections(const Volume& volume){
+
+    // One pass must give exactly what the individual projections give
+    Projection::Result all = Projection::computeProjections(volume, Projection::AllTypes, -1, -1);
+    assert(compareImages(all.maximum, Projection::maximumIntensityProjection(volume, -1, -1), 0));
+    assert(compareImages(all.minimum, Projection::minimumIntensityProjection(volume, -1, -1), 0));
+    assert(compareImages(all.average, Projection::averageIntensityProjection(volume, -1, -1), 0));
+    assert(compareImages(all.median, Projection::medianIntensityProjection_quickSort(volume, -1, -1), 0));
+    assert(compareImages(all.median, Projection::medianIntensityProjection_histogram(volume, -1, -1), 0));
+
+    // Odd number of slices
+    Projection::Result partial = Projection::computeProjections(volume, Projection::Median | Projection::Maximum, 4, 8);
+    assert(compareImages(partial.median, Projection::medianIntensityProjection_quickSort(volume, 4, 8), 0));
+    assert(compareImages(partial.maximum, Projection::maximumIntensityProjection(volume, 4, 8), 0));
+    // Unrequested projections are left empty
+    assert(partial.minimum.getWidth() == 0);
+
+    // Empty or out-of-range slice ranges are rejected
+    bool threw = false;
+    try {
+        Projection::computeProjections(volume, Projection::Maximum, 5, 4);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "computeProjections tests passed successfully!" << std::endl;
+}
+
+void ProjectionTests::test_computeProjectionsMultiChannel(){
+
+    // Several row bands and tiles, with channel 0 interleaved among 3 channels
+    int width = 37, height = 29, depth = 12, channels = 3;
+    Volume volume(width, height, depth, channels);
+    srand(7);
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    volume.setVoxel(x, y, z, c, rand() % 256);
+                }
+            }
+        }
+    }
+
+    // Compare against a direct per-pixel computation for an even and an odd slice count
+    std::vector<std::pair<int, int>> ranges = {{-1, -1}, {3, 9}};
+    int mismatched = 0;
+    double worstDeviation = 0.0;
+    for (const auto& range : ranges) {
+        Projection::Result result = Projection::computeProjections(volume, Projection::AllTypes, range.first, range.second);
+        int startZ = range.first == -1 ? 0 : range.first - 1;
+        int endZ = range.second == -1 ? depth : range.second;
+        int count = endZ - startZ;
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                std::vector<unsigned char> values;
+                double sum = 0.0, squares = 0.0;
+                for (int z = startZ; z < endZ; ++z) {
+                    unsigned char v = volume.getVoxel(x, y, z, 0);
+                    values.push_back(v);
+                    sum += v;
+                    squares += v * v;
+                }
+                selectionSort(values);
+                int median = (values[(count - 1) / 2] + values[count / 2]) / 2;
+                double mean = sum / count;
+                double deviation = std::sqrt(squares / count - mean * mean);
+
+                mismatched += result.maximum.getPixel(x, y, 0) != values.back();
+                mismatched += result.minimum.getPixel(x, y, 0) != values.front();
+                mismatched += result.average.getPixel(x, y, 0) != static_cast<int>(sum) / count;
+                mismatched += result.median.getPixel(x, y, 0) != median;
+                worstDeviation = std::max(worstDeviation,
+                                          std::abs(result.standardDeviation.getPixel(x, y, 0) - deviation));
+            }
+        }
+    }
+    assert(mismatched == 0);
+    assert(worstDeviation <= 0.5 + 1e-9);
+
+    std::cout << "computeProjections multi-channel tests passed successfully!" << std::endl;
+}
+
+void ProjectionTests::test_slabProjections(){
+
+    // Several row bands, channel 0 interleaved among 2 channels; few distinct values exercise deque ties
+    int width = 37, height = 29, depth = 23, channels = 2;
+    for (int levels : {256, 4}) {
+        Volume volume(width, height, depth, channels);
+        srand(11);
+        size_t size = static_cast<size_t>(width) * height * depth * channels;
+        for (size_t i = 0; i < size; ++i) {
+            volume.getVolumeData()[i] = rand() % levels;
+        }
+
+        for (int thickness : {1, 5, depth}) {
+            unsigned int types = Projection::Maximum | Projection::Minimum | Projection::Average;
+            Projection::SlabStack stack = Projection::computeSlabProjections(volume, thickness, types);
+            assert(static_cast<int>(stack.maximum.size()) == depth - thickness + 1);
+            for (int i = 0; i <= depth - thickness; ++i) {
+                Projection::Result expected = Projection::computeProjections(volume, types, i + 1, i + thickness);
+                assert(compareImages(stack.maximum[i], expected.maximum, 0));
+                assert(compareImages(stack.minimum[i], expected.minimum, 0));
+                assert(compareImages(stack.average[i], expected.average, 0));
+            }
+        }
+    }
+
+    Volume volume(4, 4, 6, 1);
+    assert(Projection::computeSlabProjections(volume, 3, Projection::Average).maximum.empty());
+    for (int thickness : {0, 7}) {
+        bool threw = false;
+        try {
+            Projection::computeSlabProjections(volume, thickness, Projection::Maximum);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    bool threw = false;
+    try {
+        Projection::computeSlabProjections(volume, 3, Projection::Median);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Slab projection tests passed successfully!" << std::endl;
+}
+
+void ProjectionTests::test_medianEngines(){
+
+    // The counting selection and the histograms must agree for odd and even stacks, with and without interleaved channels
+    int width = 45, height = 23;
+    for (int channels : {1, 3}) {
+        for (int depth : {1, 2, 3, 8, 17, 64}) {
+            Volume volume(width, height, depth, channels);
+            srand(depth * 10 + channels);
+            size_t size = static_cast<size_t>(width) * height * depth * channels;
+            for (size_t i = 0; i < size; ++i) {
+                // Clustered values put both middle ranks in the same 16-value bucket as often as not
+                volume.getVolumeData()[i] = depth % 2 ? rand() % 256 : 120 + rand() % 24;
+            }
+
+            Projection::setMedianCrossoverDepth(1);
+            Image histogram = Projection::medianIntensityProjection(volume);
+            Projection::setMedianCrossoverDepth(1 << 30);
+            Image counting = Projection::medianIntensityProjection(volume);
+            assert(compareImages(histogram, counting, 0));
+            if (channels == 1) {
+                assert(compareImages(counting, Projection::medianIntensityProjection_quickSort(volume), 0));
+            }
+        }
+    }
+
+    // 0 measures the crossover again
+    Projection::setMedianCrossoverDepth(0);
+    assert(Projection::medianCrossoverDepth() > 0);
+
+    std::cout << "Median engine tests passed successfully!" << std::endl;
+}
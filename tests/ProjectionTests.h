@@ -22,6 +22,10 @@ public:
     static void test_minimumIntensityProjection(const Volume& volume);
     static void test_averageIntensityProjection(const Volume& volume);
     static void test_medianIntensityProjection(const Volume& volume);
+    static void test_computeProjections(const Volume& volume);
+    static void test_computeProjectionsMultiChannel();
+    static void test_slabProjections();
+    static void test_medianEngines();
     static bool compareImages(const Image& img1, const Image& img2, int tolerance);
     static Volume generateVolume();
     static void test_swap();
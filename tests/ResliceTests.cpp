@@ -0,0 +1,132 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include "ResliceTests.h"
+#include "TestHelpers.h"
+#include "Reslice.h"
+#include "Slice.h"
+
+namespace {
+
+bool matchesSlice(const Image& image, const Slice& slice) {
+    if (image.getWidth() != slice.getWidth() || image.getHeight() != slice.getHeight()
+        || image.getChannels() != slice.getChannels()) {
+        return false;
+    }
+    for (int y = 0; y < slice.getHeight(); ++y) {
+        for (int x = 0; x < slice.getWidth(); ++x) {
+            for (int c = 0; c < slice.getChannels(); ++c) {
+                if (image.getData()[(static_cast<size_t>(y) * image.getWidth() + x) * image.getChannels() + c]
+                    != slice.getPixel(x, y, c)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void ResliceTests::testOrthogonalBatches() {
+    std::cout << "Testing batched XZ and YZ reslicing..." << std::endl;
+
+    Volume volume = randomVolume(23, 19, 17, 3);
+    std::vector<int> ys = {0, 7, 18, 7};
+    std::vector<Image> xz = Reslice::extractXZ(volume, ys);
+    assert(xz.size() == ys.size());
+    int mismatched = 0;
+    for (size_t i = 0; i < ys.size(); ++i) {
+        mismatched += !matchesSlice(xz[i], *volume.getSliceXZ(ys[i]));
+    }
+
+    std::vector<int> xs = {22, 0, 11};
+    std::vector<Image> yz = Reslice::extractYZ(volume, xs);
+    assert(yz.size() == xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        mismatched += !matchesSlice(yz[i], *volume.getSliceYZ(xs[i]));
+    }
+    assert(mismatched == 0);
+
+    bool threw = false;
+    try {
+        Reslice::extractYZ(volume, {3, 23});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Batched XZ and YZ reslicing test passed." << std::endl;
+}
+
+void ResliceTests::testObliqueAxisAligned() {
+    std::cout << "Testing oblique reslicing along the volume axes..." << std::endl;
+
+    // Sizes above one tile, so several tiles of several planes are sampled together
+    Volume volume = randomVolume(41, 37, 35, 1);
+
+    // Planes with axis-aligned steps sample voxel centres, so they reproduce the orthogonal slices exactly
+    Reslice::Plane xz{{0, 12, 0}, {1, 0, 0}, {0, 0, 1}, 41, 35};
+    Reslice::Plane yz{{5, 0, 0}, {0, 1, 0}, {0, 0, 1}, 37, 35};
+    std::vector<Image> planes = Reslice::extractOblique(volume, {xz, yz});
+    int mismatched = !matchesSlice(planes[0], *volume.getSliceXZ(12)) + !matchesSlice(planes[1], *volume.getSliceYZ(5));
+
+    // planeThrough with a z normal gives an upright XY slice centred on the requested point
+    Reslice::Plane xy = Reslice::planeThrough({20, 18, 9}, {0, 0, 2}, 41, 37);
+    Image slice = Reslice::extractOblique(volume, {xy})[0];
+    mismatched += !matchesSlice(slice, Slice(41, 37, 1, [&]() {
+        auto data = std::make_unique<unsigned char[]>(41 * 37);
+        std::copy(volume.getVolumeData() + 9 * 41 * 37, volume.getVolumeData() + 10 * 41 * 37, data.get());
+        return data;
+    }()));
+    assert(mismatched == 0);
+
+    std::cout << "Oblique reslicing along the volume axes test passed." << std::endl;
+}
+
+void ResliceTests::testTrilinearInterpolation() {
+    std::cout << "Testing trilinear interpolation..." << std::endl;
+
+    // A linear ramp is reproduced exactly by trilinear interpolation
+    Volume volume(8, 8, 8, 1);
+    for (int z = 0; z < 8; ++z) {
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                volume.setVoxel(x, y, z, 0, static_cast<unsigned char>(2 * x + 4 * y + 8 * z));
+            }
+        }
+    }
+    assert(std::fabs(Reslice::sampleTrilinear(volume, 2.5, 3.25, 1.75, 0) - (5.0f + 13.0f + 14.0f)) < 1e-4f);
+    assert(Reslice::sampleTrilinear(volume, 7.4, 0, 0, 0) == 14.0f);
+    assert(Reslice::sampleTrilinear(volume, 7.6, 0, 0, 0) == 0.0f);
+    assert(Reslice::sampleTrilinear(volume, 0, -0.6, 0, 0) == 0.0f);
+
+    // A diagonal plane through the ramp, sampled at half-voxel offsets
+    double step = 1.0 / std::sqrt(2.0);
+    Reslice::Plane diagonal{{0.5, 0.5, 0.5}, {step, step, 0}, {0, 0, 1}, 8, 6};
+    Image image = Reslice::extractOblique(volume, {diagonal})[0];
+    long worst = 0;
+    for (int j = 0; j < 6; ++j) {
+        for (int i = 0; i < 8; ++i) {
+            double x = 0.5 + i * step, y = 0.5 + i * step, z = 0.5 + j;
+            double expected = (x > 7.5 || y > 7.5) ? 0.0 : 2 * std::min(x, 7.0) + 4 * std::min(y, 7.0) + 8 * z;
+            worst = std::max(worst, std::labs(image.getData()[j * 8 + i] - std::lround(expected)));
+        }
+    }
+    assert(worst <= 1);
+
+    std::cout << "Trilinear interpolation test passed." << std::endl;
+}
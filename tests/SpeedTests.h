@@ -32,6 +32,9 @@ Members:
 #include "Volume.h"
 #include "Filter.h"
 #include "Projection.h"
+#include "PixelKernels.h"
+#include "Reslice.h"
+#include "Gradient.h"
 
 // Test namespace or class declaration (if applicable)
 // Placeholder for any test-specific declarations or utility functions
@@ -50,6 +53,15 @@ public:
     static void testGaussianBlurSpeed();
     static void testBoxBlurSpeed();
     static void testMedianBlurSpeed();
+    static void testConstantTimeMedianBlurSpeed();
+    static void testProjectionSpeed();
+    static void testPixelKernelSpeed();
+    static void testSliceSortSpeed();
+    static void testResliceSpeed();
+    static void testGradientSpeed();
+    static void testHistogramEqualizationSpeed();
+    static void testClaheSpeed();
+    static void testLutChainSpeed();
     // Add additional test declarations as necessary
 private:
     static long long measureTimeMillis(const std::function<void()>& func);
@@ -0,0 +1,41 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TESTHELPERS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TESTHELPERS_H
+#include "Volume.h"
+#include <random>
+#include <stdexcept>
+
+// Volume with deterministic random voxels, so failures are reproducible
+inline Volume randomVolume(int width, int height, int depth, int channels) {
+    Volume volume(width, height, depth, channels);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    size_t size = static_cast<size_t>(width) * height * depth * channels;
+    for (size_t i = 0; i < size; ++i) {
+        volume.getVolumeData()[i] = static_cast<unsigned char>(distribution(generator));
+    }
+    return volume;
+}
+
+// Whether calling `function` throws std::invalid_argument
+template <typename Function>
+bool throwsInvalidArgument(Function function) {
+    try {
+        function();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TESTHELPERS_H
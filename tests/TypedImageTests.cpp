@@ -0,0 +1,216 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "TypedImageTests.h"
+#include "ProjectionTests.h"
+#include "TypedFilter.h"
+#include "Filter.h"
+
+namespace {
+
+// The 16-bit test slices hold 40000 + 600x - 311y + 1000z
+const char* slices16Bit = "../../tests/test_images_16bit";
+
+int expected16Bit(int x, int y, int z) {
+    return 40000 + 600 * x - 311 * y + 1000 * z;
+}
+
+} // namespace
+
+void TypedImageTests::testLoad16Bit() {
+    std::cout << "Testing 16-bit loading..." << std::endl;
+
+    std::string path = std::string(slices16Bit) + "/slice_1.png";
+    Image16 wide = Image16::load(path);
+    ImageF real = ImageF::load(path);
+    Image8 narrow = Image8::load(path);
+    assert(wide.getWidth() == 24 && wide.getHeight() == 16 && wide.getChannels() == 1);
+    int mismatches = 0;
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 24; ++x) {
+            int expected = expected16Bit(x, y, 1);
+            mismatches += wide.getPixel(x, y, 0) != expected || real.getPixel(x, y, 0) != static_cast<float>(expected)
+                          || narrow.getPixel(x, y, 0) != expected >> 8;
+        }
+    }
+    assert(mismatches == 0);
+
+    // 8-bit files keep their values rather than being stretched to 16 bits
+    Image image("../../tests/test_images/image_0.png");
+    Image16 widened = Image16::load("../../tests/test_images/image_0.png");
+    assert(widened.getSize() == image.getSize());
+    for (size_t i = 0; i < image.getSize(); ++i) {
+        assert(widened.getData()[i] == image.getData()[i]);
+    }
+
+    // Stacks load in natural order at full precision
+    Volume16 volume = Volume16::loadSlices(slices16Bit);
+    assert(volume.getWidth() == 24 && volume.getHeight() == 16 && volume.getDepth() == 3 && volume.getChannels() == 1);
+    for (int z = 0; z < 3; ++z) {
+        mismatches += volume.getVoxel(5, 7, z, 0) != expected16Bit(5, 7, z);
+    }
+    mismatches += volume.getSlice(2).getPixel(23, 15, 0) != expected16Bit(23, 15, 2);
+    assert(mismatches == 0);
+
+    bool thrown = false;
+    try {
+        Image16::load("missing_16bit.png");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "16-bit loading test passed." << std::endl;
+}
+
+void TypedImageTests::testConversions() {
+    std::cout << "Testing typed image conversions..." << std::endl;
+
+    Image original = ProjectionTests::generateRandomImage(13, 9, 3);
+    Image16 wide = Image16::fromImage(original);
+    assert(ProjectionTests::compareImages(wide.toImage(), original, 0));
+    assert(ProjectionTests::compareImages(wide.convert<float>().convert<uint8_t>().toImage(), original, 0));
+
+    // Integer conversions truncate and clamp; float keeps every value
+    ImageF real(4, 1, 1);
+    real.setPixel(0, 0, 0, -5.0f);
+    real.setPixel(1, 0, 0, 12.7f);
+    real.setPixel(2, 0, 0, 300.0f);
+    real.setPixel(3, 0, 0, 70000.0f);
+    Image16 clamped = real.convert<uint16_t>();
+    assert(clamped.getPixel(0, 0, 0) == 0 && clamped.getPixel(1, 0, 0) == 12);
+    assert(clamped.getPixel(2, 0, 0) == 300 && clamped.getPixel(3, 0, 0) == 65535);
+    Image bytes = real.toImage();
+    assert(bytes.getPixel(0, 0, 0) == 0 && bytes.getPixel(1, 0, 0) == 12 && bytes.getPixel(2, 0, 0) == 255);
+
+    // Windowing maps [low, high] onto [0, 255] with rounding
+    Image window = real.toImage(0.0f, 510.0f);
+    assert(window.getPixel(0, 0, 0) == 0 && window.getPixel(1, 0, 0) == 6);
+    assert(window.getPixel(2, 0, 0) == 150 && window.getPixel(3, 0, 0) == 255);
+    bool thrown = false;
+    try {
+        static_cast<void>(real.toImage(1.0f, 1.0f));
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Volumes convert the same way
+    Volume16 volume = Volume16::loadSlices(slices16Bit);
+    Volume display = volume.toVolume(35000.0f, 60000.0f);
+    assert(display.getVoxel(0, 0, 0, 0) == 51 && display.getVoxel(23, 0, 2, 0) == 212);
+    Volume16 roundTrip = Volume16::fromVolume(display);
+    assert(roundTrip.getVoxel(0, 0, 0, 0) == 51);
+
+    std::cout << "Typed image conversions test passed." << std::endl;
+}
+
+void TypedImageTests::testFiltersMatch8Bit() {
+    std::cout << "Testing 8-bit typed filters against Filter..." << std::endl;
+
+    for (int channels : {1, 3}) {
+        Image image = ProjectionTests::generateRandomImage(37, 29, channels);
+        Image8 typed = Image8::fromImage(image);
+
+        Image8 blurred;
+        TypedFilter::gaussianBlur(typed, blurred, 5, 1.2f);
+        assert(ProjectionTests::compareImages(blurred.toImage(), Filter::gaussianBlur(image, 5, 1.2f), 0));
+
+        Image8 edges;
+        TypedFilter::sobel(typed, edges);
+        assert(ProjectionTests::compareImages(edges.toImage(), Filter::applySobelOperator(image), 0));
+
+        // In place gives the same result
+        TypedFilter::sobel(typed, typed);
+        assert(ProjectionTests::compareImages(typed.toImage(), edges.toImage(), 0));
+    }
+
+    // Kernels wider than the height and depth make the z window and the row ring clamp at both borders
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    int mismatched = 0;
+    for (int channels : {1, 2}) {
+        Volume source(19, 14, 11, channels);
+        size_t size = static_cast<size_t>(19) * 14 * 11 * channels;
+        for (size_t i = 0; i < size; ++i) {
+            source.getVolumeData()[i] = static_cast<unsigned char>(distribution(generator));
+        }
+        for (int kernelSize : {1, 5, 17}) {
+            TypedVolume<uint8_t> typedVolume = TypedVolume<uint8_t>::fromVolume(source);
+            TypedFilter::apply3DGaussianBlur(typedVolume, kernelSize, 1.5f);
+            Volume volume = source;
+            Filter::apply3DGaussianBlur(volume, kernelSize, 1.5f);
+            Volume result = typedVolume.toVolume();
+            mismatched += std::memcmp(result.getVolumeData(), volume.getVolumeData(), size) != 0;
+        }
+    }
+    assert(mismatched == 0);
+
+    std::cout << "8-bit typed filters test passed." << std::endl;
+}
+
+void TypedImageTests::testFloatChainPrecision() {
+    std::cout << "Testing float and 16-bit filter chains..." << std::endl;
+
+    // A Gaussian keeps a linear ramp away from the borders, and Sobel then measures 8 times its slope
+    const int width = 40, height = 30, kernelSize = 5;
+    ImageF ramp(width, height, 1);
+    Image16 steepRamp(width, height, 1);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            ramp.setPixel(x, y, 0, 0.25f * x + 0.5f * y);
+            steepRamp.setPixel(x, y, 0, static_cast<uint16_t>(300 * x + 100 * y));
+        }
+    }
+
+    ImageF blurred, edges;
+    TypedFilter::gaussianBlur(ramp, blurred, kernelSize, 1.0f);
+    TypedFilter::sobel(blurred, edges);
+    Image16 steepEdges;
+    TypedFilter::gaussianBlur(steepRamp, steepRamp, kernelSize, 1.0f);
+    TypedFilter::sobel(steepRamp, steepEdges);
+
+    // The 8-bit chain can only produce whole, clamped magnitudes
+    Image bytes = ramp.toImage();
+    Image byteEdges = Filter::applySobelOperator(Filter::gaussianBlur(bytes, kernelSize, 1.0f));
+
+    float exact = std::sqrt(2.0f * 2.0f + 4.0f * 4.0f);
+    float steepExact = std::sqrt(2400.0f * 2400.0f + 800.0f * 800.0f);
+    float floatError = 0.0f, steepError = 0.0f, byteError = 0.0f;
+    for (int y = kernelSize; y < height - kernelSize; ++y) {
+        for (int x = kernelSize; x < width - kernelSize; ++x) {
+            floatError = std::max(floatError, std::fabs(edges.getPixel(x, y, 0) - exact));
+            steepError = std::max(steepError, std::fabs(steepEdges.getPixel(x, y, 0) - steepExact));
+            byteError = std::max(byteError, std::fabs(byteEdges.getPixel(x, y, 0) - exact));
+        }
+    }
+    // Truncating the blurred samples to integers moves each Sobel sum by at most 4
+    assert(floatError < 1e-3f && steepError <= 8.0f);
+    assert(byteError > 0.4f);
+
+    // A float volume blur keeps fractional values
+    VolumeF volume(6, 5, 4, 1);
+    for (int z = 0; z < 4; ++z) {
+        for (int y = 0; y < 5; ++y) {
+            for (int x = 0; x < 6; ++x) {
+                volume.setVoxel(x, y, z, 0, 0.1f);
+            }
+        }
+    }
+    TypedFilter::apply3DGaussianBlur(volume, 3, 1.0f);
+    assert(std::fabs(volume.getVoxel(2, 2, 2, 0) - 0.1f) < 1e-6f);
+
+    std::cout << "Float and 16-bit filter chains test passed." << std::endl;
+}
@@ -0,0 +1,25 @@
+/*
+Group Name: Ziggurat
+
+Members:
+- Tianju (Tim) Du (GitHub: edsml-td323)
+- Melissa Sim (GitHub: acse-mys20)
+- Xiaoye Zhang (GitHub: acse-xz4019)
+- Wenhao Hong (GitHub: acse-wh623)
+- Javonne Porter (GitHub: acse-jp2923)
+- Wenxin Li (GitHub: edsml-wl123)
+*/
+
+#ifndef ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGETESTS_H
+#define ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGETESTS_H
+#include <iostream>
+#include <cassert>
+
+class TypedImageTests {
+public:
+    static void testLoad16Bit();
+    static void testConversions();
+    static void testFiltersMatch8Bit();
+    static void testFloatChainPrecision();
+};
+#endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_TYPEDIMAGETESTS_H
@@ -4,8 +4,18 @@
 
 #include "VolumeTests.h"
 #include "Volume.h"
+#include "Parallel.h"
+#include "Projection.h"
+#include "Reslice.h"
+#include "ProjectionTests.h"
 #include <cassert>
 #include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 void VolumeTests::testVolumeCreationFromFolder() {
@@ -34,4 +44,226 @@ void VolumeTests::testVolumeSliceAccess() {
     auto slice = volume.getSlice(0);
     assert(slice != nullptr);
     std::cout << "testVolumeSliceAccess passed." << std::endl;
-}
\ No newline at end of file
+}
+void VolumeTests::testParallelSliceLoading() {
+    namespace fs = std::filesystem;
+    fs::path folder = fs::temp_directory_path() / "ziggurat_volume_load_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+
+    // Names that sort differently as text and naturally, to check slices land at the right depth
+    std::vector<Image> slices;
+    for (int z = 0; z < 12; ++z) {
+        slices.push_back(ProjectionTests::generateRandomImage(23, 17, 3));
+        slices.back().save((folder / ("slice" + std::to_string(z) + ".png")).string());
+    }
+
+    int originalThreads = Parallel::getThreadCount();
+    for (int threads : {1, 4}) {
+        Parallel::setThreadCount(threads);
+        Volume volume(folder.string());
+        assert(volume.getWidth() == 23 && volume.getHeight() == 17 && volume.getChannels() == 3);
+        assert(volume.getDepth() == 12);
+        for (int z = 0; z < 12; ++z) {
+            assert(ProjectionTests::compareImages(*volume.getSlice(z), slices[z], 0));
+        }
+    }
+    Parallel::setThreadCount(originalThreads);
+
+    fs::remove_all(folder);
+    std::cout << "testParallelSliceLoading passed." << std::endl;
+}
+
+void VolumeTests::testMismatchedSliceSize() {
+    namespace fs = std::filesystem;
+    fs::path folder = fs::temp_directory_path() / "ziggurat_volume_mismatch_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+
+    ProjectionTests::generateRandomImage(8, 8, 1).save((folder / "slice0.png").string());
+    ProjectionTests::generateRandomImage(8, 9, 1).save((folder / "slice1.png").string());
+    std::vector<std::string> missing = {(folder / "slice0.png").string(), (folder / "absent.png").string()};
+
+    bool thrown = false;
+    try {
+        Volume volume(folder.string());
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        Volume volume(missing);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    fs::remove_all(folder);
+    std::cout << "testMismatchedSliceSize passed." << std::endl;
+}
+
+void VolumeTests::testRawVolumeRoundTrip() {
+    namespace fs = std::filesystem;
+    fs::path path = fs::temp_directory_path() / (std::string("ziggurat_raw_test") + Volume::rawExtension);
+
+    Volume original(19, 11, 7, 2);
+    size_t size = static_cast<size_t>(19) * 11 * 7 * 2;
+    for (size_t i = 0; i < size; ++i) {
+        original.getVolumeData()[i] = static_cast<unsigned char>((i * 37 + 11) % 251);
+    }
+    original.saveRaw(path.string());
+    assert(fs::file_size(path) == Volume::rawPayloadOffset + size);
+
+    {
+        Volume mapped = Volume::openRaw(path.string());
+        assert(mapped.getWidth() == 19 && mapped.getHeight() == 11 && mapped.getDepth() == 7 && mapped.getChannels() == 2);
+        assert(std::memcmp(mapped.getVolumeData(), original.getVolumeData(), size) == 0);
+        // The payload starts page-aligned inside the mapping
+        assert(!mapped.isMapped() || reinterpret_cast<uintptr_t>(mapped.getVolumeData()) % Volume::rawPayloadOffset == 0);
+
+        // Changes to a mapped volume stay in memory, and copies and moves keep working
+        mapped.setVoxel(3, 4, 5, 1, 200);
+        Volume copy(mapped);
+        assert(!copy.isMapped() && copy.getVoxel(3, 4, 5, 1) == 200);
+        Volume moved(std::move(mapped));
+        assert(moved.getVoxel(3, 4, 5, 1) == 200 && mapped.getVolumeData() == nullptr);
+    }
+    Volume reopened = Volume::openRaw(path.string());
+    assert(reopened.getVoxel(3, 4, 5, 1) == original.getVoxel(3, 4, 5, 1));
+
+    // Files that are not raw volumes, or are cut short, are rejected
+    bool thrown = false;
+    try {
+        Volume::openRaw("../../tests/test_images/image_0.png");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    fs::resize_file(path, Volume::rawPayloadOffset + size - 1);
+    thrown = false;
+    try {
+        Volume::openRaw(path.string());
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Headers whose sizes wrap around 64 bits are rejected rather than mapped. Fields sit at fixed offsets:
+    // payload offset at 16, payload bytes at 24, then width, height, depth and channels as int32 from 32
+    auto openPatched = [&](uint64_t payloadOffset, uint64_t payloadBytes, int32_t dimension, int32_t channels) {
+        original.saveRaw(path.string());
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            int32_t dimensions[4] = {dimension, dimension, dimension, channels};
+            file.seekp(16);
+            file.write(reinterpret_cast<const char*>(&payloadOffset), sizeof(payloadOffset));
+            file.write(reinterpret_cast<const char*>(&payloadBytes), sizeof(payloadBytes));
+            file.write(reinterpret_cast<const char*>(dimensions), sizeof(dimensions));
+        }
+        try {
+            Volume::openRaw(path.string());
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+        return true;
+    };
+    // 65536^4 is exactly 2^64, which wraps to a payload of 0 bytes
+    assert(!openPatched(Volume::rawPayloadOffset, 0, 65536, 65536));
+    // An offset near 2^64 wraps offset + bytes below the file size
+    assert(!openPatched(UINT64_MAX - 4, 8, 2, 1));
+    // The same patching with consistent sizes still opens, so the rejections above come from the wrapping
+    assert(openPatched(Volume::rawPayloadOffset, 8, 2, 1));
+
+    fs::remove(path);
+    std::cout << "testRawVolumeRoundTrip passed." << std::endl;
+}
+
+void VolumeTests::testConvertSlicesToRaw() {
+    namespace fs = std::filesystem;
+    fs::path path = fs::temp_directory_path() / (std::string("ziggurat_convert_test") + Volume::rawExtension);
+    std::string folderPath = "../../tests/test_images";
+
+    // Small batches force several decode-and-append rounds
+    int originalThreads = Parallel::getThreadCount();
+    Parallel::setThreadCount(2);
+    Volume::convertSlicesToRaw(folderPath, path.string());
+    Parallel::setThreadCount(originalThreads);
+
+    Volume decoded(folderPath);
+    Volume mapped = Volume::openRaw(path.string());
+    assert(mapped.getWidth() == decoded.getWidth() && mapped.getHeight() == decoded.getHeight());
+    assert(mapped.getDepth() == decoded.getDepth() && mapped.getChannels() == decoded.getChannels());
+    size_t size = static_cast<size_t>(decoded.getWidth()) * decoded.getHeight() * decoded.getDepth() * decoded.getChannels();
+    assert(std::memcmp(mapped.getVolumeData(), decoded.getVolumeData(), size) == 0);
+
+    fs::remove(path);
+    std::cout << "testConvertSlicesToRaw passed." << std::endl;
+}
+
+void VolumeTests::testNaturalSortOrder() {
+    std::vector<std::string> names = {"scan/slice10.png", "scan/slice9.png", "scan/slice007.png", "scan/slice100.png",
+                                      "scan/slice0.png", "scan/slice8.png", "scan/slice8b.png",
+                                      "scan/slice12345678901234567890.png"};
+    Volume::sortSliceFilenames(names);
+
+    std::vector<std::string> expected = {"scan/slice0.png", "scan/slice007.png", "scan/slice8.png", "scan/slice8b.png",
+                                         "scan/slice9.png", "scan/slice10.png", "scan/slice100.png",
+                                         "scan/slice12345678901234567890.png"};
+    assert(names == expected);
+
+    // Numbers are compared one after another; a name with fewer numbers comes first when the shared ones match
+    std::vector<std::string> nested = {"run2/slice1.png", "run10/slice1.png", "run2/slice10.png", "run2.png"};
+    Volume::sortSliceFilenames(nested);
+    assert((nested == std::vector<std::string>{"run2.png", "run2/slice1.png", "run2/slice10.png", "run10/slice1.png"}));
+
+    std::cout << "testNaturalSortOrder passed." << std::endl;
+}
+
+void VolumeTests::testLargeSparseVolume() {
+    namespace fs = std::filesystem;
+    fs::path path = fs::temp_directory_path() / (std::string("ziggurat_large_test") + Volume::rawExtension);
+
+    // 4096 x 4096 x 136 bytes is just over 2^31: slices 128 onwards start beyond any 32-bit signed offset.
+    // The file is sparse and mapped, so only the pages the test touches are read or copied.
+    const int width = 4096, height = 4096, depth = 136;
+    size_t size = static_cast<size_t>(width) * height * depth;
+    assert(size > (size_t(1) << 31));
+    Volume::createRaw(path.string(), width, height, depth, 1);
+    assert(fs::file_size(path) == Volume::rawPayloadOffset + size);
+
+    {
+        Volume volume = Volume::openRaw(path.string());
+        assert(volume.getWidth() == width && volume.getHeight() == height && volume.getDepth() == depth);
+
+        // Voxel access and views agree with the 64-bit offset
+        volume.setVoxel(width - 1, height - 1, depth - 1, 0, 201);
+        volume.setVoxel(17, 4000, 129, 0, 30);
+        volume.setVoxel(17, 4000, 130, 0, 90);
+        assert(volume.getVolumeData()[size - 1] == 201);
+        assert(volume.getVoxel(width - 1, height - 1, depth - 1, 0) == 201);
+        assert(&volume.view()(17, 4000, 130) == volume.getVolumeData() + (static_cast<size_t>(130) * height + 4000) * width + 17);
+        assert(volume.getVoxel(16, 4000, 130, 0) == 0);
+
+        // Slices and reslices cut through the far end of the volume
+        auto lastSlice = volume.getSlice(depth - 1);
+        assert(lastSlice->getPixel(width - 1, height - 1, 0) == 201);
+        auto sliceXZ = volume.getSliceXZ(4000);
+        assert(sliceXZ->getPixel(17, 130, 0) == 90 && sliceXZ->getPixel(17, 129, 0) == 30);
+        Reslice::Plane plane{{17.0, 4000.0, 130.0}, {1.0, 0.0, 0.0}, {0.0, 0.0, -1.0}, 4, 4};
+        Image oblique = Reslice::extractOblique(volume, {plane}).front();
+        assert(oblique.getPixel(0, 0, 0) == 90 && oblique.getPixel(0, 1, 0) == 30 && oblique.getPixel(1, 0, 0) == 0);
+
+        // Projections over slices 129 and 130 (1-based 130 to 131) read only data beyond 2^31
+        Projection::Result result = Projection::computeProjections(volume, Projection::AllTypes, 130, 131);
+        assert(result.maximum.getPixel(17, 4000, 0) == 90 && result.minimum.getPixel(17, 4000, 0) == 30);
+        assert(result.average.getPixel(17, 4000, 0) == 60 && result.median.getPixel(17, 4000, 0) == 60);
+        assert(result.standardDeviation.getPixel(17, 4000, 0) == 30);
+        assert(result.maximum.getPixel(18, 4000, 0) == 0 && result.maximum.getPixel(width - 1, height - 1, 0) == 0);
+    }
+
+    fs::remove(path);
+    std::cout << "testLargeSparseVolume passed." << std::endl;
+}
@@ -10,6 +10,12 @@ public:
     static void testVolumeCreationFromFolder();
     static void testVolumeCreationFromFilenames();
     static void testVolumeSliceAccess();
+    static void testParallelSliceLoading();
+    static void testMismatchedSliceSize();
+    static void testRawVolumeRoundTrip();
+    static void testConvertSlicesToRaw();
+    static void testNaturalSortOrder();
+    static void testLargeSparseVolume();
 };
 
 #endif //ADVANCED_PROGRAMMING_GROUP_ZIGGURAT_VOLUMETESTS_H
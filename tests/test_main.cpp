@@ -9,17 +9,45 @@
 #include "VolumeTests.h"
 #include "SliceTests.h"
 #include "SpeedTests.h"
+#include "ParallelTests.h"
+#include "PixelKernelsTests.h"
+#include "PipelineTests.h"
+#include "BrickedVolumeTests.h"
+#include "ResliceTests.h"
+#include "TypedImageTests.h"
+#include "GradientTests.h"
+#include "HistogramTests.h"
+#include "ClaheTests.h"
+#include "LutChainTests.h"
 
 
 int main(){
     std::cout << "Running tests..." << std::endl;
 
+    // Parallel executor
+    std::cout << "Parallel tests..." << std::endl;
+    ParallelTests::testForRangeCoverage();
+    ParallelTests::testNestedForRange();
+    ParallelTests::testExceptionPropagation();
+    ParallelTests::testFiltersMatchSerial();
+    std::cout << "Parallel tests passed." << std::endl;
+
+    // Vectorised colour kernels
+    std::cout << "PixelKernels tests..." << std::endl;
+    PixelKernelsTests::testIsaSelection();
+    PixelKernelsTests::testIntegerKernelsMatchScalar();
+    PixelKernelsTests::testColourKernelsMatchScalar();
+    std::cout << "PixelKernels tests passed." << std::endl;
+
     // Image
     std::cout << "Image tests..." << std::endl;
     ImageTests::testImageCreationFromDimensions();
     ImageTests::testImageCopy();
     ImageTests::testPixelManipulation();
     ImageTests::testImageSave();
+    ImageTests::testImageMove();
+    ImageTests::testImageBufferReuse();
+    ImageTests::testViews();
     std::cout << "Image tests passed." << std::endl;
 
     // Slice
@@ -34,6 +62,12 @@ int main(){
     VolumeTests::testVolumeCreationFromFolder();
     VolumeTests::testVolumeCreationFromFilenames();
     VolumeTests::testVolumeSliceAccess();
+    VolumeTests::testParallelSliceLoading();
+    VolumeTests::testMismatchedSliceSize();
+    VolumeTests::testRawVolumeRoundTrip();
+    VolumeTests::testConvertSlicesToRaw();
+    VolumeTests::testNaturalSortOrder();
+    VolumeTests::testLargeSparseVolume();
     std::cout << "Volume tests passed." << std::endl;
 
     // Projection
@@ -46,6 +80,10 @@ int main(){
     ProjectionTests::test_minimumIntensityProjection(volume);
     ProjectionTests::test_averageIntensityProjection(volume);
     ProjectionTests::test_medianIntensityProjection(volume);
+    ProjectionTests::test_computeProjections(volume);
+    ProjectionTests::test_computeProjectionsMultiChannel();
+    ProjectionTests::test_slabProjections();
+    ProjectionTests::test_medianEngines();
     // Helper function tests
     ProjectionTests::test_swap();
     ProjectionTests::test_partition();
@@ -55,8 +93,13 @@ int main(){
     // Filter
     std::cout << "Filter tests..." << std::endl;
     FilterTests::testMedianBlur();
+    FilterTests::testConstantTimeMedianBlur();
     FilterTests::testBoxBlur();
+    FilterTests::testBoxBlurRunningSum();
     FilterTests::testGaussianBlur();
+    FilterTests::testGaussianKernel1D();
+    FilterTests::testSeparableGaussianBlur();
+    FilterTests::testRecursiveGaussianBlur();
     FilterTests::testGrayScale();
     FilterTests::testSetBrightness();
     FilterTests::test_setBrightness();
@@ -77,13 +120,75 @@ int main(){
     FilterTests::testApplyPrewittOperator();
     FilterTests::testApplyScharrOperator();
     FilterTests::testApplyRobertsCrossOperator();
+    FilterTests::testOutputOverloads();
     FilterTests::test3DGaussianBlur(volume);
+    FilterTests::test3DGaussianBlurSeparable();
     FilterTests::testCreate3DKernel(3, 1.0);
     FilterTests::testCreate3DKernel(5, 2.0);
     FilterTests::test3DMedianFilter();
+    FilterTests::test3DMedianEngines();
 
     std::cout << "Filter tests passed." << std::endl;
 
+    // Batch pipeline
+    std::cout << "Pipeline tests..." << std::endl;
+    PipelineTests::testParse();
+    PipelineTests::testParseErrors();
+    PipelineTests::testApplyMatchesFilters();
+    PipelineTests::testRunBatch();
+    std::cout << "Pipeline tests passed." << std::endl;
+
+    // Out-of-core volumes
+    std::cout << "Bricked volume tests..." << std::endl;
+    BrickedVolumeTests::testRegionRoundTrip();
+    BrickedVolumeTests::testStreamingFilters();
+    BrickedVolumeTests::testStreamingProjections();
+    std::cout << "Bricked volume tests passed." << std::endl;
+
+    // Reslicing
+    std::cout << "Reslice tests..." << std::endl;
+    ResliceTests::testOrthogonalBatches();
+    ResliceTests::testObliqueAxisAligned();
+    ResliceTests::testTrilinearInterpolation();
+    std::cout << "Reslice tests passed." << std::endl;
+
+    // Extended bit depths
+    std::cout << "Typed image tests..." << std::endl;
+    TypedImageTests::testLoad16Bit();
+    TypedImageTests::testConversions();
+    TypedImageTests::testFiltersMatch8Bit();
+    TypedImageTests::testFloatChainPrecision();
+    std::cout << "Typed image tests passed." << std::endl;
+
+    // Gradient engine
+    std::cout << "Gradient tests..." << std::endl;
+    GradientTests::testMatchesReference();
+    GradientTests::testOrientation();
+    GradientTests::testLuminanceSource();
+    GradientTests::testCannyMatchesReference();
+    GradientTests::testCannyHysteresis();
+    std::cout << "Gradient tests passed." << std::endl;
+
+    // Histogram engine
+    std::cout << "Histogram tests..." << std::endl;
+    HistogramTests::testCounts();
+    HistogramTests::testEqualisationTable();
+    HistogramTests::testFusedEqualisation();
+    std::cout << "Histogram tests passed." << std::endl;
+
+    // Adaptive histogram equalisation
+    std::cout << "CLAHE tests..." << std::endl;
+    ClaheTests::testClippedTable();
+    ClaheTests::testImageMatchesReference();
+    ClaheTests::testVolumeMatchesReference();
+    std::cout << "CLAHE tests passed." << std::endl;
+
+    // Fused pointwise chains
+    std::cout << "LutChain tests..." << std::endl;
+    LutChainTests::testCompile();
+    LutChainTests::testMatchesFilters();
+    std::cout << "LutChain tests passed." << std::endl;
+
     std::cout << "All tests passed." << std::endl;
 
     // Now run speed tests
@@ -146,6 +251,69 @@ int main(){
         std::cerr << "An exception occurred during the Median blur speed test: " << e.what() << std::endl;
     }
 
+    try {
+        std::cout << "\nConstant-time median blur speed test result:" << std::endl;
+        SpeedTest::testConstantTimeMedianBlurSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Constant-time median blur speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nProjection speed test result:" << std::endl;
+        SpeedTest::testProjectionSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Projection speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nColour kernel speed test result:" << std::endl;
+        SpeedTest::testPixelKernelSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Colour kernel speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nSlice filename sort speed test result:" << std::endl;
+        SpeedTest::testSliceSortSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Slice filename sort speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nReslice speed test result:" << std::endl;
+        SpeedTest::testResliceSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Reslice speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nGradient engine speed test result:" << std::endl;
+        SpeedTest::testGradientSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the Gradient engine speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nHistogram equalisation speed test result:" << std::endl;
+        SpeedTest::testHistogramEqualizationSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the histogram equalisation speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nCLAHE speed test result:" << std::endl;
+        SpeedTest::testClaheSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the CLAHE speed test: " << e.what() << std::endl;
+    }
+
+    try {
+        std::cout << "\nFused pointwise chain speed test result:" << std::endl;
+        SpeedTest::testLutChainSpeed();
+    } catch (const std::exception& e) {
+        std::cerr << "An exception occurred during the fused pointwise chain speed test: " << e.what() << std::endl;
+    }
+
 
     return 0;
 }
\ No newline at end of file